@@ -103,6 +103,28 @@ wire [VALID_ADDR_WIDTH-1:0] s_axil_araddr_valid = s_axil_araddr >> (ADDR_WIDTH -
 (* ramstyle = "M9K", ram_init_file = INIT_FILE_2 *) reg [7:0] mem2 [(2**VALID_ADDR_WIDTH)-1:0];
 (* ramstyle = "M9K", ram_init_file = INIT_FILE_3 *) reg [7:0] mem3 [(2**VALID_ADDR_WIDTH)-1:0];
 
+`ifdef Z_CORE_SIM
+// Simulation only: +image=<file.hex> loads a word-per-line image
+// (software/elf2hex.py output) at address 0
+reg [31:0] sim_image [(2**VALID_ADDR_WIDTH)-1:0];
+reg [8*256-1:0] sim_image_file;
+integer sim_i;
+
+initial begin
+    if ($value$plusargs("image=%s", sim_image_file)) begin
+        for (sim_i = 0; sim_i < 2**VALID_ADDR_WIDTH; sim_i = sim_i + 1)
+            sim_image[sim_i] = 32'h0;
+        $readmemh(sim_image_file, sim_image);
+        for (sim_i = 0; sim_i < 2**VALID_ADDR_WIDTH; sim_i = sim_i + 1) begin
+            mem0[sim_i] = sim_image[sim_i][7:0];
+            mem1[sim_i] = sim_image[sim_i][15:8];
+            mem2[sim_i] = sim_image[sim_i][23:16];
+            mem3[sim_i] = sim_image[sim_i][31:24];
+        end
+    end
+end
+`endif
+
 // =========================================================================
 // AXI-Lite output assignments
 // =========================================================================
@@ -0,0 +1,370 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// **************************************************
+//             AXI-Lite Bus Performance Monitor
+//
+// Passive tap on the interconnect master ports (the
+// slave side of the bus). For each monitored port it
+// counts reads and writes, busy cycles (request
+// valid until the response handshake), wait cycles
+// (request valid but not accepted by the slave), the
+// worst latency and a latency histogram with eight
+// power-of-two bins:
+//   1, 2, 3-4, 5-8, 9-16, 17-32, 33-64, >64 cycles
+//
+//   0x000 CTRL    [0] ENABLE (reset 1), [1] CLEAR (W)
+//   0x004 INFO    [7:0] M_MON, [15:8] bins
+//   0x008 CYCLES  cycles counted while enabled
+//   0x080 * (m+1) port m:
+//     +0x00 RD_COUNT   +0x04 WR_COUNT
+//     +0x08 RD_BUSY    +0x0C WR_BUSY
+//     +0x10 RD_WAIT    +0x14 WR_WAIT
+//     +0x18 RD_MAX     +0x1C WR_MAX
+//     +0x20 RD_HIST[8] +0x40 WR_HIST[8]
+//
+// The dbg_* port reads the same word index space
+// without going over the bus (Verilator harness).
+//
+// **************************************************
+
+module axil_bus_mon #(
+    parameter DATA_WIDTH = 32,
+    parameter ADDR_WIDTH = 12,
+    parameter STRB_WIDTH = (DATA_WIDTH/8),
+    parameter M_MON      = 7,       // Monitored master ports (1..31)
+    parameter ENABLE     = 1        // 0: no counters, all reads return 0
+)(
+    input  wire                     clk,
+    input  wire                     rstn,
+
+    // AXI-Lite Slave Interface
+    input  wire [ADDR_WIDTH-1:0]    s_axil_awaddr,
+    input  wire [2:0]               s_axil_awprot,
+    input  wire                     s_axil_awvalid,
+    output wire                     s_axil_awready,
+    input  wire [DATA_WIDTH-1:0]    s_axil_wdata,
+    input  wire [STRB_WIDTH-1:0]    s_axil_wstrb,
+    input  wire                     s_axil_wvalid,
+    output wire                     s_axil_wready,
+    output wire [1:0]               s_axil_bresp,
+    output wire                     s_axil_bvalid,
+    input  wire                     s_axil_bready,
+    input  wire [ADDR_WIDTH-1:0]    s_axil_araddr,
+    input  wire [2:0]               s_axil_arprot,
+    input  wire                     s_axil_arvalid,
+    output wire                     s_axil_arready,
+    output wire [DATA_WIDTH-1:0]    s_axil_rdata,
+    output wire [1:0]               s_axil_rresp,
+    output wire                     s_axil_rvalid,
+    input  wire                     s_axil_rready,
+
+    // Monitored interconnect master ports (handshake signals only)
+    input  wire [M_MON-1:0]         mon_arvalid,
+    input  wire [M_MON-1:0]         mon_arready,
+    input  wire [M_MON-1:0]         mon_rvalid,
+    input  wire [M_MON-1:0]         mon_rready,
+    input  wire [M_MON-1:0]         mon_awvalid,
+    input  wire [M_MON-1:0]         mon_awready,
+    input  wire [M_MON-1:0]         mon_wvalid,
+    input  wire [M_MON-1:0]         mon_wready,
+    input  wire [M_MON-1:0]         mon_bvalid,
+    input  wire [M_MON-1:0]         mon_bready,
+
+    // Side-band read port (word index = byte offset / 4)
+    input  wire [9:0]               dbg_idx,
+    output wire [31:0]              dbg_data
+);
+
+    localparam BINS = 8;
+    localparam REGS = 8 + 2 * BINS;     // Counters per port
+
+    localparam [7:0] INFO_BINS  = BINS;
+    localparam [7:0] INFO_PORTS = M_MON;
+
+    // =========================================================================
+    // Control
+    // =========================================================================
+
+    reg        en_r;        // CTRL.ENABLE
+    reg        clr_r;       // CTRL.CLEAR pulse
+    reg [31:0] cycles_r;
+
+    always @(posedge clk) begin
+        if (~rstn || clr_r)
+            cycles_r <= 32'd0;
+        else if (en_r)
+            cycles_r <= cycles_r + 1;
+    end
+
+    // Latency bin: 1, 2, 3-4, 5-8, 9-16, 17-32, 33-64, >64
+    function [2:0] lat_bin;
+        input [15:0] lat;
+        begin
+            if      (lat <= 16'd1)  lat_bin = 3'd0;
+            else if (lat <= 16'd2)  lat_bin = 3'd1;
+            else if (lat <= 16'd4)  lat_bin = 3'd2;
+            else if (lat <= 16'd8)  lat_bin = 3'd3;
+            else if (lat <= 16'd16) lat_bin = 3'd4;
+            else if (lat <= 16'd32) lat_bin = 3'd5;
+            else if (lat <= 16'd64) lat_bin = 3'd6;
+            else                    lat_bin = 3'd7;
+        end
+    endfunction
+
+    // =========================================================================
+    // Per-Port Counters
+    // =========================================================================
+
+    // Register file as seen by software: 32 words per block, block 0
+    // is the control block, block m+1 is port m.
+    wire [(M_MON+1)*32*32-1:0] all_q;
+
+    assign all_q[0*32 +: 32]      = {31'd0, en_r};
+    assign all_q[1*32 +: 32]      = {16'd0, INFO_BINS, INFO_PORTS};
+    assign all_q[2*32 +: 32]      = cycles_r;
+    assign all_q[32*32-1 : 3*32]  = {29*32{1'b0}};
+
+    genvar m, k;
+    generate
+        for (m = 0; m < M_MON; m = m + 1) begin : g_port
+            if (ENABLE) begin : g_cnt
+                // The interconnect keeps one transaction per port in
+                // flight, so one tracker per direction is enough.
+                reg        rd_act, wr_act;
+                reg [15:0] rd_lat, wr_lat;      // Cycles spent so far (saturating)
+
+                reg [31:0] rd_count, wr_count;
+                reg [31:0] rd_busy, wr_busy;
+                reg [31:0] rd_wait, wr_wait;
+                reg [15:0] rd_max, wr_max;
+                reg [31:0] rd_hist [0:BINS-1];
+                reg [31:0] wr_hist [0:BINS-1];
+
+                wire rd_req  = mon_arvalid[m];
+                wire rd_done = mon_rvalid[m] && mon_rready[m];
+                wire wr_req  = mon_awvalid[m] || mon_wvalid[m];
+                wire wr_done = mon_bvalid[m] && mon_bready[m];
+
+                // Latency including the response cycle
+                wire [15:0] rd_now = rd_lat + 1;
+                wire [15:0] wr_now = wr_lat + 1;
+
+                integer i;
+
+                always @(posedge clk) begin
+                    if (~rstn) begin
+                        rd_act <= 1'b0;
+                        wr_act <= 1'b0;
+                        rd_lat <= 16'd0;
+                        wr_lat <= 16'd0;
+                    end else begin
+                        if (rd_done) begin
+                            rd_act <= 1'b0;
+                            rd_lat <= 16'd0;
+                        end else if (rd_act || rd_req) begin
+                            rd_act <= 1'b1;
+                            if (~&rd_lat) rd_lat <= rd_lat + 1;
+                        end
+
+                        if (wr_done) begin
+                            wr_act <= 1'b0;
+                            wr_lat <= 16'd0;
+                        end else if (wr_act || wr_req) begin
+                            wr_act <= 1'b1;
+                            if (~&wr_lat) wr_lat <= wr_lat + 1;
+                        end
+                    end
+                end
+
+                always @(posedge clk) begin
+                    if (~rstn || clr_r) begin
+                        rd_count <= 32'd0;
+                        wr_count <= 32'd0;
+                        rd_busy  <= 32'd0;
+                        wr_busy  <= 32'd0;
+                        rd_wait  <= 32'd0;
+                        wr_wait  <= 32'd0;
+                        rd_max   <= 16'd0;
+                        wr_max   <= 16'd0;
+                        for (i = 0; i < BINS; i = i + 1) begin
+                            rd_hist[i] <= 32'd0;
+                            wr_hist[i] <= 32'd0;
+                        end
+                    end else if (en_r) begin
+                        if (rd_act || rd_req)
+                            rd_busy <= rd_busy + 1;
+                        if (wr_act || wr_req)
+                            wr_busy <= wr_busy + 1;
+                        if (mon_arvalid[m] && ~mon_arready[m])
+                            rd_wait <= rd_wait + 1;
+                        if ((mon_awvalid[m] && ~mon_awready[m]) ||
+                            (mon_wvalid[m] && ~mon_wready[m]))
+                            wr_wait <= wr_wait + 1;
+
+                        if (rd_done) begin
+                            rd_count <= rd_count + 1;
+                            rd_hist[lat_bin(rd_now)] <= rd_hist[lat_bin(rd_now)] + 1;
+                            if (rd_now > rd_max) rd_max <= rd_now;
+                        end
+                        if (wr_done) begin
+                            wr_count <= wr_count + 1;
+                            wr_hist[lat_bin(wr_now)] <= wr_hist[lat_bin(wr_now)] + 1;
+                            if (wr_now > wr_max) wr_max <= wr_now;
+                        end
+                    end
+                end
+
+                assign all_q[((m+1)*32 + 0)*32 +: 32] = rd_count;
+                assign all_q[((m+1)*32 + 1)*32 +: 32] = wr_count;
+                assign all_q[((m+1)*32 + 2)*32 +: 32] = rd_busy;
+                assign all_q[((m+1)*32 + 3)*32 +: 32] = wr_busy;
+                assign all_q[((m+1)*32 + 4)*32 +: 32] = rd_wait;
+                assign all_q[((m+1)*32 + 5)*32 +: 32] = wr_wait;
+                assign all_q[((m+1)*32 + 6)*32 +: 32] = {16'd0, rd_max};
+                assign all_q[((m+1)*32 + 7)*32 +: 32] = {16'd0, wr_max};
+                for (k = 0; k < BINS; k = k + 1) begin : g_hist
+                    assign all_q[((m+1)*32 + 8 + k)*32 +: 32]        = rd_hist[k];
+                    assign all_q[((m+1)*32 + 8 + BINS + k)*32 +: 32] = wr_hist[k];
+                end
+                assign all_q[((m+1)*32 + REGS)*32 +: (32-REGS)*32] = {(32-REGS)*32{1'b0}};
+            end else begin : g_none
+                assign all_q[(m+1)*32*32 +: 32*32] = {32*32{1'b0}};
+            end
+        end
+    endgenerate
+
+    assign dbg_data = (dbg_idx[9:5] <= M_MON) ? all_q[dbg_idx*32 +: 32] : 32'd0;
+
+    // =========================================================================
+    // AXI-Lite Registers & Wires
+    // =========================================================================
+
+    // AXI-Lite Status
+    reg s_axil_awready_reg;
+    reg s_axil_wready_reg;
+    reg s_axil_bvalid_reg;
+    reg s_axil_arready_reg;
+    reg [DATA_WIDTH-1:0] s_axil_rdata_reg;
+    reg s_axil_rvalid_reg;
+
+    // Latched Write Request
+    reg [ADDR_WIDTH-1:0] axi_awaddr;
+    reg axi_awready_flag;
+    reg [DATA_WIDTH-1:0] axi_wdata;
+    reg axi_wready_flag;
+
+    // Assignments
+    assign s_axil_awready = s_axil_awready_reg;
+    assign s_axil_wready  = s_axil_wready_reg;
+    assign s_axil_bresp   = 2'b00; // OKAY
+    assign s_axil_bvalid  = s_axil_bvalid_reg;
+    assign s_axil_arready = s_axil_arready_reg;
+    assign s_axil_rdata   = s_axil_rdata_reg;
+    assign s_axil_rresp   = 2'b00; // OKAY
+    assign s_axil_rvalid  = s_axil_rvalid_reg;
+
+    // =========================================================================
+    // Write Channel Logic
+    // =========================================================================
+
+    always @(posedge clk) begin
+        if (~rstn) begin
+            s_axil_awready_reg <= 1'b0;
+            s_axil_wready_reg  <= 1'b0;
+            s_axil_bvalid_reg  <= 1'b0;
+            axi_awready_flag   <= 1'b0;
+            axi_wready_flag    <= 1'b0;
+            axi_awaddr         <= {ADDR_WIDTH{1'b0}};
+            axi_wdata          <= {DATA_WIDTH{1'b0}};
+            en_r               <= 1'b1;
+            clr_r              <= 1'b0;
+        end else begin
+            clr_r <= 1'b0;
+
+            // Address Handshake
+            if (~s_axil_awready_reg && s_axil_awvalid && ~axi_awready_flag && ~s_axil_bvalid_reg) begin
+                s_axil_awready_reg <= 1'b1;
+                axi_awaddr         <= s_axil_awaddr;
+                axi_awready_flag   <= 1'b1;
+            end else begin
+                s_axil_awready_reg <= 1'b0;
+            end
+
+            // Data Handshake
+            if (~s_axil_wready_reg && s_axil_wvalid && ~axi_wready_flag && ~s_axil_bvalid_reg) begin
+                s_axil_wready_reg <= 1'b1;
+                axi_wdata         <= s_axil_wdata;
+                axi_wready_flag   <= 1'b1;
+            end else begin
+                s_axil_wready_reg <= 1'b0;
+            end
+
+            // Execution
+            if (axi_awready_flag && axi_wready_flag && ~s_axil_bvalid_reg) begin
+                s_axil_bvalid_reg <= 1'b1;
+                axi_awready_flag  <= 1'b0;
+                axi_wready_flag   <= 1'b0;
+
+                if (axi_awaddr[11:2] == 10'd0) begin    // 0x000 CTRL
+                    en_r  <= axi_wdata[0];
+                    clr_r <= axi_wdata[1];
+                end
+            end
+
+            if (s_axil_bvalid_reg && s_axil_bready) begin
+                s_axil_bvalid_reg <= 1'b0;
+            end
+        end
+    end
+
+    // =========================================================================
+    // Read Channel Logic
+    // =========================================================================
+
+    always @(posedge clk) begin
+        if (~rstn) begin
+            s_axil_arready_reg <= 1'b0;
+            s_axil_rvalid_reg  <= 1'b0;
+            s_axil_rdata_reg   <= {DATA_WIDTH{1'b0}};
+        end else begin
+            if (~s_axil_arready_reg && s_axil_arvalid && ~s_axil_rvalid_reg) begin
+                s_axil_arready_reg <= 1'b1;
+                if (s_axil_araddr[11:7] <= M_MON)
+                    s_axil_rdata_reg <= all_q[s_axil_araddr[11:2]*32 +: 32];
+                else
+                    s_axil_rdata_reg <= {DATA_WIDTH{1'b0}};
+            end else begin
+                s_axil_arready_reg <= 1'b0;
+            end
+
+            if (s_axil_arready_reg) begin
+                s_axil_rvalid_reg <= 1'b1;
+            end else if (s_axil_rvalid_reg && s_axil_rready) begin
+                s_axil_rvalid_reg <= 1'b0;
+            end
+        end
+    end
+
+endmodule
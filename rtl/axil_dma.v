@@ -0,0 +1,438 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// **************************************************
+//                 AXI-Lite DMA Engine
+//
+// Moves data over the interconnect while the core
+// keeps executing. Registers on an AXI-Lite slave
+// window, transfers through a second AXI-Lite master
+// (interconnect slave port after the harts).
+//
+//   0x00 SRC     source address
+//   0x04 DST     destination address
+//   0x08 LEN     elements remaining
+//   0x0C CTRL    [0] START (R: busy)  [1] IE
+//                [2] SRC_FIXED  [3] DST_FIXED
+//                [4] BYTE (else word)
+//                [6:5] REQ: 0 none, 1 UART RX valid,
+//                           2 UART TX empty
+//                [7] CHAIN: load descriptor at NEXT
+//   0x10 NEXT    descriptor: SRC, DST, LEN, CTRL, NEXT
+//   0x14 STATUS  [0] BUSY  [1] DONE  [2] ERR (W1C)
+//
+// **************************************************
+
+module axil_dma #(
+    parameter DATA_WIDTH = 32,
+    parameter ADDR_WIDTH = 12,          // Register window
+    parameter M_ADDR_WIDTH = 32,        // Bus master address
+    parameter STRB_WIDTH = (DATA_WIDTH/8)
+)(
+    input  wire                     clk,
+    input  wire                     rstn,
+
+    // AXI-Lite Slave Interface (registers)
+    input  wire [ADDR_WIDTH-1:0]    s_axil_awaddr,
+    input  wire [2:0]               s_axil_awprot,
+    input  wire                     s_axil_awvalid,
+    output wire                     s_axil_awready,
+    input  wire [DATA_WIDTH-1:0]    s_axil_wdata,
+    input  wire [STRB_WIDTH-1:0]    s_axil_wstrb,
+    input  wire                     s_axil_wvalid,
+    output wire                     s_axil_wready,
+    output wire [1:0]               s_axil_bresp,
+    output wire                     s_axil_bvalid,
+    input  wire                     s_axil_bready,
+    input  wire [ADDR_WIDTH-1:0]    s_axil_araddr,
+    input  wire [2:0]               s_axil_arprot,
+    input  wire                     s_axil_arvalid,
+    output wire                     s_axil_arready,
+    output wire [DATA_WIDTH-1:0]    s_axil_rdata,
+    output wire [1:0]               s_axil_rresp,
+    output wire                     s_axil_rvalid,
+    input  wire                     s_axil_rready,
+
+    // AXI-Lite Master Interface (transfers)
+    output wire [M_ADDR_WIDTH-1:0]  m_axil_awaddr,
+    output wire [2:0]               m_axil_awprot,
+    output wire                     m_axil_awvalid,
+    input  wire                     m_axil_awready,
+    output wire [DATA_WIDTH-1:0]    m_axil_wdata,
+    output wire [STRB_WIDTH-1:0]    m_axil_wstrb,
+    output wire                     m_axil_wvalid,
+    input  wire                     m_axil_wready,
+    input  wire [1:0]               m_axil_bresp,
+    input  wire                     m_axil_bvalid,
+    output wire                     m_axil_bready,
+    output wire [M_ADDR_WIDTH-1:0]  m_axil_araddr,
+    output wire [2:0]               m_axil_arprot,
+    output wire                     m_axil_arvalid,
+    input  wire                     m_axil_arready,
+    input  wire [DATA_WIDTH-1:0]    m_axil_rdata,
+    input  wire [1:0]               m_axil_rresp,
+    input  wire                     m_axil_rvalid,
+    output wire                     m_axil_rready,
+
+    // Peripheral request lines: [0] UART RX valid, [1] UART TX empty
+    input  wire [1:0]               dreq_i,
+
+    output wire                     dma_irq_o
+);
+
+    // =========================================================================
+    // Memory Mapped Registers
+    // =========================================================================
+
+    reg  [31:0] src_r;      // 0x00 -> Source address
+    reg  [31:0] dst_r;      // 0x04 -> Destination address
+    reg  [31:0] len_r;      // 0x08 -> Elements remaining
+    reg  [31:0] ctrl_r;     // 0x0C -> Control
+    reg  [31:0] next_r;     // 0x10 -> Next descriptor
+    reg         done_r;     // 0x14 -> Status
+    reg         err_r;
+
+    localparam CTRL_START     = 0;
+    localparam CTRL_IE        = 1;
+    localparam CTRL_SRC_FIXED = 2;
+    localparam CTRL_DST_FIXED = 3;
+    localparam CTRL_BYTE      = 4;
+    localparam CTRL_CHAIN     = 7;
+
+    // =========================================================================
+    // Engine State
+    // =========================================================================
+
+    localparam ST_IDLE  = 3'd0;
+    localparam ST_DESC  = 3'd1;    // Fetching descriptor words
+    localparam ST_REQ   = 3'd2;    // Next element: wait for the request line
+    localparam ST_READ  = 3'd3;    // Element read in flight
+    localparam ST_WRITE = 3'd4;    // Element write in flight
+
+    reg [2:0]  state;
+    reg [2:0]  desc_idx;
+    reg [31:0] desc_ptr;
+    reg        desc_wait;
+    reg        abort_r;
+
+    wire busy = (state != ST_IDLE);
+
+    wire       elem_byte = ctrl_r[CTRL_BYTE];
+    wire [3:0] req_lines = {1'b1, dreq_i, 1'b1};   // REQ 3 is reserved
+    wire       req_ok    = req_lines[ctrl_r[6:5]];
+
+    assign dma_irq_o = ctrl_r[CTRL_IE] & (done_r | err_r);
+
+    // =========================================================================
+    // Bus Master
+    // =========================================================================
+
+    reg                     mem_req;
+    reg                     mem_wen;
+    reg  [M_ADDR_WIDTH-1:0] mem_addr;
+    reg  [DATA_WIDTH-1:0]   mem_wdata;
+    reg  [STRB_WIDTH-1:0]   mem_wstrb;
+    wire [DATA_WIDTH-1:0]   mem_rdata;
+    wire                    mem_ready;
+    wire                    mem_err;
+
+    // Byte elements: pick the source lane, replicate it on every lane and
+    // let wstrb select the destination byte (peripherals take [7:0])
+    wire [7:0] rd_byte = mem_rdata >> {src_r[1:0], 3'b000};
+
+    axil_master #(
+        .DATA_WIDTH(DATA_WIDTH),
+        .ADDR_WIDTH(M_ADDR_WIDTH),
+        .STRB_WIDTH(STRB_WIDTH)
+    ) u_axil_master (
+        .clk(clk),
+        .rstn(rstn),
+        .mem_req(mem_req),
+        .mem_wen(mem_wen),
+        .mem_addr(mem_addr),
+        .mem_wdata(mem_wdata),
+        .mem_wstrb(mem_wstrb),
+        .mem_rdata(mem_rdata),
+        .mem_ready(mem_ready),
+        .mem_err(mem_err),
+        .mem_busy(),
+        .m_axil_awaddr(m_axil_awaddr),
+        .m_axil_awprot(m_axil_awprot),
+        .m_axil_awvalid(m_axil_awvalid),
+        .m_axil_awready(m_axil_awready),
+        .m_axil_wdata(m_axil_wdata),
+        .m_axil_wstrb(m_axil_wstrb),
+        .m_axil_wvalid(m_axil_wvalid),
+        .m_axil_wready(m_axil_wready),
+        .m_axil_bresp(m_axil_bresp),
+        .m_axil_bvalid(m_axil_bvalid),
+        .m_axil_bready(m_axil_bready),
+        .m_axil_araddr(m_axil_araddr),
+        .m_axil_arprot(m_axil_arprot),
+        .m_axil_arvalid(m_axil_arvalid),
+        .m_axil_arready(m_axil_arready),
+        .m_axil_rdata(m_axil_rdata),
+        .m_axil_rresp(m_axil_rresp),
+        .m_axil_rvalid(m_axil_rvalid),
+        .m_axil_rready(m_axil_rready)
+    );
+
+    // =========================================================================
+    // AXI-Lite Registers & Wires
+    // =========================================================================
+
+    // AXI-Lite Status
+    reg s_axil_awready_reg;
+    reg s_axil_wready_reg;
+    reg s_axil_bvalid_reg;
+    reg s_axil_arready_reg;
+    reg [DATA_WIDTH-1:0] s_axil_rdata_reg;
+    reg s_axil_rvalid_reg;
+
+    // Latched Write Request
+    reg [ADDR_WIDTH-1:0] axi_awaddr;
+    reg axi_awready_flag;
+    reg [DATA_WIDTH-1:0] axi_wdata;
+    reg axi_wready_flag;
+
+    // Assignments
+    assign s_axil_awready = s_axil_awready_reg;
+    assign s_axil_wready  = s_axil_wready_reg;
+    assign s_axil_bresp   = 2'b00; // OKAY
+    assign s_axil_bvalid  = s_axil_bvalid_reg;
+    assign s_axil_arready = s_axil_arready_reg;
+    assign s_axil_rdata   = s_axil_rdata_reg;
+    assign s_axil_rresp   = 2'b00; // OKAY
+    assign s_axil_rvalid  = s_axil_rvalid_reg;
+
+    // =========================================================================
+    // Write Channel Logic and Transfer Engine
+    // =========================================================================
+    // SRC, DST, LEN, CTRL and NEXT are read-only while busy, except that
+    // writing CTRL with START clear aborts after the current element.
+
+    always @(posedge clk) begin
+        if (~rstn) begin
+            s_axil_awready_reg <= 1'b0;
+            s_axil_wready_reg  <= 1'b0;
+            s_axil_bvalid_reg  <= 1'b0;
+            axi_awready_flag   <= 1'b0;
+            axi_wready_flag    <= 1'b0;
+            axi_awaddr         <= {ADDR_WIDTH{1'b0}};
+            axi_wdata          <= {DATA_WIDTH{1'b0}};
+            src_r              <= 32'd0;
+            dst_r              <= 32'd0;
+            len_r              <= 32'd0;
+            ctrl_r             <= 32'd0;
+            next_r             <= 32'd0;
+            done_r             <= 1'b0;
+            err_r              <= 1'b0;
+            state              <= ST_IDLE;
+            desc_idx           <= 3'd0;
+            desc_ptr           <= 32'd0;
+            desc_wait          <= 1'b0;
+            abort_r            <= 1'b0;
+            mem_req            <= 1'b0;
+            mem_wen            <= 1'b0;
+            mem_addr           <= {M_ADDR_WIDTH{1'b0}};
+            mem_wdata          <= {DATA_WIDTH{1'b0}};
+            mem_wstrb          <= {STRB_WIDTH{1'b0}};
+        end else begin
+            mem_req <= 1'b0;
+
+            // Address Handshake
+            if (~s_axil_awready_reg && s_axil_awvalid && ~axi_awready_flag && ~s_axil_bvalid_reg) begin
+                s_axil_awready_reg <= 1'b1;
+                axi_awaddr         <= s_axil_awaddr;
+                axi_awready_flag   <= 1'b1;
+            end else begin
+                s_axil_awready_reg <= 1'b0;
+            end
+
+            // Data Handshake
+            if (~s_axil_wready_reg && s_axil_wvalid && ~axi_wready_flag && ~s_axil_bvalid_reg) begin
+                s_axil_wready_reg <= 1'b1;
+                axi_wdata         <= s_axil_wdata;
+                axi_wready_flag   <= 1'b1;
+            end else begin
+                s_axil_wready_reg <= 1'b0;
+            end
+
+            // Execution
+            if (axi_awready_flag && axi_wready_flag && ~s_axil_bvalid_reg) begin
+                s_axil_bvalid_reg <= 1'b1;
+                axi_awready_flag  <= 1'b0;
+                axi_wready_flag   <= 1'b0;
+
+                case (axi_awaddr[4:2])
+                    3'b000: if (!busy) src_r  <= axi_wdata;     // 0x00
+                    3'b001: if (!busy) dst_r  <= axi_wdata;     // 0x04
+                    3'b010: if (!busy) len_r  <= axi_wdata;     // 0x08
+                    3'b011: begin                               // 0x0C
+                        if (!busy) begin
+                            ctrl_r <= axi_wdata;
+                            if (axi_wdata[CTRL_START]) begin
+                                done_r  <= 1'b0;
+                                err_r   <= 1'b0;
+                                abort_r <= 1'b0;
+                                state   <= ST_REQ;
+                            end
+                        end else if (!axi_wdata[CTRL_START]) begin
+                            abort_r <= 1'b1;
+                        end
+                    end
+                    3'b100: if (!busy) next_r <= axi_wdata;     // 0x10
+                    3'b101: begin                               // 0x14
+                        if (axi_wdata[1]) done_r <= 1'b0;
+                        if (axi_wdata[2]) err_r  <= 1'b0;
+                    end
+                endcase
+            end
+
+            if (s_axil_bvalid_reg && s_axil_bready) begin
+                s_axil_bvalid_reg <= 1'b0;
+            end
+
+            // Transfer engine (after the register writes so completion wins
+            // over a STATUS clear in the same cycle)
+            case (state)
+                ST_REQ: begin
+                    if (abort_r) begin
+                        state <= ST_IDLE;
+                    end else if (len_r == 32'd0) begin
+                        if (ctrl_r[CTRL_CHAIN]) begin
+                            desc_ptr <= next_r;
+                            desc_idx <= 3'd0;
+                            state    <= ST_DESC;
+                        end else begin
+                            done_r <= 1'b1;
+                            state  <= ST_IDLE;
+                        end
+                    end else if (req_ok) begin
+                        mem_req  <= 1'b1;
+                        mem_wen  <= 1'b0;
+                        mem_addr <= {src_r[31:2], 2'b00};
+                        state    <= ST_READ;
+                    end
+                end
+
+                ST_READ: begin
+                    if (mem_ready) begin
+                        if (mem_err) begin
+                            err_r <= 1'b1;
+                            state <= ST_IDLE;
+                        end else begin
+                            mem_req   <= 1'b1;
+                            mem_wen   <= 1'b1;
+                            mem_addr  <= {dst_r[31:2], 2'b00};
+                            mem_wdata <= elem_byte ? {STRB_WIDTH{rd_byte}} : mem_rdata;
+                            mem_wstrb <= elem_byte ? ({{(STRB_WIDTH-1){1'b0}}, 1'b1} << dst_r[1:0])
+                                                   : {STRB_WIDTH{1'b1}};
+                            state     <= ST_WRITE;
+                        end
+                    end
+                end
+
+                ST_WRITE: begin
+                    if (mem_ready) begin
+                        if (mem_err) begin
+                            err_r <= 1'b1;
+                            state <= ST_IDLE;
+                        end else begin
+                            if (!ctrl_r[CTRL_SRC_FIXED])
+                                src_r <= src_r + (elem_byte ? 32'd1 : 32'd4);
+                            if (!ctrl_r[CTRL_DST_FIXED])
+                                dst_r <= dst_r + (elem_byte ? 32'd1 : 32'd4);
+                            len_r <= len_r - 32'd1;
+                            state <= ST_REQ;
+                        end
+                    end
+                end
+
+                ST_DESC: begin
+                    if (!desc_wait) begin
+                        mem_req   <= 1'b1;
+                        mem_wen   <= 1'b0;
+                        mem_addr  <= desc_ptr + {desc_idx, 2'b00};
+                        desc_wait <= 1'b1;
+                    end else if (mem_ready) begin
+                        desc_wait <= 1'b0;
+                        desc_idx  <= desc_idx + 3'd1;
+                        if (mem_err) begin
+                            err_r <= 1'b1;
+                            state <= ST_IDLE;
+                        end else begin
+                            case (desc_idx)
+                                3'd0: src_r  <= mem_rdata;
+                                3'd1: dst_r  <= mem_rdata;
+                                3'd2: len_r  <= mem_rdata;
+                                3'd3: ctrl_r <= mem_rdata;
+                                default: begin
+                                    next_r <= mem_rdata;
+                                    state  <= ST_REQ;
+                                end
+                            endcase
+                        end
+                    end
+                end
+
+                default: ;
+            endcase
+        end
+    end
+
+    // =========================================================================
+    // Read Channel Logic
+    // =========================================================================
+    always @(posedge clk) begin
+        if (~rstn) begin
+            s_axil_arready_reg <= 1'b0;
+            s_axil_rvalid_reg  <= 1'b0;
+            s_axil_rdata_reg   <= {DATA_WIDTH{1'b0}};
+        end else begin
+            if (~s_axil_arready_reg && s_axil_arvalid && ~s_axil_rvalid_reg) begin
+                s_axil_arready_reg <= 1'b1;
+
+                case (s_axil_araddr[4:2])
+                    3'b000: s_axil_rdata_reg <= src_r;                      // 0x00
+                    3'b001: s_axil_rdata_reg <= dst_r;                      // 0x04
+                    3'b010: s_axil_rdata_reg <= len_r;                      // 0x08
+                    3'b011: s_axil_rdata_reg <= {ctrl_r[31:1], busy};       // 0x0C
+                    3'b100: s_axil_rdata_reg <= next_r;                     // 0x10
+                    3'b101: s_axil_rdata_reg <= {29'd0, err_r, done_r, busy}; // 0x14
+                    default: s_axil_rdata_reg <= {DATA_WIDTH{1'b0}};
+                endcase
+            end else begin
+                s_axil_arready_reg <= 1'b0;
+            end
+
+            if (s_axil_arready_reg) begin
+                s_axil_rvalid_reg <= 1'b1;
+            end else if (s_axil_rvalid_reg && s_axil_rready) begin
+                s_axil_rvalid_reg <= 1'b0;
+            end
+        end
+    end
+
+endmodule
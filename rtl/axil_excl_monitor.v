@@ -0,0 +1,140 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// **************************************************
+//           Exclusive Access Monitor (RV32A)
+//
+// One LR/SC reservation per hart, kept next to the
+// interconnect. It watches the address handshakes on
+// the interconnect slave ports, which the shared bus
+// serializes, so every read and write to RAM passes
+// it in order:
+//
+//   - a hart's reserved read (excl_rd) takes a
+//     reservation on that word
+//   - any write to the word by another master (core
+//     or DMA) clears the reservation
+//   - a hart's reserved write (excl_wr) is checked
+//     at its AW handshake; without a reservation
+//     its write strobes are forced to 0 and
+//     excl_fail is held until the next write
+//
+// AXI-Lite has no exclusive accesses or IDs, so the
+// harts flag their LR/SC/AMO transactions on side
+// band lines instead.
+//
+// **************************************************
+
+module axil_excl_monitor #(
+    parameter NUM_HARTS  = 2,               // Harts on slave ports 0..NUM_HARTS-1
+    parameter S_COUNT    = 3,               // All interconnect slave ports
+    parameter ADDR_WIDTH = 32,
+    parameter STRB_WIDTH = 4
+)(
+    input  wire                            clk,
+    input  wire                            rstn,
+
+    // Interconnect slave-port address handshakes
+    input  wire [S_COUNT*ADDR_WIDTH-1:0]   s_axil_awaddr,
+    input  wire [S_COUNT-1:0]              s_axil_awvalid,
+    input  wire [S_COUNT-1:0]              s_axil_awready,
+    input  wire [S_COUNT*ADDR_WIDTH-1:0]   s_axil_araddr,
+    input  wire [S_COUNT-1:0]              s_axil_arvalid,
+    input  wire [S_COUNT-1:0]              s_axil_arready,
+
+    // Per-hart side band
+    input  wire [NUM_HARTS-1:0]            excl_rd,
+    input  wire [NUM_HARTS-1:0]            excl_wr,
+    output wire [NUM_HARTS-1:0]            excl_fail,
+
+    // Hart write strobes in, gated strobes out to the interconnect
+    input  wire [NUM_HARTS*STRB_WIDTH-1:0] hart_wstrb,
+    output wire [NUM_HARTS*STRB_WIDTH-1:0] s_axil_wstrb
+);
+
+    reg [NUM_HARTS-1:0] resv_valid;
+    reg [ADDR_WIDTH-3:0] resv_addr [0:NUM_HARTS-1];
+    reg [NUM_HARTS-1:0] fail_r;
+
+    wire [S_COUNT-1:0] aw_fire = s_axil_awvalid & s_axil_awready;
+    wire [S_COUNT-1:0] ar_fire = s_axil_arvalid & s_axil_arready;
+
+    // Reserved write with its reservation intact
+    wire [NUM_HARTS-1:0] sc_ok;
+    // Write that lands: clears every reservation on its word
+    wire [S_COUNT-1:0] aw_kill;
+
+    genvar h, s;
+    generate
+        for (h = 0; h < NUM_HARTS; h = h + 1) begin : g_sc
+            assign sc_ok[h] = resv_valid[h] &&
+                resv_addr[h] == s_axil_awaddr[h*ADDR_WIDTH+2 +: ADDR_WIDTH-2];
+            // W follows AW by at least a cycle (interconnect DECODE state),
+            // so fail_r is already up to date when the strobes are used
+            assign s_axil_wstrb[h*STRB_WIDTH +: STRB_WIDTH] =
+                fail_r[h] ? {STRB_WIDTH{1'b0}} : hart_wstrb[h*STRB_WIDTH +: STRB_WIDTH];
+        end
+        for (s = 0; s < S_COUNT; s = s + 1) begin : g_kill
+            if (s < NUM_HARTS) begin : g_hart
+                assign aw_kill[s] = aw_fire[s] && !(excl_wr[s] && !sc_ok[s]);
+            end else begin : g_other
+                assign aw_kill[s] = aw_fire[s];
+            end
+        end
+    endgenerate
+
+    assign excl_fail = fail_r;
+
+    integer i, j;
+    always @(posedge clk) begin
+        if (!rstn) begin
+            resv_valid <= {NUM_HARTS{1'b0}};
+            fail_r <= {NUM_HARTS{1'b0}};
+            for (i = 0; i < NUM_HARTS; i = i + 1)
+                resv_addr[i] <= {(ADDR_WIDTH-2){1'b0}};
+        end else begin
+            for (i = 0; i < NUM_HARTS; i = i + 1) begin
+                // Writes clear matching reservations, including the writer's own
+                for (j = 0; j < S_COUNT; j = j + 1) begin
+                    if (aw_kill[j] && resv_addr[i] == s_axil_awaddr[j*ADDR_WIDTH+2 +: ADDR_WIDTH-2])
+                        resv_valid[i] <= 1'b0;
+                end
+
+                // SC gives up the reservation whether it succeeds or not
+                if (aw_fire[i]) begin
+                    fail_r[i] <= excl_wr[i] && !sc_ok[i];
+                    if (excl_wr[i])
+                        resv_valid[i] <= 1'b0;
+                end
+
+                // A new reservation replaces the old one (one per hart)
+                if (ar_fire[i] && excl_rd[i]) begin
+                    resv_valid[i] <= 1'b1;
+                    resv_addr[i] <= s_axil_araddr[i*ADDR_WIDTH+2 +: ADDR_WIDTH-2];
+                end
+            end
+        end
+    end
+
+endmodule
@@ -0,0 +1,197 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// **************************************************
+//                AXI-Lite Hart Control
+//
+// Starts the secondary harts of a multi-hart build.
+// Hart 0 runs from reset; the others are held in
+// reset until their HART_RUN bit is set and then
+// start at HART_BOOT.
+//
+//   0x00 HART_COUNT  harts in this build (R)
+//   0x04 HART_RUN    [h] hart h out of reset
+//                    (bit 0 reads 1, not writable)
+//   0x08 HART_BOOT   reset PC of secondary harts
+//
+// **************************************************
+
+module axil_hartctl #(
+    parameter DATA_WIDTH = 32,
+    parameter ADDR_WIDTH = 12,
+    parameter STRB_WIDTH = (DATA_WIDTH/8),
+    parameter NUM_HARTS  = 2
+)(
+    input  wire                     clk,
+    input  wire                     rstn,
+
+    // AXI-Lite Slave Interface
+    input  wire [ADDR_WIDTH-1:0]    s_axil_awaddr,
+    input  wire [2:0]               s_axil_awprot,
+    input  wire                     s_axil_awvalid,
+    output wire                     s_axil_awready,
+    input  wire [DATA_WIDTH-1:0]    s_axil_wdata,
+    input  wire [STRB_WIDTH-1:0]    s_axil_wstrb,
+    input  wire                     s_axil_wvalid,
+    output wire                     s_axil_wready,
+    output wire [1:0]               s_axil_bresp,
+    output wire                     s_axil_bvalid,
+    input  wire                     s_axil_bready,
+    input  wire [ADDR_WIDTH-1:0]    s_axil_araddr,
+    input  wire [2:0]               s_axil_arprot,
+    input  wire                     s_axil_arvalid,
+    output wire                     s_axil_arready,
+    output wire [DATA_WIDTH-1:0]    s_axil_rdata,
+    output wire [1:0]               s_axil_rresp,
+    output wire                     s_axil_rvalid,
+    input  wire                     s_axil_rready,
+
+    // Per-hart reset release and secondary reset PC
+    output wire [NUM_HARTS-1:0]     hart_run,
+    output wire [31:0]              hart_boot
+);
+
+    // =========================================================================
+    // Registers
+    // =========================================================================
+
+    reg  [NUM_HARTS-1:0] run_r;     // 0x04 -> Bit 0 forced to 1
+    reg  [31:0]          boot_r;    // 0x08
+
+    assign hart_run  = run_r | 1'b1;
+    assign hart_boot = boot_r;
+
+    // =========================================================================
+    // AXI-Lite Registers & Wires
+    // =========================================================================
+
+    // AXI-Lite Status
+    reg s_axil_awready_reg;
+    reg s_axil_wready_reg;
+    reg s_axil_bvalid_reg;
+    reg s_axil_arready_reg;
+    reg [DATA_WIDTH-1:0] s_axil_rdata_reg;
+    reg s_axil_rvalid_reg;
+
+    // Latched Write Request
+    reg [ADDR_WIDTH-1:0] axi_awaddr;
+    reg axi_awready_flag;
+    reg [DATA_WIDTH-1:0] axi_wdata;
+    reg axi_wready_flag;
+
+    // Assignments
+    assign s_axil_awready = s_axil_awready_reg;
+    assign s_axil_wready  = s_axil_wready_reg;
+    assign s_axil_bresp   = 2'b00; // OKAY
+    assign s_axil_bvalid  = s_axil_bvalid_reg;
+    assign s_axil_arready = s_axil_arready_reg;
+    assign s_axil_rdata   = s_axil_rdata_reg;
+    assign s_axil_rresp   = 2'b00; // OKAY
+    assign s_axil_rvalid  = s_axil_rvalid_reg;
+
+    // =========================================================================
+    // Write Channel Logic
+    // =========================================================================
+
+    always @(posedge clk) begin
+        if (~rstn) begin
+            s_axil_awready_reg <= 1'b0;
+            s_axil_wready_reg  <= 1'b0;
+            s_axil_bvalid_reg  <= 1'b0;
+            axi_awready_flag   <= 1'b0;
+            axi_wready_flag    <= 1'b0;
+            axi_awaddr         <= {ADDR_WIDTH{1'b0}};
+            axi_wdata          <= {DATA_WIDTH{1'b0}};
+            run_r              <= {NUM_HARTS{1'b0}};
+            boot_r             <= 32'd0;
+        end else begin
+            // Address Handshake
+            if (~s_axil_awready_reg && s_axil_awvalid && ~axi_awready_flag && ~s_axil_bvalid_reg) begin
+                s_axil_awready_reg <= 1'b1;
+                axi_awaddr         <= s_axil_awaddr;
+                axi_awready_flag   <= 1'b1;
+            end else begin
+                s_axil_awready_reg <= 1'b0;
+            end
+
+            // Data Handshake
+            if (~s_axil_wready_reg && s_axil_wvalid && ~axi_wready_flag && ~s_axil_bvalid_reg) begin
+                s_axil_wready_reg <= 1'b1;
+                axi_wdata         <= s_axil_wdata;
+                axi_wready_flag   <= 1'b1;
+            end else begin
+                s_axil_wready_reg <= 1'b0;
+            end
+
+            // Execution
+            if (axi_awready_flag && axi_wready_flag && ~s_axil_bvalid_reg) begin
+                s_axil_bvalid_reg <= 1'b1;
+                axi_awready_flag  <= 1'b0;
+                axi_wready_flag   <= 1'b0;
+
+                case (axi_awaddr[3:2])
+                    2'b01: run_r  <= axi_wdata[NUM_HARTS-1:0];  // 0x04
+                    2'b10: boot_r <= axi_wdata;                 // 0x08
+                    default: ;
+                endcase
+            end
+
+            if (s_axil_bvalid_reg && s_axil_bready) begin
+                s_axil_bvalid_reg <= 1'b0;
+            end
+        end
+    end
+
+    // =========================================================================
+    // Read Channel Logic
+    // =========================================================================
+
+    always @(posedge clk) begin
+        if (~rstn) begin
+            s_axil_arready_reg <= 1'b0;
+            s_axil_rvalid_reg  <= 1'b0;
+            s_axil_rdata_reg   <= {DATA_WIDTH{1'b0}};
+        end else begin
+            if (~s_axil_arready_reg && s_axil_arvalid && ~s_axil_rvalid_reg) begin
+                s_axil_arready_reg <= 1'b1;
+
+                case (s_axil_araddr[3:2])
+                    2'b00: s_axil_rdata_reg <= NUM_HARTS;                           // 0x00
+                    2'b01: s_axil_rdata_reg <= {{(32-NUM_HARTS){1'b0}}, hart_run};  // 0x04
+                    2'b10: s_axil_rdata_reg <= boot_r;                              // 0x08
+                    default: s_axil_rdata_reg <= {DATA_WIDTH{1'b0}};
+                endcase
+            end else begin
+                s_axil_arready_reg <= 1'b0;
+            end
+
+            if (s_axil_arready_reg) begin
+                s_axil_rvalid_reg <= 1'b1;
+            end else if (s_axil_rvalid_reg && s_axil_rready) begin
+                s_axil_rvalid_reg <= 1'b0;
+            end
+        end
+    end
+
+endmodule
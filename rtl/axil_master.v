@@ -45,6 +45,7 @@ module axil_master #(
     input  wire [STRB_WIDTH-1:0]  mem_wstrb,
     output reg  [DATA_WIDTH-1:0]  mem_rdata,
     output reg                    mem_ready,
+    output reg                    mem_err,     // bresp/rresp was not OKAY (valid with mem_ready)
     output wire                   mem_busy,
 
     // AXI-Lite Master Interface
@@ -106,6 +107,7 @@ always @(posedge clk) begin
         m_axil_bready  <= 1'b0;
         mem_rdata      <= {DATA_WIDTH{1'b0}};
         mem_ready      <= 1'b0;
+        mem_err        <= 1'b0;
         addr_reg       <= {ADDR_WIDTH{1'b0}};
         wdata_reg      <= {DATA_WIDTH{1'b0}};
         wstrb_reg      <= {STRB_WIDTH{1'b0}};
@@ -154,6 +156,7 @@ always @(posedge clk) begin
                 if (m_axil_rvalid) begin
                     // Capture data NOW - it will be stable next cycle
                     mem_rdata     <= m_axil_rdata;
+                    mem_err       <= m_axil_rresp[1];
                     m_axil_rready <= 1'b0;
                     // Go to DONE state to assert mem_ready AFTER data is registered
                     state <= STATE_READ_DONE;
@@ -186,6 +189,7 @@ always @(posedge clk) begin
                 // Wait for write response
                 if (m_axil_bvalid) begin
                     mem_ready     <= 1'b1;
+                    mem_err       <= m_axil_bresp[1];
                     m_axil_bready <= 1'b0;
                     state <= STATE_IDLE;
                 end
@@ -41,6 +41,10 @@ module axil_uart #(
     output wire                   uart_tx,
     input  wire                   uart_rx,
 
+    // DMA request lines (axil_dma REQ 1 and 2)
+    output wire                   dma_rx_req,
+    output wire                   dma_tx_req,
+
     // AXI-Lite Slave Interface
     input  wire [ADDR_WIDTH-1:0]  s_axil_awaddr,
     input  wire [2:0]             s_axil_awprot,
@@ -100,6 +104,10 @@ reg [7:0] rx_data;
 reg rx_valid;
 reg rx_error;
 
+// A received byte is waiting / the transmitter can take the next byte
+assign dma_rx_req = rx_valid;
+assign dma_tx_req = tx_empty;
+
 // **************************************************
 //             Baud Rate Generator
 // **************************************************
@@ -24,8 +24,14 @@ SOFTWARE.
 
 // **************************************************
 //         AXI-Lite VGA Controller
-//   160x120 framebuffer, 4x upscaled to 640x480
-//   8-bit color (3-3-2 RGB)
+//   640x480 @ 60 Hz scanout, selectable modes:
+//     0: 160x120 8-bpp 3-3-2 RGB, 4x upscale
+//     1: 160x120 8-bpp indexed,   4x upscale
+//     2: 320x240 4-bpp indexed,   2x upscale
+//   256-entry 4:4:4 palette with rotation offset
+//   40x30 text layer (8x8 font, 2x) over any mode
+//   Framebuffer X/Y scroll with wraparound
+//   Line-compare and vblank interrupts
 //   DE10-Lite 4-bit resistor DAC
 // **************************************************
 
@@ -46,6 +52,9 @@ module axil_vga #(
     output reg                    vga_hs,
     output reg                    vga_vs,
 
+    // Raster interrupt (line compare / vblank)
+    output wire                   irq,
+
     // AXI-Lite Slave Interface
     input  wire [ADDR_WIDTH-1:0]  s_axil_awaddr,
     input  wire [2:0]             s_axil_awprot,
@@ -71,13 +80,64 @@ module axil_vga #(
 // **************************************************
 //           Register Map
 // **************************************************
-// 0x00: FB_ADDR   [R/W] - Framebuffer write address (0..19199)
-// 0x04: FB_DATA   [W]   - Write pixel color, auto-increment addr
-// 0x08: FB_STATUS [R]   - Bit 0: in vertical blanking
-
-localparam REG_ADDR   = 3'b000;  // 0x00
-localparam REG_DATA   = 3'b001;  // 0x04
-localparam REG_STATUS = 3'b010;  // 0x08
+// 0x00: FB_ADDR    [R/W] - Framebuffer byte address (0..19199, mode 2: 0..38399)
+// 0x04: FB_DATA    [W]   - Write pixel byte, auto-increment addr
+//                          (mode 2: two pixels, even x in bits [3:0])
+// 0x08: FB_STATUS  [R]   - Bit 0: in vertical blanking
+// 0x0C: CTRL       [R/W] - Bits [1:0]: MODE (0 RGB332, 1 PAL8, 2 PAL4)
+// 0x10: PAL_INDEX  [R/W] - Palette write index, auto-increment
+// 0x14: PAL_DATA   [W]   - Write palette entry 0xRGB (4:4:4)
+// 0x18: PAL_OFFSET [R/W] - Palette rotation, bits [7:0]
+//                          PAL8: entry = pixel + offset
+//                          PAL4: entry = {offset[7:4], pixel + offset[3:0]}
+// 0x1C: FB_NIBBLE  [W]   - Write bits [3:0] to one nibble of the byte at
+//                          FB_ADDR, bit 4 selects the high (odd x) nibble.
+//                          No auto-increment. Sets a single mode 2 pixel.
+// 0x20: TXT_CTRL   [R/W] - Bit 0: text layer on, bit 1: cursor on,
+//                          bit 2: cursor blinks
+// 0x24: TXT_POS    [R/W] - Text cell index (0..1199), also the cursor
+// 0x28: TXT_PUTC   [W]   - Write char [7:0] with TXT_ATTR at TXT_POS,
+//                          auto-increment
+// 0x2C: TXT_ATTR   [R/W] - [3:0] fg color, [6:4] bg color, [7] bg opaque
+// 0x30: TXT_CELL   [W]   - Write {attr, char} [15:0] at TXT_POS,
+//                          auto-increment
+// 0x34: TXT_ORIGIN [R/W] - Text RAM row shown on the top line (0..29)
+// 0x38: SCROLL_X   [R/W] - Framebuffer column shown at the left edge,
+//                          less than the mode's width (160 / 320)
+// 0x3C: SCROLL_Y   [R/W] - Framebuffer line shown at the top, less than
+//                          the mode's height (120 / 240)
+// 0x40: LINE_CMP   [R/W] - Screen line (0..479) raising IRQ_LINE
+// 0x44: IRQ_EN     [R/W] - Bit 0: IRQ_LINE, bit 1: IRQ_VBLANK
+// 0x48: IRQ_STATUS [R/W1C] - Pending sources, same bits. IRQ_LINE is set
+//                          at the start of line LINE_CMP (during hsync,
+//                          before its first pixel), IRQ_VBLANK after the
+//                          last visible line.
+// 0x4C: LINE       [R]   - Current screen line (>= 480 in vblank)
+
+localparam REG_ADDR    = 5'h00;  // 0x00
+localparam REG_DATA    = 5'h01;  // 0x04
+localparam REG_STATUS  = 5'h02;  // 0x08
+localparam REG_CTRL    = 5'h03;  // 0x0C
+localparam REG_PAL_IDX = 5'h04;  // 0x10
+localparam REG_PAL_DAT = 5'h05;  // 0x14
+localparam REG_PAL_OFS = 5'h06;  // 0x18
+localparam REG_NIBBLE  = 5'h07;  // 0x1C
+localparam REG_TXT_CTL = 5'h08;  // 0x20
+localparam REG_TXT_POS = 5'h09;  // 0x24
+localparam REG_TXT_PUT = 5'h0A;  // 0x28
+localparam REG_TXT_ATR = 5'h0B;  // 0x2C
+localparam REG_TXT_CEL = 5'h0C;  // 0x30
+localparam REG_TXT_ORG = 5'h0D;  // 0x34
+localparam REG_SCRL_X  = 5'h0E;  // 0x38
+localparam REG_SCRL_Y  = 5'h0F;  // 0x3C
+localparam REG_LINE_CMP = 5'h10; // 0x40
+localparam REG_IRQ_EN  = 5'h11;  // 0x44
+localparam REG_IRQ_STA = 5'h12;  // 0x48
+localparam REG_LINE    = 5'h13;  // 0x4C
+
+localparam MODE_RGB332 = 2'd0;
+localparam MODE_PAL8   = 2'd1;
+localparam MODE_PAL4   = 2'd2;
 
 // **************************************************
 //    VGA Timing — 640x480 @ 60 Hz, 25 MHz pixel clk
@@ -100,15 +160,70 @@ localparam H_END   = H_START + H_DISP;  // 784
 localparam V_START = V_SYNC + V_BACK;   // 35
 localparam V_END   = V_START + V_DISP;  // 515
 
-localparam FB_SIZE = FB_WIDTH * FB_HEIGHT;  // 19200
+localparam FB_SIZE  = FB_WIDTH * FB_HEIGHT;  // 19200 bytes at 8 bpp
+localparam FB_BYTES = 2 * FB_SIZE;          // 38400: 2x width, 2x height at 4 bpp
+
+localparam TXT_COLS  = 40;                  // 16x16 screen pixels per cell
+localparam TXT_ROWS  = 30;
+localparam TXT_CELLS = TXT_COLS * TXT_ROWS; // 1200
 
 // **************************************************
 //            Framebuffer (dual-port M9K)
 // **************************************************
 //  Port A — CPU write  (system clock)
 //  Port B — VGA read   (system clock)
+//  8-bpp modes use the first FB_SIZE bytes. Stored as two
+//  nibble-wide halves so FB_NIBBLE can write one pixel of
+//  a 4-bpp byte without a read-modify-write.
+
+(* ramstyle = "M9K" *) reg [3:0] framebuffer_lo [0:FB_BYTES-1];
+(* ramstyle = "M9K" *) reg [3:0] framebuffer_hi [0:FB_BYTES-1];
+
+// **************************************************
+//          Palette (256 x 12-bit, M9K)
+// **************************************************
+// Reset contents expand 3-3-2 like mode 0, so PAL8 matches
+// RGB332 until the palette is reprogrammed.
+
+(* ramstyle = "M9K" *) reg [11:0] palette [0:255];
+
+integer pal_i;
+initial begin
+    for (pal_i = 0; pal_i < 256; pal_i = pal_i + 1)
+        palette[pal_i] = {pal_i[7:5], pal_i[7], pal_i[4:2], pal_i[4], pal_i[1:0], pal_i[1:0]};
+end
+
+// **************************************************
+//          Text RAM (1200 x 16-bit, M9K)
+// **************************************************
+// Cell = {attr, char}. Row-major, 40 cells per row. The
+// RAM is a ring of 30 rows: screen line r shows RAM row
+// (r + TXT_ORIGIN) mod 30, so scrolling the console is one
+// TXT_ORIGIN write plus clearing the new bottom row.
+
+(* ramstyle = "M9K" *) reg [15:0] text_ram [0:TXT_CELLS-1];
+
+integer txt_i;
+initial begin
+    for (txt_i = 0; txt_i < TXT_CELLS; txt_i = txt_i + 1)
+        text_ram[txt_i] = 16'd0;
+end
+
+reg [1:0]  mode;
+reg [7:0]  pal_offset;
 
-(* ramstyle = "M9K" *) reg [7:0] framebuffer [0:FB_SIZE-1];
+reg        txt_en;
+reg        cursor_en;
+reg        cursor_blink;
+reg [10:0] txt_pos;
+reg [7:0]  txt_attr;
+reg [4:0]  txt_origin;
+
+reg [8:0]  scroll_x;
+reg [7:0]  scroll_y;
+reg [8:0]  line_cmp;
+reg [1:0]  irq_en;
+reg [1:0]  irq_status;
 
 // **************************************************
 //        25 MHz pixel clock enable
@@ -168,43 +283,170 @@ wire active   = h_active && v_active;
 
 wire in_vblank = !v_active;
 
-// Framebuffer coordinates (4x upscale: divide by 4)
-wire [7:0] fb_x = (h_count - H_START) >> 2;
-wire [6:0] fb_y = (v_count - V_START) >> 2;
-
+wire [9:0] scr_x = h_count - H_START;
+wire [9:0] scr_y = v_count - V_START;
+
+// Framebuffer coordinates: 4x upscale (divide by 4) for 160x120,
+// 2x upscale (divide by 2) for 320x240, then scrolled with
+// wraparound at the frame edges
+wire       hires = (mode == MODE_PAL4);
+wire [8:0] fb_w  = hires ? 9'd320 : 9'd160;
+wire [7:0] fb_h  = hires ? 8'd240 : 8'd120;
+wire [9:0] fb_xs = (hires ? {1'b0, scr_x[9:1]} : {2'b0, scr_x[9:2]}) + scroll_x;
+wire [8:0] fb_ys = (hires ? {1'b0, scr_y[8:1]} : {2'b0, scr_y[8:2]}) + scroll_y;
+wire [8:0] fb_x  = (fb_xs >= fb_w) ? fb_xs - fb_w : fb_xs[8:0];
+wire [7:0] fb_y  = (fb_ys >= fb_h) ? fb_ys - fb_h : fb_ys[7:0];
+
+// Both modes have 160 bytes per line (320 pixels at 4 bpp)
 // y * 160 = y * 128 + y * 32 = (y << 7) + (y << 5)
-wire [14:0] fb_rd_addr = active
-    ? ({1'b0, fb_y, 7'd0} + {3'd0, fb_y, 5'd0} + {7'd0, fb_x})
-    : 15'd0;
+wire [7:0]  fb_col     = hires ? fb_x[8:1] : fb_x[7:0];
+wire [15:0] fb_rd_addr = active
+    ? ({1'b0, fb_y, 7'd0} + {3'd0, fb_y, 5'd0} + {8'd0, fb_col})
+    : 16'd0;
 
 // Registered read — 1-cycle latency
 reg [7:0] pixel_data;
+reg       nibble_d;
+always @(posedge clk) begin
+    pixel_data <= {framebuffer_hi[fb_rd_addr], framebuffer_lo[fb_rd_addr]};
+    nibble_d   <= fb_x[0];
+end
+
+// Palette lookup — 1 more cycle
+wire [3:0] pixel_nibble = nibble_d ? pixel_data[7:4] : pixel_data[3:0];
+wire [7:0] pal_rd_index = hires ? {pal_offset[7:4], pixel_nibble + pal_offset[3:0]}
+                                : pixel_data + pal_offset;
+
+reg [11:0] pal_rgb;
+reg [7:0]  pixel_d2;
 always @(posedge clk) begin
-    pixel_data <= framebuffer[fb_rd_addr];
+    pal_rgb  <= palette[pal_rd_index];
+    pixel_d2 <= pixel_data;
 end
 
+// **************************************************
+//       Text layer — 40x30 cells of 8x8 glyphs, 2x
+// **************************************************
+// Same latency as the framebuffer path: cell read, then
+// glyph read, then the output stage below.
+
+wire [5:0]  txt_col     = scr_x[9:4];
+wire [4:0]  txt_row     = scr_y[8:4];
+wire [5:0]  txt_row_sum = txt_row + txt_origin;
+wire [4:0]  txt_ram_row = (txt_row_sum >= TXT_ROWS) ? txt_row_sum - TXT_ROWS : txt_row_sum;
+
+// row * 40 = (row << 5) + (row << 3)
+wire [10:0] txt_rd_addr = {1'b0, txt_ram_row, 5'd0} + {3'd0, txt_ram_row, 3'd0} + {5'd0, txt_col};
+
+reg [15:0] txt_cell;
+reg [2:0]  glyph_x_d1, glyph_x_d2;
+reg [2:0]  glyph_y_d1;
+reg        cursor_d1, cursor_d2;
+reg [7:0]  txt_attr_d2;
+always @(posedge clk) begin
+    txt_cell    <= text_ram[txt_rd_addr];
+    glyph_x_d1  <= scr_x[3:1];
+    glyph_y_d1  <= scr_y[3:1];
+    cursor_d1   <= (txt_rd_addr == txt_pos);
+    glyph_x_d2  <= glyph_x_d1;
+    txt_attr_d2 <= txt_cell[15:8];
+    cursor_d2   <= cursor_d1 && (glyph_y_d1 >= 3'd6);   // Underline cursor
+end
+
+wire [7:0] glyph_bits;
+
+vga_font_rom u_font (
+    .clk(clk),
+    .ch(txt_cell[6:0]),
+    .row(glyph_y_d1),
+    .bits(glyph_bits)
+);
+
+// Cursor blink: about 0.5 s on, 0.5 s off
+reg [5:0] frame_cnt;
+always @(posedge clk) begin
+    if (rst)
+        frame_cnt <= 6'd0;
+    else if (pixel_en && h_count == H_TOTAL - 1 && v_count == V_TOTAL - 1)
+        frame_cnt <= frame_cnt + 1'd1;
+end
+
+// **************************************************
+//       Raster interrupts
+// **************************************************
+// Both fire at h_count 0: the line-compare source 144 pixel
+// clocks before the first pixel of line LINE_CMP, so a
+// short handler can still change the scroll for that line.
+
+wire line_start = pixel_en && (h_count == 10'd0);
+wire [1:0] irq_event = {line_start && (v_count == V_END),
+                        line_start && (v_count == V_START + line_cmp)};
+
+assign irq = |(irq_status & irq_en);
+
+wire cursor_on = cursor_en && (!cursor_blink || !frame_cnt[5]);
+wire txt_fg    = txt_en && (glyph_bits[glyph_x_d2] || (cursor_d2 && cursor_on));
+wire txt_bg    = txt_en && txt_attr_d2[7];
+
+// 16-color text palette (CGA order), 4:4:4
+function [11:0] txt_color;
+    input [3:0] idx;
+    begin
+        case (idx)
+            4'd0:  txt_color = 12'h000;  // Black
+            4'd1:  txt_color = 12'h00A;  // Blue
+            4'd2:  txt_color = 12'h0A0;  // Green
+            4'd3:  txt_color = 12'h0AA;  // Cyan
+            4'd4:  txt_color = 12'hA00;  // Red
+            4'd5:  txt_color = 12'hA0A;  // Magenta
+            4'd6:  txt_color = 12'hA50;  // Brown
+            4'd7:  txt_color = 12'hAAA;  // Light gray
+            4'd8:  txt_color = 12'h555;  // Dark gray
+            4'd9:  txt_color = 12'h55F;  // Light blue
+            4'd10: txt_color = 12'h5F5;  // Light green
+            4'd11: txt_color = 12'h5FF;  // Light cyan
+            4'd12: txt_color = 12'hF55;  // Light red
+            4'd13: txt_color = 12'hF5F;  // Light magenta
+            4'd14: txt_color = 12'hFF5;  // Yellow
+            default: txt_color = 12'hFFF; // White
+        endcase
+    end
+endfunction
+
+wire [11:0] txt_rgb = txt_fg ? txt_color(txt_attr_d2[3:0]) : txt_color({1'b0, txt_attr_d2[6:4]});
+
 // Delay active flag to match read latency
 reg active_d;
+reg active_d2;
 always @(posedge clk) begin
-    active_d <= active;
+    active_d  <= active;
+    active_d2 <= active_d;
 end
 
 // **************************************************
-//   RGB output — 8-bit (3-3-2) → 4-bit DAC
+//   RGB output — text, 3-3-2 or palette → 4-bit DAC
 // **************************************************
 // R[7:5] → 4-bit : {R[7:5], R[7]}
 // G[4:2] → 4-bit : {G[4:2], G[4]}
 // B[1:0] → 4-bit : {B[1:0], B[1:0]}
 
 always @(posedge clk) begin
-    if (active_d) begin
-        vga_r <= {pixel_data[7:5], pixel_data[7]};
-        vga_g <= {pixel_data[4:2], pixel_data[4]};
-        vga_b <= {pixel_data[1:0], pixel_data[1:0]};
-    end else begin
+    if (!active_d2) begin
         vga_r <= 4'd0;
         vga_g <= 4'd0;
         vga_b <= 4'd0;
+    end else if (txt_fg || txt_bg) begin
+        vga_r <= txt_rgb[11:8];
+        vga_g <= txt_rgb[7:4];
+        vga_b <= txt_rgb[3:0];
+    end else if (mode == MODE_RGB332) begin
+        vga_r <= {pixel_d2[7:5], pixel_d2[7]};
+        vga_g <= {pixel_d2[4:2], pixel_d2[4]};
+        vga_b <= {pixel_d2[1:0], pixel_d2[1:0]};
+    end else begin
+        vga_r <= pal_rgb[11:8];
+        vga_g <= pal_rgb[7:4];
+        vga_b <= pal_rgb[3:0];
     end
 end
 
@@ -225,7 +467,11 @@ reg [DATA_WIDTH-1:0] write_data_reg;
 reg [ADDR_WIDTH-1:0] read_addr_reg;
 
 // CPU-side framebuffer write address (auto-incrementing)
-reg [14:0] fb_wr_addr;
+reg [15:0] fb_wr_addr;
+wire [15:0] fb_wr_last = (mode == MODE_PAL4) ? FB_BYTES - 1 : FB_SIZE - 1;
+
+// CPU-side palette write index (auto-incrementing)
+reg [7:0] pal_wr_index;
 
 assign s_axil_awready = s_axil_awready_reg;
 assign s_axil_wready  = s_axil_wready_reg;
@@ -244,8 +490,25 @@ always @(posedge clk) begin
         s_axil_bvalid_reg  <= 0;
         write_addr_reg     <= 0;
         write_data_reg     <= 0;
-        fb_wr_addr         <= 15'd0;
+        fb_wr_addr         <= 16'd0;
+        mode               <= MODE_RGB332;
+        pal_offset         <= 8'd0;
+        pal_wr_index       <= 8'd0;
+        txt_en             <= 1'b0;
+        cursor_en          <= 1'b0;
+        cursor_blink       <= 1'b0;
+        txt_pos            <= 11'd0;
+        txt_attr           <= 8'h0F;
+        txt_origin         <= 5'd0;
+        scroll_x           <= 9'd0;
+        scroll_y           <= 8'd0;
+        line_cmp           <= 9'd0;
+        irq_en             <= 2'b00;
+        irq_status         <= 2'b00;
     end else begin
+        // Raster interrupt sources latch until written 1 in IRQ_STATUS
+        irq_status <= irq_status | irq_event;
+
         // Address Handshake
         if (s_axil_awvalid && !s_axil_awready_reg && (!s_axil_bvalid_reg || s_axil_bready)) begin
             s_axil_awready_reg <= 1;
@@ -266,17 +529,73 @@ always @(posedge clk) begin
         if (s_axil_awready_reg && s_axil_wready_reg) begin
             s_axil_bvalid_reg <= 1;
 
-            case (write_addr_reg[3:2])
-                2'b00: begin // FB_ADDR (0x00)
-                    fb_wr_addr <= write_data_reg[14:0];
+            case (write_addr_reg[6:2])
+                REG_ADDR: begin
+                    fb_wr_addr <= write_data_reg[15:0];
                 end
-                2'b01: begin // FB_DATA (0x04)
-                    framebuffer[fb_wr_addr] <= write_data_reg[7:0];
-                    if (fb_wr_addr < FB_SIZE - 1)
+                REG_DATA: begin
+                    framebuffer_lo[fb_wr_addr] <= write_data_reg[3:0];
+                    framebuffer_hi[fb_wr_addr] <= write_data_reg[7:4];
+                    if (fb_wr_addr < fb_wr_last)
                         fb_wr_addr <= fb_wr_addr + 1'd1;
                     else
-                        fb_wr_addr <= 15'd0;
+                        fb_wr_addr <= 16'd0;
+                end
+                REG_CTRL: begin
+                    mode <= (write_data_reg[1:0] == 2'd3) ? MODE_RGB332 : write_data_reg[1:0];
+                end
+                REG_PAL_IDX: begin
+                    pal_wr_index <= write_data_reg[7:0];
+                end
+                REG_PAL_DAT: begin
+                    palette[pal_wr_index] <= write_data_reg[11:0];
+                    pal_wr_index <= pal_wr_index + 1'd1;
+                end
+                REG_PAL_OFS: begin
+                    pal_offset <= write_data_reg[7:0];
+                end
+                REG_NIBBLE: begin
+                    if (write_data_reg[4])
+                        framebuffer_hi[fb_wr_addr] <= write_data_reg[3:0];
+                    else
+                        framebuffer_lo[fb_wr_addr] <= write_data_reg[3:0];
+                end
+                REG_TXT_CTL: begin
+                    txt_en       <= write_data_reg[0];
+                    cursor_en    <= write_data_reg[1];
+                    cursor_blink <= write_data_reg[2];
+                end
+                REG_TXT_POS: begin
+                    txt_pos <= (write_data_reg[10:0] < TXT_CELLS) ? write_data_reg[10:0] : 11'd0;
+                end
+                REG_TXT_PUT, REG_TXT_CEL: begin
+                    text_ram[txt_pos] <= (write_addr_reg[6:2] == REG_TXT_PUT)
+                                         ? {txt_attr, write_data_reg[7:0]}
+                                         : write_data_reg[15:0];
+                    txt_pos <= (txt_pos < TXT_CELLS - 1) ? txt_pos + 1'd1 : 11'd0;
+                end
+                REG_TXT_ATR: begin
+                    txt_attr <= write_data_reg[7:0];
+                end
+                REG_TXT_ORG: begin
+                    txt_origin <= (write_data_reg[4:0] < TXT_ROWS) ? write_data_reg[4:0] : 5'd0;
+                end
+                REG_SCRL_X: begin
+                    scroll_x <= write_data_reg[8:0];
+                end
+                REG_SCRL_Y: begin
+                    scroll_y <= write_data_reg[7:0];
+                end
+                REG_LINE_CMP: begin
+                    line_cmp <= write_data_reg[8:0];
+                end
+                REG_IRQ_EN: begin
+                    irq_en <= write_data_reg[1:0];
+                end
+                REG_IRQ_STA: begin
+                    irq_status <= (irq_status | irq_event) & ~write_data_reg[1:0];
                 end
+                default: ;
             endcase
         end else if (s_axil_bready && s_axil_bvalid_reg) begin
             s_axil_bvalid_reg <= 0;
@@ -302,10 +621,23 @@ always @(posedge clk) begin
         if (s_axil_arready_reg) begin
             s_axil_rvalid_reg <= 1;
 
-            case (read_addr_reg[3:2])
-                2'b00: s_axil_rdata_reg <= {17'd0, fb_wr_addr};       // FB_ADDR
-                2'b10: s_axil_rdata_reg <= {31'd0, in_vblank};        // FB_STATUS
-                default: s_axil_rdata_reg <= 32'd0;
+            case (read_addr_reg[6:2])
+                REG_ADDR:    s_axil_rdata_reg <= {16'd0, fb_wr_addr};
+                REG_STATUS:  s_axil_rdata_reg <= {31'd0, in_vblank};
+                REG_CTRL:    s_axil_rdata_reg <= {30'd0, mode};
+                REG_PAL_IDX: s_axil_rdata_reg <= {24'd0, pal_wr_index};
+                REG_PAL_OFS: s_axil_rdata_reg <= {24'd0, pal_offset};
+                REG_TXT_CTL: s_axil_rdata_reg <= {29'd0, cursor_blink, cursor_en, txt_en};
+                REG_TXT_POS: s_axil_rdata_reg <= {21'd0, txt_pos};
+                REG_TXT_ATR: s_axil_rdata_reg <= {24'd0, txt_attr};
+                REG_TXT_ORG: s_axil_rdata_reg <= {27'd0, txt_origin};
+                REG_SCRL_X:  s_axil_rdata_reg <= {23'd0, scroll_x};
+                REG_SCRL_Y:  s_axil_rdata_reg <= {24'd0, scroll_y};
+                REG_LINE_CMP: s_axil_rdata_reg <= {23'd0, line_cmp};
+                REG_IRQ_EN:  s_axil_rdata_reg <= {30'd0, irq_en};
+                REG_IRQ_STA: s_axil_rdata_reg <= {30'd0, irq_status};
+                REG_LINE:    s_axil_rdata_reg <= {22'd0, scr_y};
+                default:     s_axil_rdata_reg <= 32'd0;
             endcase
         end else if (s_axil_rready && s_axil_rvalid_reg) begin
             s_axil_rvalid_reg <= 0;
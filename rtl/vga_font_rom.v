@@ -0,0 +1,152 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// **************************************************
+//              VGA Text-Mode Font ROM
+//
+// 128 glyphs of 8x8 pixels for the axil_vga text
+// layer: printable ASCII 0x20-0x7E, 0x7F is a solid
+// block, 0x00-0x1F are blank. Bit 0 of a row is the
+// leftmost pixel. One glyph per ROM word, the row is
+// selected after the registered read (1-cycle
+// latency).
+//
+// **************************************************
+
+module vga_font_rom (
+    input  wire       clk,
+    input  wire [6:0] ch,
+    input  wire [2:0] row,
+    output wire [7:0] bits
+);
+
+reg [63:0] glyph;   // Row r in bits [8r+7:8r]
+reg [2:0]  row_q;
+
+always @(posedge clk) begin
+    row_q <= row;
+    case (ch)
+        7'h20: glyph <= 64'h0000000000000000;  // ' '
+        7'h21: glyph <= 64'h00180018183C3C18;  // !
+        7'h22: glyph <= 64'h0000000000003636;  // "
+        7'h23: glyph <= 64'h0036367F367F3636;  // #
+        7'h24: glyph <= 64'h000C1F301E033E0C;  // $
+        7'h25: glyph <= 64'h0063660C18336300;  // %
+        7'h26: glyph <= 64'h006E333B6E1C361C;  // &
+        7'h27: glyph <= 64'h0000000000030606;  // '
+        7'h28: glyph <= 64'h00180C0606060C18;  // (
+        7'h29: glyph <= 64'h00060C1818180C06;  // )
+        7'h2A: glyph <= 64'h0000663CFF3C6600;  // *
+        7'h2B: glyph <= 64'h00000C0C3F0C0C00;  // +
+        7'h2C: glyph <= 64'h060C0C0000000000;  // ,
+        7'h2D: glyph <= 64'h000000003F000000;  // -
+        7'h2E: glyph <= 64'h000C0C0000000000;  // .
+        7'h2F: glyph <= 64'h000103060C183060;  // /
+        7'h30: glyph <= 64'h003E676F7B73633E;  // 0
+        7'h31: glyph <= 64'h003F0C0C0C0C0E0C;  // 1
+        7'h32: glyph <= 64'h003F33061C30331E;  // 2
+        7'h33: glyph <= 64'h001E33301C30331E;  // 3
+        7'h34: glyph <= 64'h0078307F33363C38;  // 4
+        7'h35: glyph <= 64'h001E3330301F033F;  // 5
+        7'h36: glyph <= 64'h001E33331F03061C;  // 6
+        7'h37: glyph <= 64'h000C0C0C1830333F;  // 7
+        7'h38: glyph <= 64'h001E33331E33331E;  // 8
+        7'h39: glyph <= 64'h000E18303E33331E;  // 9
+        7'h3A: glyph <= 64'h000C0C00000C0C00;  // :
+        7'h3B: glyph <= 64'h060C0C00000C0C00;  // ;
+        7'h3C: glyph <= 64'h00180C0603060C18;  // <
+        7'h3D: glyph <= 64'h00003F00003F0000;  // =
+        7'h3E: glyph <= 64'h00060C1830180C06;  // >
+        7'h3F: glyph <= 64'h000C000C1830331E;  // ?
+        7'h40: glyph <= 64'h001E037B7B7B633E;  // @
+        7'h41: glyph <= 64'h0033333F33331E0C;  // A
+        7'h42: glyph <= 64'h003F66663E66663F;  // B
+        7'h43: glyph <= 64'h003C66030303663C;  // C
+        7'h44: glyph <= 64'h001F36666666361F;  // D
+        7'h45: glyph <= 64'h007F46161E16467F;  // E
+        7'h46: glyph <= 64'h000F06161E16467F;  // F
+        7'h47: glyph <= 64'h007C66730303663C;  // G
+        7'h48: glyph <= 64'h003333333F333333;  // H
+        7'h49: glyph <= 64'h001E0C0C0C0C0C1E;  // I
+        7'h4A: glyph <= 64'h001E333330303078;  // J
+        7'h4B: glyph <= 64'h006766361E366667;  // K
+        7'h4C: glyph <= 64'h007F66460606060F;  // L
+        7'h4D: glyph <= 64'h0063636B7F7F7763;  // M
+        7'h4E: glyph <= 64'h006363737B6F6763;  // N
+        7'h4F: glyph <= 64'h001C36636363361C;  // O
+        7'h50: glyph <= 64'h000F06063E66663F;  // P
+        7'h51: glyph <= 64'h00381E3B3333331E;  // Q
+        7'h52: glyph <= 64'h006766363E66663F;  // R
+        7'h53: glyph <= 64'h001E33380E07331E;  // S
+        7'h54: glyph <= 64'h001E0C0C0C0C2D3F;  // T
+        7'h55: glyph <= 64'h003F333333333333;  // U
+        7'h56: glyph <= 64'h000C1E3333333333;  // V
+        7'h57: glyph <= 64'h0063777F6B636363;  // W
+        7'h58: glyph <= 64'h0063361C1C366363;  // X
+        7'h59: glyph <= 64'h001E0C0C1E333333;  // Y
+        7'h5A: glyph <= 64'h007F664C1831637F;  // Z
+        7'h5B: glyph <= 64'h001E06060606061E;  // [
+        7'h5C: glyph <= 64'h00406030180C0603;  // backslash
+        7'h5D: glyph <= 64'h001E18181818181E;  // ]
+        7'h5E: glyph <= 64'h0000000063361C08;  // ^
+        7'h5F: glyph <= 64'hFF00000000000000;  // _
+        7'h60: glyph <= 64'h0000000000180C0C;  // `
+        7'h61: glyph <= 64'h006E333E301E0000;  // a
+        7'h62: glyph <= 64'h003B66663E060607;  // b
+        7'h63: glyph <= 64'h001E3303331E0000;  // c
+        7'h64: glyph <= 64'h006E33333E303038;  // d
+        7'h65: glyph <= 64'h001E033F331E0000;  // e
+        7'h66: glyph <= 64'h000F06060F06361C;  // f
+        7'h67: glyph <= 64'h1F303E33336E0000;  // g
+        7'h68: glyph <= 64'h006766666E360607;  // h
+        7'h69: glyph <= 64'h001E0C0C0C0E000C;  // i
+        7'h6A: glyph <= 64'h1E33333030300030;  // j
+        7'h6B: glyph <= 64'h0067361E36660607;  // k
+        7'h6C: glyph <= 64'h001E0C0C0C0C0C0E;  // l
+        7'h6D: glyph <= 64'h00636B7F7F330000;  // m
+        7'h6E: glyph <= 64'h00333333331F0000;  // n
+        7'h6F: glyph <= 64'h001E3333331E0000;  // o
+        7'h70: glyph <= 64'h0F063E66663B0000;  // p
+        7'h71: glyph <= 64'h78303E33336E0000;  // q
+        7'h72: glyph <= 64'h000F06666E3B0000;  // r
+        7'h73: glyph <= 64'h001F301E033E0000;  // s
+        7'h74: glyph <= 64'h00182C0C0C3E0C08;  // t
+        7'h75: glyph <= 64'h006E333333330000;  // u
+        7'h76: glyph <= 64'h000C1E3333330000;  // v
+        7'h77: glyph <= 64'h00367F7F6B630000;  // w
+        7'h78: glyph <= 64'h0063361C36630000;  // x
+        7'h79: glyph <= 64'h1F303E3333330000;  // y
+        7'h7A: glyph <= 64'h003F260C193F0000;  // z
+        7'h7B: glyph <= 64'h00380C0C070C0C38;  // {
+        7'h7C: glyph <= 64'h0018181800181818;  // |
+        7'h7D: glyph <= 64'h00070C0C380C0C07;  // }
+        7'h7E: glyph <= 64'h0000000000003B6E;  // ~
+        7'h7F: glyph <= 64'hFFFFFFFFFFFFFFFF;  // DEL
+        default: glyph <= 64'h0000000000000000;
+    endcase
+end
+
+assign bits = glyph[row_q*8 +: 8];
+
+endmodule
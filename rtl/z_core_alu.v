@@ -25,32 +25,70 @@ SOFTWARE.
 module z_core_alu (
     input [31:0] alu_in1,
     input [31:0] alu_in2,
-    input [4:0] alu_inst_type,
+    input [5:0] alu_inst_type,
     output [31:0] alu_out,
     output reg alu_branch
 );
 
 // Instructions
-localparam INST_ADD = 5'd0;  // Used For Multiple Instructions
-localparam INST_SUB = 5'd1;
-localparam INST_SLL = 5'd2;  // Both SLL and SLLI
-localparam INST_SLT = 5'd3;  // Both SLT and SLTI
-localparam INST_SLTU = 5'd4; // Both SLTU and SLTIU
-localparam INST_XOR = 5'd5;  // Both XOR and XORI
-localparam INST_SRL = 5'd6;  // Both SRL and SRLI
-localparam INST_SRA = 5'd7;  // Both SRA and SRAI
-localparam INST_OR = 5'd8;   // Both OR and ORI
-localparam INST_AND = 5'd9;  // Both AND and ANDI
-localparam INST_BEQ = 5'd10;
-localparam INST_BNE = 5'd11;
-localparam INST_BLT = 5'd12;
-localparam INST_BGE = 5'd13;
-localparam INST_BLTU = 5'd14;
-localparam INST_BGEU = 5'd15;
-localparam INST_MUL = 5'd16;
-localparam INST_MULH = 5'd17;
-localparam INST_MULHSU = 5'd18;
-localparam INST_MULHU = 5'd19;
+localparam INST_ADD = 6'd0;  // Used For Multiple Instructions
+localparam INST_SUB = 6'd1;
+localparam INST_SLL = 6'd2;  // Both SLL and SLLI
+localparam INST_SLT = 6'd3;  // Both SLT and SLTI
+localparam INST_SLTU = 6'd4; // Both SLTU and SLTIU
+localparam INST_XOR = 6'd5;  // Both XOR and XORI
+localparam INST_SRL = 6'd6;  // Both SRL and SRLI
+localparam INST_SRA = 6'd7;  // Both SRA and SRAI
+localparam INST_OR = 6'd8;   // Both OR and ORI
+localparam INST_AND = 6'd9;  // Both AND and ANDI
+localparam INST_BEQ = 6'd10;
+localparam INST_BNE = 6'd11;
+localparam INST_BLT = 6'd12;
+localparam INST_BGE = 6'd13;
+localparam INST_BLTU = 6'd14;
+localparam INST_BGEU = 6'd15;
+localparam INST_MUL = 6'd16;
+localparam INST_MULH = 6'd17;
+localparam INST_MULHSU = 6'd18;
+localparam INST_MULHU = 6'd19;
+
+// Zba
+localparam INST_SH1ADD = 6'd24;
+localparam INST_SH2ADD = 6'd25;
+localparam INST_SH3ADD = 6'd26;
+
+// Zbb
+localparam INST_ANDN  = 6'd27;
+localparam INST_ORN   = 6'd28;
+localparam INST_XNOR  = 6'd29;
+localparam INST_CLZ   = 6'd30;
+localparam INST_CTZ   = 6'd31;
+localparam INST_CPOP  = 6'd32;
+localparam INST_MIN   = 6'd33;
+localparam INST_MINU  = 6'd34;
+localparam INST_MAX   = 6'd35;
+localparam INST_MAXU  = 6'd36;
+localparam INST_SEXTB = 6'd37;
+localparam INST_SEXTH = 6'd38;
+localparam INST_ZEXTH = 6'd39;
+localparam INST_ROL   = 6'd40;
+localparam INST_ROR   = 6'd41; // Both ROR and RORI
+localparam INST_ORCB  = 6'd42;
+localparam INST_REV8  = 6'd43;
+
+// Packed-SIMD (custom-0 / custom-1)
+localparam INST_PADDUSB  = 6'd44;
+localparam INST_PSUBUSB  = 6'd45;
+localparam INST_PCMPEQB  = 6'd46;
+localparam INST_PCMPLTUB = 6'd47;
+localparam INST_PMINUB   = 6'd48;
+localparam INST_PMAXUB   = 6'd49;
+localparam INST_PSELNZB  = 6'd50;
+localparam INST_PSHUFB   = 6'd51; // Both PSHUFB and PSHUFBI
+localparam INST_PAVG332  = 6'd52;
+localparam INST_PBLD332  = 6'd53;
+localparam INST_PADDS332 = 6'd54;
+localparam INST_PSUBS332 = 6'd55;
 
 // ##################################################
 //       MULTIPLIER UNIT (uses z_core_mult_unit)
@@ -75,6 +113,58 @@ z_core_mult_unit mult_unit (
 );
 
 
+// ##################################################
+//       PACKED-SIMD UNIT (uses z_core_simd_unit)
+// ##################################################
+
+wire [31:0] simd_result;
+wire        is_simd = (alu_inst_type >= INST_PADDUSB) && (alu_inst_type <= INST_PSUBS332);
+wire [5:0]  simd_sel = alu_inst_type - INST_PADDUSB;
+
+z_core_simd_unit simd_unit (
+    .simd_in1(alu_in1),
+    .simd_in2(alu_in2),
+    .simd_op(simd_sel[3:0]),
+    .simd_out(simd_result)
+);
+
+// ##################################################
+//       BIT-MANIPULATION HELPERS (Zbb)
+// ##################################################
+
+// Count leading zeros: the highest set bit wins (last assignment)
+function [5:0] count_lz;
+    input [31:0] value;
+    integer i;
+    begin
+        count_lz = 6'd32;
+        for (i = 0; i < 32; i = i + 1)
+            if (value[i]) count_lz = 6'd31 - i;
+    end
+endfunction
+
+// Count trailing zeros: the lowest set bit wins (last assignment)
+function [5:0] count_tz;
+    input [31:0] value;
+    integer i;
+    begin
+        count_tz = 6'd32;
+        for (i = 31; i >= 0; i = i - 1)
+            if (value[i]) count_tz = i;
+    end
+endfunction
+
+// Population count
+function [5:0] count_ones;
+    input [31:0] value;
+    integer i;
+    begin
+        count_ones = 6'd0;
+        for (i = 0; i < 32; i = i + 1)
+            count_ones = count_ones + value[i];
+    end
+endfunction
+
 // ##################################################
 //       ALU Result - Continuous Assignment Mux
 // ##################################################
@@ -93,6 +183,39 @@ wire [31:0] and_result  = alu_in1 & alu_in2;
 wire [31:0] mul_result  = multiplier_result[31:0];
 wire [31:0] mulh_result = multiplier_result[63:32];
 
+// Zba: shift-and-add (address generation)
+wire [31:0] sh1add_result = {alu_in1[30:0], 1'b0} + alu_in2;
+wire [31:0] sh2add_result = {alu_in1[29:0], 2'b0} + alu_in2;
+wire [31:0] sh3add_result = {alu_in1[28:0], 3'b0} + alu_in2;
+
+// Zbb: logic with negate, min/max, extension
+wire [31:0] andn_result  = alu_in1 & ~alu_in2;
+wire [31:0] orn_result   = alu_in1 | ~alu_in2;
+wire [31:0] xnor_result  = ~(alu_in1 ^ alu_in2);
+wire [31:0] min_result   = ($signed(alu_in1) < $signed(alu_in2)) ? alu_in1 : alu_in2;
+wire [31:0] minu_result  = (alu_in1 < alu_in2) ? alu_in1 : alu_in2;
+wire [31:0] max_result   = ($signed(alu_in1) < $signed(alu_in2)) ? alu_in2 : alu_in1;
+wire [31:0] maxu_result  = (alu_in1 < alu_in2) ? alu_in2 : alu_in1;
+wire [31:0] sextb_result = {{24{alu_in1[7]}}, alu_in1[7:0]};
+wire [31:0] sexth_result = {{16{alu_in1[15]}}, alu_in1[15:0]};
+wire [31:0] zexth_result = {16'b0, alu_in1[15:0]};
+
+// Zbb: bit counting
+wire [31:0] clz_result   = {26'b0, count_lz(alu_in1)};
+wire [31:0] ctz_result   = {26'b0, count_tz(alu_in1)};
+wire [31:0] cpop_result  = {26'b0, count_ones(alu_in1)};
+
+// Zbb: rotates - shift a doubled operand and keep the wrapped half
+wire [63:0] rol_wide     = {alu_in1, alu_in1} << alu_in2[4:0];
+wire [63:0] ror_wide     = {alu_in1, alu_in1} >> alu_in2[4:0];
+wire [31:0] rol_result   = rol_wide[63:32];
+wire [31:0] ror_result   = ror_wide[31:0];
+
+// Zbb: byte-granular ops
+wire [31:0] orcb_result  = {{8{|alu_in1[31:24]}}, {8{|alu_in1[23:16]}},
+                            {8{|alu_in1[15:8]}},  {8{|alu_in1[7:0]}}};
+wire [31:0] rev8_result  = {alu_in1[7:0], alu_in1[15:8], alu_in1[23:16], alu_in1[31:24]};
+
 // Output mux using continuous assignment
 assign alu_out = (alu_inst_type == INST_ADD)    ? add_result  :
                  (alu_inst_type == INST_SUB)    ? sub_result  :
@@ -108,6 +231,27 @@ assign alu_out = (alu_inst_type == INST_ADD)    ? add_result  :
                  (alu_inst_type == INST_MULH)   ? mulh_result :
                  (alu_inst_type == INST_MULHSU) ? mulh_result :
                  (alu_inst_type == INST_MULHU)  ? mulh_result :
+                 (alu_inst_type == INST_SH1ADD) ? sh1add_result :
+                 (alu_inst_type == INST_SH2ADD) ? sh2add_result :
+                 (alu_inst_type == INST_SH3ADD) ? sh3add_result :
+                 (alu_inst_type == INST_ANDN)   ? andn_result :
+                 (alu_inst_type == INST_ORN)    ? orn_result  :
+                 (alu_inst_type == INST_XNOR)   ? xnor_result :
+                 (alu_inst_type == INST_CLZ)    ? clz_result  :
+                 (alu_inst_type == INST_CTZ)    ? ctz_result  :
+                 (alu_inst_type == INST_CPOP)   ? cpop_result :
+                 (alu_inst_type == INST_MIN)    ? min_result  :
+                 (alu_inst_type == INST_MINU)   ? minu_result :
+                 (alu_inst_type == INST_MAX)    ? max_result  :
+                 (alu_inst_type == INST_MAXU)   ? maxu_result :
+                 (alu_inst_type == INST_SEXTB)  ? sextb_result :
+                 (alu_inst_type == INST_SEXTH)  ? sexth_result :
+                 (alu_inst_type == INST_ZEXTH)  ? zexth_result :
+                 (alu_inst_type == INST_ROL)    ? rol_result  :
+                 (alu_inst_type == INST_ROR)    ? ror_result  :
+                 (alu_inst_type == INST_ORCB)   ? orcb_result :
+                 (alu_inst_type == INST_REV8)   ? rev8_result :
+                 is_simd                        ? simd_result :
                  32'd0;
 
 // ##################################################
@@ -27,7 +27,8 @@ module z_core_alu_ctrl(
     input [6:0] alu_op,
     input [2:0] alu_funct3,
     input [6:0] alu_funct7,
-    output reg [4:0] alu_inst_type
+    input [4:0] alu_rs2,        // rs2 field, selects Zbb unary ops (CLZ/CTZ/...)
+    output reg [5:0] alu_inst_type
 );
 
 // R-Type Instructions
@@ -47,6 +48,13 @@ localparam JAL_INST = 7'b1101111;
 localparam LUI_INST = 7'b0110111;
 localparam AUIPC_INST = 7'b0010111;
 
+// Atomic Instructions (A extension)
+localparam AMO_INST = 7'b0101111;
+
+// Custom Instructions (Packed-SIMD)
+localparam CUSTOM0_INST = 7'b0001011; // R-type
+localparam CUSTOM1_INST = 7'b0101011; // I-type
+
 // Function3 Codes
 localparam F3_ADD_SUB_LB_JALR_SB_BEQ_MUL = 3'b000;
 localparam F3_SLL_LH_SH_BNE_MULH = 3'b001;
@@ -57,32 +65,84 @@ localparam F3_SRL_SRA_LHU_BGE_DIVU = 3'b101;
 localparam F3_OR_BLTU_REM = 3'b110;
 localparam F3_AND_BGEU_REMU = 3'b111;
 
+// Funct7 Codes (Zba/Zbb)
+localparam F7_BASE   = 7'b0000000;
+localparam F7_ALT    = 7'b0100000; // SUB/SRA and ANDN/ORN/XNOR
+localparam F7_MULDIV = 7'b0000001;
+localparam F7_SHADD  = 7'b0010000; // SH1ADD/SH2ADD/SH3ADD
+localparam F7_MINMAX = 7'b0000101; // MIN/MINU/MAX/MAXU
+localparam F7_ZEXTH  = 7'b0000100; // ZEXT.H (rs2 = 0)
+localparam F7_ROT    = 7'b0110000; // ROL/ROR/RORI and CLZ/CTZ/CPOP/SEXT.B/SEXT.H
+localparam F7_ORCB   = 7'b0010100; // ORC.B (rs2 = 5'b00111)
+localparam F7_REV8   = 7'b0110100; // REV8  (rs2 = 5'b11000)
+
+// Funct7 Codes (custom-0)
+localparam F7_SIMD_BYTE  = 7'b0000000; // Byte-lane ops
+localparam F7_SIMD_COLOR = 7'b0000001; // 3-3-2 color ops
+
 // Instructions
-localparam INST_ADD = 5'd0;  // Used For Multiple Instructions
-localparam INST_SUB = 5'd1;
-localparam INST_SLL = 5'd2;  // Both SLL and SLLI
-localparam INST_SLT = 5'd3;  // Both SLT and SLTI
-localparam INST_SLTU = 5'd4; // Both SLTU and SLTIU
-localparam INST_XOR = 5'd5;  // Both XOR and XORI
-localparam INST_SRL = 5'd6;  // Both SRL and SRLI
-localparam INST_SRA = 5'd7;  // Both SRA and SRAI
-localparam INST_OR = 5'd8;   // Both OR and ORI
-localparam INST_AND = 5'd9;  // Both AND and ANDI
-localparam INST_BEQ = 5'd10;
-localparam INST_BNE = 5'd11;
-localparam INST_BLT = 5'd12;
-localparam INST_BGE = 5'd13;
-localparam INST_BLTU = 5'd14;
-localparam INST_BGEU = 5'd15;
-localparam INST_MUL = 5'd16;
-localparam INST_MULH = 5'd17;
-localparam INST_MULHSU = 5'd18;
-localparam INST_MULHU = 5'd19;
-localparam INST_DIV = 5'd20;
-localparam INST_DIVU = 5'd21;
-localparam INST_REM = 5'd22;
-localparam INST_REMU = 5'd23;
+localparam INST_ADD = 6'd0;  // Used For Multiple Instructions
+localparam INST_SUB = 6'd1;
+localparam INST_SLL = 6'd2;  // Both SLL and SLLI
+localparam INST_SLT = 6'd3;  // Both SLT and SLTI
+localparam INST_SLTU = 6'd4; // Both SLTU and SLTIU
+localparam INST_XOR = 6'd5;  // Both XOR and XORI
+localparam INST_SRL = 6'd6;  // Both SRL and SRLI
+localparam INST_SRA = 6'd7;  // Both SRA and SRAI
+localparam INST_OR = 6'd8;   // Both OR and ORI
+localparam INST_AND = 6'd9;  // Both AND and ANDI
+localparam INST_BEQ = 6'd10;
+localparam INST_BNE = 6'd11;
+localparam INST_BLT = 6'd12;
+localparam INST_BGE = 6'd13;
+localparam INST_BLTU = 6'd14;
+localparam INST_BGEU = 6'd15;
+localparam INST_MUL = 6'd16;
+localparam INST_MULH = 6'd17;
+localparam INST_MULHSU = 6'd18;
+localparam INST_MULHU = 6'd19;
+localparam INST_DIV = 6'd20;
+localparam INST_DIVU = 6'd21;
+localparam INST_REM = 6'd22;
+localparam INST_REMU = 6'd23;
+
+// Zba
+localparam INST_SH1ADD = 6'd24;
+localparam INST_SH2ADD = 6'd25;
+localparam INST_SH3ADD = 6'd26;
 
+// Zbb
+localparam INST_ANDN  = 6'd27;
+localparam INST_ORN   = 6'd28;
+localparam INST_XNOR  = 6'd29;
+localparam INST_CLZ   = 6'd30;
+localparam INST_CTZ   = 6'd31;
+localparam INST_CPOP  = 6'd32;
+localparam INST_MIN   = 6'd33;
+localparam INST_MINU  = 6'd34;
+localparam INST_MAX   = 6'd35;
+localparam INST_MAXU  = 6'd36;
+localparam INST_SEXTB = 6'd37;
+localparam INST_SEXTH = 6'd38;
+localparam INST_ZEXTH = 6'd39;
+localparam INST_ROL   = 6'd40;
+localparam INST_ROR   = 6'd41; // Both ROR and RORI
+localparam INST_ORCB  = 6'd42;
+localparam INST_REV8  = 6'd43;
+
+// Packed-SIMD (custom-0 / custom-1)
+localparam INST_PADDUSB  = 6'd44;
+localparam INST_PSUBUSB  = 6'd45;
+localparam INST_PCMPEQB  = 6'd46;
+localparam INST_PCMPLTUB = 6'd47;
+localparam INST_PMINUB   = 6'd48;
+localparam INST_PMAXUB   = 6'd49;
+localparam INST_PSELNZB  = 6'd50;
+localparam INST_PSHUFB   = 6'd51; // Both PSHUFB and PSHUFBI
+localparam INST_PAVG332  = 6'd52;
+localparam INST_PBLD332  = 6'd53;
+localparam INST_PADDS332 = 6'd54;
+localparam INST_PSUBS332 = 6'd55;
 
 always @(*) begin
     case(alu_op)
@@ -97,31 +157,117 @@ always @(*) begin
                         alu_inst_type = INST_ADD; // ADD
                     end
                 end
-                F3_SLL_LH_SH_BNE_MULH: alu_inst_type = alu_funct7[0] ? INST_MULH : INST_SLL; // SLL or MULH
-                F3_SLT_LW_SW_MULHSU: alu_inst_type = alu_funct7[0] ? INST_MULHSU : INST_SLT; // SLT or MULHSU
+                F3_SLL_LH_SH_BNE_MULH: alu_inst_type = (alu_funct7 == F7_ROT) ? INST_ROL : // ROL
+                                                       alu_funct7[0] ? INST_MULH : INST_SLL; // SLL or MULH
+                F3_SLT_LW_SW_MULHSU: alu_inst_type = (alu_funct7 == F7_SHADD) ? INST_SH1ADD : // SH1ADD
+                                                     alu_funct7[0] ? INST_MULHSU : INST_SLT; // SLT or MULHSU
                 F3_SLTU_MULHU: alu_inst_type = alu_funct7[0] ? INST_MULHU : INST_SLTU; // SLTU or MULHU
-                F3_XOR_LBU_BLT_DIV: alu_inst_type = alu_funct7[0] ? INST_DIV : INST_XOR; // XOR
-                F3_SRL_SRA_LHU_BGE_DIVU: alu_inst_type = alu_funct7[0] ? INST_DIVU : (alu_funct7[5] ? INST_SRA : INST_SRL); // SRL or SRA
-                F3_OR_BLTU_REM: alu_inst_type = alu_funct7[0] ? INST_REM : INST_OR; // OR
-                F3_AND_BGEU_REMU: alu_inst_type = alu_funct7[0] ? INST_REMU : INST_AND; // AND
-                default: alu_inst_type = 5'bxxxxx; // Invalid
+                F3_XOR_LBU_BLT_DIV: begin
+                    case (alu_funct7)
+                        F7_MULDIV: alu_inst_type = INST_DIV;    // DIV
+                        F7_ALT:    alu_inst_type = INST_XNOR;   // XNOR
+                        F7_SHADD:  alu_inst_type = INST_SH2ADD; // SH2ADD
+                        F7_MINMAX: alu_inst_type = INST_MIN;    // MIN
+                        F7_ZEXTH:  alu_inst_type = (alu_rs2 == 5'b00000) ? INST_ZEXTH : INST_XOR; // ZEXT.H
+                        default:   alu_inst_type = INST_XOR;    // XOR
+                    endcase
+                end
+                F3_SRL_SRA_LHU_BGE_DIVU: begin
+                    case (alu_funct7)
+                        F7_MULDIV: alu_inst_type = INST_DIVU;   // DIVU
+                        F7_MINMAX: alu_inst_type = INST_MINU;   // MINU
+                        F7_ROT:    alu_inst_type = INST_ROR;    // ROR
+                        default:   alu_inst_type = alu_funct7[5] ? INST_SRA : INST_SRL; // SRL or SRA
+                    endcase
+                end
+                F3_OR_BLTU_REM: begin
+                    case (alu_funct7)
+                        F7_MULDIV: alu_inst_type = INST_REM;    // REM
+                        F7_ALT:    alu_inst_type = INST_ORN;    // ORN
+                        F7_SHADD:  alu_inst_type = INST_SH3ADD; // SH3ADD
+                        F7_MINMAX: alu_inst_type = INST_MAX;    // MAX
+                        default:   alu_inst_type = INST_OR;     // OR
+                    endcase
+                end
+                F3_AND_BGEU_REMU: begin
+                    case (alu_funct7)
+                        F7_MULDIV: alu_inst_type = INST_REMU;   // REMU
+                        F7_ALT:    alu_inst_type = INST_ANDN;   // ANDN
+                        F7_MINMAX: alu_inst_type = INST_MAXU;   // MAXU
+                        default:   alu_inst_type = INST_AND;    // AND
+                    endcase
+                end
+                default: alu_inst_type = 6'bxxxxxx; // Invalid
             endcase
         end
         I_INST: begin
             case(alu_funct3)
                 F3_ADD_SUB_LB_JALR_SB_BEQ_MUL: alu_inst_type = INST_ADD; // ADDI
-                F3_SLL_LH_SH_BNE_MULH: alu_inst_type = INST_SLL; // SLLI
+                F3_SLL_LH_SH_BNE_MULH: begin
+                    if (alu_funct7 == F7_ROT) begin
+                        case (alu_rs2)
+                            5'b00000: alu_inst_type = INST_CLZ;   // CLZ
+                            5'b00001: alu_inst_type = INST_CTZ;   // CTZ
+                            5'b00010: alu_inst_type = INST_CPOP;  // CPOP
+                            5'b00100: alu_inst_type = INST_SEXTB; // SEXT.B
+                            5'b00101: alu_inst_type = INST_SEXTH; // SEXT.H
+                            default:  alu_inst_type = INST_SLL;
+                        endcase
+                    end else begin
+                        alu_inst_type = INST_SLL; // SLLI
+                    end
+                end
                 F3_SLT_LW_SW_MULHSU: alu_inst_type = INST_SLT; // SLTI
                 F3_SLTU_MULHU: alu_inst_type = INST_SLTU; // SLTIU
                 F3_XOR_LBU_BLT_DIV: alu_inst_type = INST_XOR; // XORI
-                F3_SRL_SRA_LHU_BGE_DIVU: alu_inst_type = alu_funct7[5] ? INST_SRA : INST_SRL; // SRL or SRA
+                F3_SRL_SRA_LHU_BGE_DIVU: begin
+                    if (alu_funct7 == F7_ROT)
+                        alu_inst_type = INST_ROR;  // RORI
+                    else if (alu_funct7 == F7_ORCB && alu_rs2 == 5'b00111)
+                        alu_inst_type = INST_ORCB; // ORC.B
+                    else if (alu_funct7 == F7_REV8 && alu_rs2 == 5'b11000)
+                        alu_inst_type = INST_REV8; // REV8
+                    else
+                        alu_inst_type = alu_funct7[5] ? INST_SRA : INST_SRL; // SRLI or SRAI
+                end
                 F3_OR_BLTU_REM: alu_inst_type = INST_OR; // ORI
                 F3_AND_BGEU_REMU: alu_inst_type = INST_AND; // ANDI
-                default: alu_inst_type = 5'bxxxxx; // Invalid
+                default: alu_inst_type = 6'bxxxxxx; // Invalid
+            endcase
+        end
+        CUSTOM0_INST: begin
+            if (alu_funct7 == F7_SIMD_BYTE) begin
+                case(alu_funct3)
+                    3'b000: alu_inst_type = INST_PADDUSB;  // PADDUSB
+                    3'b001: alu_inst_type = INST_PSUBUSB;  // PSUBUSB
+                    3'b010: alu_inst_type = INST_PCMPEQB;  // PCMPEQB
+                    3'b011: alu_inst_type = INST_PCMPLTUB; // PCMPLTUB
+                    3'b100: alu_inst_type = INST_PMINUB;   // PMINUB
+                    3'b101: alu_inst_type = INST_PMAXUB;   // PMAXUB
+                    3'b110: alu_inst_type = INST_PSELNZB;  // PSELNZB
+                    3'b111: alu_inst_type = INST_PSHUFB;   // PSHUFB
+                endcase
+            end else if (alu_funct7 == F7_SIMD_COLOR) begin
+                case(alu_funct3)
+                    3'b000: alu_inst_type = INST_PAVG332;  // PAVG332
+                    3'b001: alu_inst_type = INST_PBLD332;  // PBLD332
+                    3'b010: alu_inst_type = INST_PADDS332; // PADDS332
+                    3'b011: alu_inst_type = INST_PSUBS332; // PSUBS332
+                    default: alu_inst_type = 6'bxxxxxx;   // Invalid
+                endcase
+            end else begin
+                alu_inst_type = 6'bxxxxxx; // Invalid
+            end
+        end
+        CUSTOM1_INST: begin
+            case(alu_funct3)
+                3'b000: alu_inst_type = INST_PSHUFB; // PSHUFBI (selectors in imm[7:0])
+                default: alu_inst_type = 6'bxxxxxx;  // Invalid
             endcase
         end
         I_LOAD_INST: alu_inst_type = INST_ADD; // Load uses ADD for address calculation
         S_INST: alu_inst_type = INST_ADD; // Store uses ADD for address calculation
+        AMO_INST: alu_inst_type = INST_ADD; // LR/SC/AMO address is rs1 + 0
         B_INST: begin
             case(alu_funct3)
                 F3_ADD_SUB_LB_JALR_SB_BEQ_MUL: alu_inst_type = INST_BEQ; // BEQ
@@ -130,14 +276,14 @@ always @(*) begin
                 F3_OR_BLTU_REM: alu_inst_type = INST_BLTU; // BLTU
                 F3_SRL_SRA_LHU_BGE_DIVU: alu_inst_type = INST_BGE; // BGE
                 F3_AND_BGEU_REMU: alu_inst_type = INST_BGEU; // BGEU
-                default: alu_inst_type = 5'bxxxxx; // Invalid
+                default: alu_inst_type = 6'bxxxxxx; // Invalid
             endcase
         end
         JALR_INST: alu_inst_type = INST_ADD; // JALR uses ADD
         JAL_INST: alu_inst_type = INST_ADD; // JAL uses ADD
         LUI_INST: alu_inst_type = INST_ADD; // LUI uses ADD
         AUIPC_INST: alu_inst_type = INST_ADD; // AUIPC uses ADD
-        default: alu_inst_type = 5'bxxxxx; // Invalid
+        default: alu_inst_type = 6'bxxxxxx; // Invalid
     endcase
 
 end
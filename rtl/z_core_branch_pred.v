@@ -36,6 +36,7 @@ module z_core_branch_pred #(
     input [ADDR_WIDTH-1:0] inst_addr_rd,
 
     output wire branch_taken_pred,
+    output wire branch_hit,          // inst_addr_rd has an entry in the table
     output wire [ADDR_WIDTH-1:0] branch_target_pred
 );
 
@@ -49,6 +50,7 @@ reg [1:0] next_state;
 reg [ADDR_WIDTH-1:0] branch_target_buffer [TABLE_DEPTH-1:0]; // Contains target address.
 reg [BRANCH_TABLE_TAG_WIDTH-1:0] branch_table_tag [TABLE_DEPTH-1:0];
 reg [1:0] branch_history_table [TABLE_DEPTH-1:0]; // Contains predicted branch bits (current_state)
+reg [TABLE_DEPTH-1:0] branch_valid;                 // Entry trained since reset
 
 wire [BRANCH_TABLE_TAG_WIDTH-1:0] tag_wr = inst_addr_wr[ADDR_WIDTH-1:ADDR_WIDTH-BRANCH_TABLE_TAG_WIDTH];
 wire [BRANCH_TARGET_BUFF_ADDR_WIDTH-1:0] addr_wr = inst_addr_wr[BRANCH_TARGET_BUFF_ADDR_WIDTH+1:2];
@@ -68,6 +70,7 @@ end
 
 always @(posedge clk) begin
     if(~rstn) begin
+        branch_valid <= {TABLE_DEPTH{1'b0}};
         for (j=0; j < TABLE_DEPTH; j=j+1) begin
             branch_history_table[j] <= 2'b01; // Start at Weak Not Taken
             branch_target_buffer[j] <= {ADDR_WIDTH{1'b0}};
@@ -77,10 +80,14 @@ always @(posedge clk) begin
         branch_target_buffer[addr_wr] <= branch_target_wr;
         branch_history_table[addr_wr] <= next_state;
         branch_table_tag[addr_wr] <= tag_wr;
+        branch_valid[addr_wr] <= 1'b1;
     end
 end
 
-assign branch_taken_pred = branch_history_table[addr_rd][1] && (tag_rd == branch_table_tag[addr_rd]);
+// Untrained entries must miss: reset tags are 0 and would otherwise
+// match every PC below 0x80, bypassing the static fallback
+assign branch_hit = branch_valid[addr_rd] && (tag_rd == branch_table_tag[addr_rd]);
+assign branch_taken_pred = branch_history_table[addr_rd][1] && branch_hit;
 assign branch_target_pred = branch_target_buffer[addr_rd];
 
 endmodule
\ No newline at end of file
@@ -24,17 +24,22 @@ SOFTWARE.
 
 // ****************************************************
 //                 Z-Core Control Unit
-//     5-Stage Pipelined RISC-V RV32IMZicsr Processor
+//     5-Stage Pipelined RISC-V RV32IMAZicsr Processor
 // ****************************************************
 
 module z_core_control_u #(
     parameter DATA_WIDTH = 32,
     parameter ADDR_WIDTH = 32,
     parameter STRB_WIDTH = (DATA_WIDTH/8),
-    parameter CACHE_DEPTH = 256
+    parameter CACHE_DEPTH = 256,
+    parameter DUAL_ISSUE = 0,    // 1: issue ALU pairs from the I-cache (see z_core_pair_check)
+    parameter LOOP_BUF = 1,      // 1: replay short loops from z_core_loop_buf
+    parameter HART_ID = 0,       // mhartid
+    parameter SHADOW_REGS = 0    // 1: shadow bank of the caller-saved registers for interrupts
 )(
     input  wire                   clk,
     input  wire                   rstn,
+    input  wire [31:0]            reset_pc,  // PC after reset (secondary harts: HART_BOOT)
 
     // AXI-Lite Master Interface
     output wire [ADDR_WIDTH-1:0]  m_axil_awaddr,
@@ -60,7 +65,26 @@ module z_core_control_u #(
     // External Interrupt Inputs
     input  wire                   meip,    // Machine External Interrupt Pending
     input  wire                   mtip,    // Machine Timer Interrupt Pending
-    input  wire                   msip     // Machine Software Interrupt Pending
+    input  wire                   msip,    // Machine Software Interrupt Pending
+
+    // Exclusive Access (A extension, see axil_excl_monitor)
+    output wire                   excl_rd,   // Data read takes a reservation (LR, AMO)
+    output wire                   excl_wr,   // Data write needs the reservation (SC, AMO)
+    input  wire                   excl_fail, // The last excl_wr found none (write dropped)
+
+    // Commit Trace ([0] = lane 0, [1] = lane 1; for simulation harnesses)
+    output wire [1:0]             trace_valid,     // Instruction retired this cycle
+    output wire [63:0]            trace_pc,
+    output wire [63:0]            trace_insn,
+    output wire [9:0]             trace_rd,
+    output wire [1:0]             trace_rd_we,
+    output wire [63:0]            trace_rd_data,
+    output wire                   trace_irq,       // Interrupt taken this cycle
+    output wire [31:0]            trace_irq_epc,   //   mepc it saves
+    output wire [31:0]            trace_irq_cause, //   mcause it saves
+
+    // Stall Attribution (one-hot, see STALL ATTRIBUTION below)
+    output wire [5:0]             stall_cause
 );
 
 // **************************************************
@@ -77,10 +101,28 @@ localparam JAL_INST    = 7'b1101111;
 localparam LUI_INST    = 7'b0110111;
 localparam AUIPC_INST  = 7'b0010111;
 
+// Custom Instructions (Packed-SIMD)
+localparam CUSTOM0_INST = 7'b0001011;  // R-type
+localparam CUSTOM1_INST = 7'b0101011;  // I-type
+
 // System Instructions
 localparam SYSTEM_INST = 7'b1110011;  // ECALL, EBREAK
 localparam FENCE_INST  = 7'b0001111;  // FENCE
 
+// Atomic Instructions (A extension, funct5 in inst[31:27])
+localparam AMO_INST    = 7'b0101111;
+localparam AMO_ADD     = 5'b00000;
+localparam AMO_SWAP    = 5'b00001;
+localparam AMO_LR      = 5'b00010;
+localparam AMO_SC      = 5'b00011;
+localparam AMO_XOR     = 5'b00100;
+localparam AMO_OR      = 5'b01000;
+localparam AMO_AND     = 5'b01100;
+localparam AMO_MIN     = 5'b10000;
+localparam AMO_MAX     = 5'b10100;
+localparam AMO_MINU    = 5'b11000;
+localparam AMO_MAXU    = 5'b11100;
+
 // **************************************************
 //              AXI-Lite Master Interface
 // **************************************************
@@ -89,6 +131,8 @@ reg  [ADDR_WIDTH-1:0] mem_addr;
 wire [DATA_WIDTH-1:0] mem_rdata;
 wire                  mem_ready;
 wire                  mem_busy;
+wire                  mem_done;    // Load/store complete (mem_ready of its last transaction)
+wire                  mem_split_step;  // First half of a split misaligned access complete
 
 // mem_addr is reg (defined at top), driven by arbiter
 reg                   mem_wen_comb;
@@ -114,6 +158,7 @@ axil_master #(
     .mem_wstrb(mem_wstrb_r),
     .mem_rdata(mem_rdata),
     .mem_ready(mem_ready),
+    .mem_err(),
     .mem_busy(mem_busy),
     .m_axil_awaddr(m_axil_awaddr),
     .m_axil_awprot(m_axil_awprot),
@@ -140,7 +185,6 @@ axil_master #(
 //                 Program Counter
 // **************************************************
 
-localparam PC_INIT = 32'd0;
 reg [31:0] PC;
 
 
@@ -172,6 +216,12 @@ reg [31:0] if_id_ir;
 reg        if_id_valid;
 reg        if_id_branch_taken_pred;
 reg [31:0] if_id_branch_target_pred;
+reg        if_id_from_lb;    // Supplied by the loop buffer
+reg [15:0] if_id_lb_iter;    // ... in this loop iteration
+
+// --- IF/ID Lane 1 (dual-issue, instruction at if_id_pc + 4) ---
+reg [31:0] if_id1_ir;
+reg        if_id1_valid;
 
 // --- Skid Buffer for Fetch ---
 reg [31:0] fetch_buffer_ir;
@@ -186,15 +236,18 @@ reg [31:0] id_ex_imm;
 reg [4:0]  id_ex_rd;
 reg [4:0]  id_ex_rs1_addr;
 reg [4:0]  id_ex_rs2_addr;
-reg [4:0]  id_ex_alu_op;
+reg [5:0]  id_ex_alu_op;
 reg [2:0]  id_ex_funct3;
 reg        id_ex_is_load, id_ex_is_store, id_ex_is_branch;
+reg        id_ex_is_amo;     // LR/SC/AMO (funct5 in id_ex_ir[31:27])
 reg        id_ex_is_jal, id_ex_is_jalr, id_ex_is_lui, id_ex_is_auipc, id_ex_is_div;
 reg        id_ex_is_i_alu;
 reg        id_ex_reg_write;
 reg        id_ex_valid;
 reg        id_ex_branch_taken_pred;
 reg [31:0] id_ex_branch_target_pred;
+reg        id_ex_from_lb;
+reg [15:0] id_ex_lb_iter;
 
 // --- ID/EX CSR Pipeline Fields (Zicsr) ---
 reg        id_ex_is_csr;
@@ -208,20 +261,57 @@ reg        id_ex_is_ebreak;
 reg        id_ex_is_illegal;
 reg [31:0] id_ex_ir;         // Raw instruction (for mtval on illegal insn)
 
+// --- ID/EX Lane 1 (ALU only) ---
+reg [31:0] id_ex1_pc;
+reg [31:0] id_ex1_rs1_data;
+reg [31:0] id_ex1_rs2_data;
+reg [31:0] id_ex1_imm;
+reg [4:0]  id_ex1_rd;
+reg [4:0]  id_ex1_rs1_addr;
+reg [4:0]  id_ex1_rs2_addr;
+reg [5:0]  id_ex1_alu_op;
+reg        id_ex1_is_i_alu, id_ex1_is_lui, id_ex1_is_auipc;
+reg        id_ex1_reg_write;
+reg        id_ex1_valid;
+reg [31:0] id_ex1_ir;
+
 // --- EX/MEM Pipeline Register ---
 reg [31:0] ex_mem_alu_result;
 reg [31:0] ex_mem_rs2_data;
 reg [4:0]  ex_mem_rd;
 reg [2:0]  ex_mem_funct3;
 reg        ex_mem_is_load, ex_mem_is_store;
+reg        ex_mem_is_amo;
+reg [4:0]  ex_mem_amo_op;
 reg        ex_mem_reg_write;
 reg        ex_mem_valid;
+reg [31:0] ex_mem_pc;        // Trace only
+reg [31:0] ex_mem_ir;        // Trace only
+
+// --- EX/MEM Lane 1 ---
+reg [31:0] ex_mem1_result;
+reg [4:0]  ex_mem1_rd;
+reg        ex_mem1_reg_write;
+reg        ex_mem1_valid;
+reg [31:0] ex_mem1_pc;       // Trace only
+reg [31:0] ex_mem1_ir;       // Trace only
 
 // --- MEM/WB Pipeline Register ---
 reg [31:0] mem_wb_result;
 reg [4:0]  mem_wb_rd;
 reg        mem_wb_reg_write;
 reg        mem_wb_valid;
+reg        mem_wb_commit;    // Trace only: retired, including stores
+reg [31:0] mem_wb_pc;        // Trace only
+reg [31:0] mem_wb_ir;        // Trace only
+
+// --- MEM/WB Lane 1 ---
+reg [31:0] mem_wb1_result;
+reg [4:0]  mem_wb1_rd;
+reg        mem_wb1_reg_write;
+reg        mem_wb1_valid;
+reg [31:0] mem_wb1_pc;       // Trace only
+reg [31:0] mem_wb1_ir;       // Trace only
 
 // ##################################################
 //       INSTRUCTION CACHE (uses z_core_instr_cache)
@@ -229,13 +319,43 @@ reg        mem_wb_valid;
 
 wire [31:0] instr_cache_address;
 reg [31:0] instr_cache_data_in;
+reg [33:0] instr_cache_pd_in;
 reg instr_cache_wen;
+reg instr_cache_wlock;
+reg instr_cache_inval;
+reg instr_cache_unlock;
+
+// Preload engine (mzicctl.PRELOAD): reads words into the cache on the
+// fetch path while fetch keeps running from hits. The address of the
+// read on the bus is held in fetch_pc, as for a miss.
+reg        pre_active;   // Words left to load
+reg        pre_wait;     // Preload read in flight
+reg        pre_lock;     // Lock the lines it fills
+reg [31:0] pre_addr;
+reg [15:0] pre_left;
 
 wire [31:0] instr_cache_data_out;
 wire instr_cache_valid;
 wire instr_cache_cache_hit;
 wire instr_cache_cache_miss;
 
+wire [31:0] instr_cache_data_out2;
+wire instr_cache_cache_hit2;
+wire [33:0] instr_cache_pd_out;
+
+// Predecode of the word returned by memory (stored with the cache line)
+wire        fill_pd_jal;
+wire        fill_pd_bwd_branch;
+wire [31:0] fill_pd_target;
+
+z_core_predecode fill_predecode (
+    .inst(mem_rdata),
+    .pc(fetch_pc),
+    .is_jal(fill_pd_jal),
+    .is_bwd_branch(fill_pd_bwd_branch),
+    .target(fill_pd_target)
+);
+
 z_core_instr_cache#(
     .DATA_WIDTH(DATA_WIDTH),
     .ADDR_WIDTH(ADDR_WIDTH),
@@ -244,13 +364,34 @@ z_core_instr_cache#(
     .clk(clk),
     .rstn(rstn),
     .wen(instr_cache_wen), 
+    .wlock(instr_cache_wlock),
+    .inval(instr_cache_inval),
+    .unlock(instr_cache_unlock),
     .addr_rd(instr_cache_address),
     .addr_wr(fetch_pc),
     .data_in(instr_cache_data_in),
     .data_out(instr_cache_data_out),
+    .pd_in(instr_cache_pd_in),
+    .pd_out(instr_cache_pd_out),
     .valid(instr_cache_valid),
     .cache_hit(instr_cache_cache_hit),
-    .cache_miss(instr_cache_cache_miss)
+    .cache_miss(instr_cache_cache_miss),
+    .addr_rd2(instr_cache_address + 32'd4),
+    .data_out2(instr_cache_data_out2),
+    .cache_hit2(instr_cache_cache_hit2)
+);
+
+// Fetch words: from the loop buffer when it holds PC, else the I-cache
+wire [31:0] fetch_inst0;
+wire [31:0] fetch_inst1;
+
+// Dual-issue: can the word at PC + 4 issue alongside the word at PC?
+wire pair_can_issue;
+
+z_core_pair_check pair_check (
+    .inst0(fetch_inst0),
+    .inst1(fetch_inst1),
+    .can_pair(pair_can_issue)
 );
 
 // ##################################################
@@ -286,12 +427,13 @@ z_core_decoder decoder (
 //              ALU CONTROL (uses z_core_alu_ctrl)
 // ##################################################
 
-wire [4:0] dec_alu_op;
+wire [5:0] dec_alu_op;
 
 z_core_alu_ctrl alu_ctrl (
     .alu_op(dec_op),
     .alu_funct3(dec_funct3),
     .alu_funct7(dec_funct7),
+    .alu_rs2(dec_rs2),
     .alu_inst_type(dec_alu_op)
 );
 
@@ -304,51 +446,139 @@ wire dec_is_jal    = (dec_op == JAL_INST);
 wire dec_is_jalr   = (dec_op == JALR_INST);
 wire dec_is_lui    = (dec_op == LUI_INST);
 wire dec_is_auipc  = (dec_op == AUIPC_INST);
-wire dec_is_r_type = (dec_op == R_INST);
-wire dec_is_i_alu  = (dec_op == I_INST);
-wire dec_is_div    = (dec_op == R_INST) & (dec_alu_op >= 5'd20) & (dec_alu_op <= 5'd23);
+wire dec_is_simd_r = (dec_op == CUSTOM0_INST);  // Packed-SIMD, register operands
+wire dec_is_simd_i = (dec_op == CUSTOM1_INST);  // Packed-SIMD, immediate operand
+wire dec_is_r_type = (dec_op == R_INST) | dec_is_simd_r;
+wire dec_is_i_alu  = (dec_op == I_INST) | dec_is_simd_i;
+wire dec_is_div    = (dec_op == R_INST) & (dec_alu_op >= 6'd20) & (dec_alu_op <= 6'd23);
+
+// A extension: word-sized LR/SC/AMOs only (funct3 = 010)
+wire [4:0] dec_amo_op = if_id_ir[31:27];
+wire dec_is_amo    = (dec_op == AMO_INST) && (dec_funct3 == 3'b010) &&
+                     (dec_amo_op == AMO_ADD || dec_amo_op == AMO_SWAP || dec_amo_op == AMO_LR ||
+                      dec_amo_op == AMO_SC  || dec_amo_op == AMO_XOR  || dec_amo_op == AMO_OR ||
+                      dec_amo_op == AMO_AND || dec_amo_op == AMO_MIN  || dec_amo_op == AMO_MAX ||
+                      dec_amo_op == AMO_MINU || dec_amo_op == AMO_MAXU);
 
 // Zicsr / System instruction detection
 wire dec_is_csr    = (dec_op == SYSTEM_INST) && (dec_funct3 != 3'b000);
 wire dec_is_mret   = (dec_op == SYSTEM_INST) && (dec_funct3 == 3'b000) && (if_id_ir[31:20] == 12'h302);
+wire dec_is_wfi    = (dec_op == SYSTEM_INST) && (dec_funct3 == 3'b000) && (if_id_ir[31:20] == 12'h105);
 
 // Illegal: opcode doesn't match any known type (0x00000000 is treated as NOP)
 wire dec_is_fence  = (dec_op == FENCE_INST);
 wire dec_opcode_valid = dec_is_load | dec_is_store | dec_is_branch |
                         dec_is_jal | dec_is_jalr | dec_is_lui | dec_is_auipc |
                         dec_is_r_type | dec_is_i_alu | dec_is_csr |
-                        dec_is_mret | dec_is_ecall | dec_is_ebreak | dec_is_fence;
+                        dec_is_mret | dec_is_ecall | dec_is_ebreak | dec_is_fence |
+                        dec_is_wfi | dec_is_amo;
 wire dec_is_illegal = if_id_valid && !dec_opcode_valid && (if_id_ir != 32'h0);
 
 wire dec_reg_write = dec_is_r_type | dec_is_i_alu | dec_is_load | 
                      dec_is_jal | dec_is_jalr | dec_is_lui | dec_is_auipc |
-                     dec_is_csr;
+                     dec_is_csr | dec_is_amo;
 
 // Immediate mux
 wire [31:0] dec_imm = dec_is_i_alu | dec_is_load | dec_is_jalr ? dec_Iimm :
                       dec_is_store  ? dec_Simm :
                       dec_is_branch ? dec_Bimm :
                       dec_is_jal    ? dec_Jimm :
+                      dec_is_amo    ? 32'b0 :
                       dec_Uimm;
 
 // ##################################################
-//              REGISTER FILE (uses z_core_reg_file)
+//      LANE 1 DECODE (dual-issue, ALU ops only)
 // ##################################################
 
-wire [31:0] rf_rs1_data, rf_rs2_data;
+wire [6:0]  dec1_op;
+wire [4:0]  dec1_rs1, dec1_rs2, dec1_rd;
+wire [31:0] dec1_Iimm, dec1_Uimm;
+wire [2:0]  dec1_funct3;
+wire [6:0]  dec1_funct7;
+wire [5:0]  dec1_alu_op;
+
+z_core_decoder decoder1 (
+    .inst(if_id1_ir),
+    .op(dec1_op),
+    .rs1(dec1_rs1),
+    .rs2(dec1_rs2),
+    .rd(dec1_rd),
+    .Iimm(dec1_Iimm),
+    .Simm(),
+    .Uimm(dec1_Uimm),
+    .Bimm(),
+    .Jimm(),
+    .funct3(dec1_funct3),
+    .funct7(dec1_funct7),
+    .csr_addr(),
+    .csr_zimm()
+);
 
-z_core_reg_file reg_file (
-    .clk(clk),
-    .reset(~rstn),
-    .rd(mem_wb_rd),
-    .rd_in(mem_wb_result),
-    .write_enable(mem_wb_valid && mem_wb_reg_write && mem_wb_rd != 5'b0),
-    .rs1(dec_rs1),
-    .rs2(dec_rs2),
-    .rs1_out(rf_rs1_data),
-    .rs2_out(rf_rs2_data)
+z_core_alu_ctrl alu_ctrl1 (
+    .alu_op(dec1_op),
+    .alu_funct3(dec1_funct3),
+    .alu_funct7(dec1_funct7),
+    .alu_rs2(dec1_rs2),
+    .alu_inst_type(dec1_alu_op)
 );
 
+wire dec1_is_lui    = (dec1_op == LUI_INST);
+wire dec1_is_auipc  = (dec1_op == AUIPC_INST);
+wire dec1_is_r_type = (dec1_op == R_INST) | (dec1_op == CUSTOM0_INST);
+wire dec1_is_i_alu  = (dec1_op == I_INST) | (dec1_op == CUSTOM1_INST);
+wire [31:0] dec1_imm = dec1_is_i_alu ? dec1_Iimm : dec1_Uimm;
+
+// ##################################################
+//              REGISTER FILE (uses z_core_reg_file)
+// ##################################################
+
+wire [31:0] rf_rs1_data, rf_rs2_data;
+wire [31:0] rf1_rs1_data, rf1_rs2_data;
+reg         rf_bank;          // Register bank in use (follows mzcfg.BANK, see BANK SWITCH)
+
+generate
+if (DUAL_ISSUE) begin : g_rf_dual
+    z_core_reg_file_2w #(
+        .SHADOW(SHADOW_REGS)
+    ) reg_file (
+        .clk(clk),
+        .reset(~rstn),
+        .bank(rf_bank),
+        .rd0(mem_wb_rd),
+        .rd0_in(mem_wb_result),
+        .write_enable0(mem_wb_valid && mem_wb_reg_write && mem_wb_rd != 5'b0),
+        .rd1(mem_wb1_rd),
+        .rd1_in(mem_wb1_result),
+        .write_enable1(mem_wb1_valid && mem_wb1_reg_write && mem_wb1_rd != 5'b0),
+        .rs1(dec_rs1),
+        .rs2(dec_rs2),
+        .rs3(dec1_rs1),
+        .rs4(dec1_rs2),
+        .rs1_out(rf_rs1_data),
+        .rs2_out(rf_rs2_data),
+        .rs3_out(rf1_rs1_data),
+        .rs4_out(rf1_rs2_data)
+    );
+end else begin : g_rf_single
+    z_core_reg_file #(
+        .SHADOW(SHADOW_REGS)
+    ) reg_file (
+        .clk(clk),
+        .reset(~rstn),
+        .bank(rf_bank),
+        .rd(mem_wb_rd),
+        .rd_in(mem_wb_result),
+        .write_enable(mem_wb_valid && mem_wb_reg_write && mem_wb_rd != 5'b0),
+        .rs1(dec_rs1),
+        .rs2(dec_rs2),
+        .rs1_out(rf_rs1_data),
+        .rs2_out(rf_rs2_data)
+    );
+    assign rf1_rs1_data = 32'b0;
+    assign rf1_rs2_data = 32'b0;
+end
+endgenerate
+
 wire [31:0] fwd_rs1_data;
 wire [31:0] fwd_rs2_data;
 // ##################################################
@@ -360,7 +590,7 @@ wire [31:0] alu_in1 = id_ex_is_auipc ? id_ex_pc :
                       id_ex_is_lui   ? 32'b0 : 
                       fwd_rs1_data;
 
-wire [31:0] alu_in2 = (id_ex_is_load | id_ex_is_store | id_ex_is_lui | 
+wire [31:0] alu_in2 = (id_ex_is_load | id_ex_is_store | id_ex_is_amo | id_ex_is_lui | 
                        id_ex_is_auipc | id_ex_is_jal | id_ex_is_jalr | id_ex_is_i_alu) ? id_ex_imm :
                       id_ex_is_branch ? fwd_rs2_data :
                       fwd_rs2_data;  // R-type
@@ -376,6 +606,27 @@ z_core_alu alu (
     .alu_branch(alu_branch)
 );
 
+// Lane 1 ALU (LUI/AUIPC decode to ADD, like lane 0)
+wire [31:0] fwd1_rs1_data;
+wire [31:0] fwd1_rs2_data;
+
+wire [31:0] alu1_in1 = id_ex1_is_auipc ? id_ex1_pc :
+                       id_ex1_is_lui   ? 32'b0 :
+                       fwd1_rs1_data;
+
+wire [31:0] alu1_in2 = (id_ex1_is_i_alu | id_ex1_is_lui | id_ex1_is_auipc) ? id_ex1_imm :
+                       fwd1_rs2_data;
+
+wire [31:0] alu1_out;
+
+z_core_alu alu1 (
+    .alu_in1(alu1_in1),
+    .alu_in2(alu1_in2),
+    .alu_inst_type(id_ex1_alu_op),
+    .alu_out(alu1_out),
+    .alu_branch()
+);
+
 // ##################################################
 //          DIV Unit (uses z_core_div_unit)
 // ##################################################
@@ -417,28 +668,50 @@ z_core_div_unit div_unit (
 //              DATA FORWARDING
 // ##################################################
 
-// Forward from EX/MEM or MEM/WB to resolve RAW hazards
+// Forward from EX/MEM or MEM/WB to resolve RAW hazards.
+// Within a stage, lane 1 is the younger instruction and takes priority.
 assign fwd_rs1_data = 
+    (ex_mem1_valid && ex_mem1_reg_write && ex_mem1_rd == id_ex_rs1_addr && ex_mem1_rd != 5'b0) ? ex_mem1_result :
     (ex_mem_valid && ex_mem_reg_write && ex_mem_rd == id_ex_rs1_addr && ex_mem_rd != 5'b0) ? ex_mem_alu_result :
+    (mem_wb1_valid && mem_wb1_reg_write && mem_wb1_rd == id_ex_rs1_addr && mem_wb1_rd != 5'b0) ? mem_wb1_result :
     (mem_wb_valid && mem_wb_reg_write && mem_wb_rd == id_ex_rs1_addr && mem_wb_rd != 5'b0) ? mem_wb_result :
     id_ex_rs1_data;
 
 assign fwd_rs2_data = 
+    (ex_mem1_valid && ex_mem1_reg_write && ex_mem1_rd == id_ex_rs2_addr && ex_mem1_rd != 5'b0) ? ex_mem1_result :
     (ex_mem_valid && ex_mem_reg_write && ex_mem_rd == id_ex_rs2_addr && ex_mem_rd != 5'b0) ? ex_mem_alu_result :
+    (mem_wb1_valid && mem_wb1_reg_write && mem_wb1_rd == id_ex_rs2_addr && mem_wb1_rd != 5'b0) ? mem_wb1_result :
     (mem_wb_valid && mem_wb_reg_write && mem_wb_rd == id_ex_rs2_addr && mem_wb_rd != 5'b0) ? mem_wb_result :
     id_ex_rs2_data;
 
+assign fwd1_rs1_data = 
+    (ex_mem1_valid && ex_mem1_reg_write && ex_mem1_rd == id_ex1_rs1_addr && ex_mem1_rd != 5'b0) ? ex_mem1_result :
+    (ex_mem_valid && ex_mem_reg_write && ex_mem_rd == id_ex1_rs1_addr && ex_mem_rd != 5'b0) ? ex_mem_alu_result :
+    (mem_wb1_valid && mem_wb1_reg_write && mem_wb1_rd == id_ex1_rs1_addr && mem_wb1_rd != 5'b0) ? mem_wb1_result :
+    (mem_wb_valid && mem_wb_reg_write && mem_wb_rd == id_ex1_rs1_addr && mem_wb_rd != 5'b0) ? mem_wb_result :
+    id_ex1_rs1_data;
+
+assign fwd1_rs2_data = 
+    (ex_mem1_valid && ex_mem1_reg_write && ex_mem1_rd == id_ex1_rs2_addr && ex_mem1_rd != 5'b0) ? ex_mem1_result :
+    (ex_mem_valid && ex_mem_reg_write && ex_mem_rd == id_ex1_rs2_addr && ex_mem_rd != 5'b0) ? ex_mem_alu_result :
+    (mem_wb1_valid && mem_wb1_reg_write && mem_wb1_rd == id_ex1_rs2_addr && mem_wb1_rd != 5'b0) ? mem_wb1_result :
+    (mem_wb_valid && mem_wb_reg_write && mem_wb_rd == id_ex1_rs2_addr && mem_wb_rd != 5'b0) ? mem_wb_result :
+    id_ex1_rs2_data;
+
 // ##################################################
 //              HAZARD DETECTION
 // ##################################################
 
-// Load-use hazard: need to stall one cycle
-wire load_use_hazard = id_ex_valid && id_ex_is_load && if_id_valid &&
+// Load-use hazard: need to stall one cycle (either lane of the IF/ID pair)
+// (LR/SC/AMO results come from the bus like load data)
+wire load_use_hazard = id_ex_valid && (id_ex_is_load || id_ex_is_amo) && if_id_valid &&
     ((id_ex_rd == dec_rs1 && dec_rs1 != 5'b0) ||
-     (id_ex_rd == dec_rs2 && dec_rs2 != 5'b0 && (dec_is_r_type || dec_is_store || dec_is_branch)));
+     (id_ex_rd == dec_rs2 && dec_rs2 != 5'b0 && (dec_is_r_type || dec_is_store || dec_is_branch || dec_is_amo)) ||
+     (if_id1_valid && id_ex_rd == dec1_rs1 && dec1_rs1 != 5'b0 && !dec1_is_lui && !dec1_is_auipc) ||
+     (if_id1_valid && id_ex_rd == dec1_rs2 && dec1_rs2 != 5'b0 && dec1_is_r_type));
 
 // Memory operation in progress - stall whole pipeline  
-wire mem_stall = mem_op_pending && !mem_ready;
+wire mem_stall = mem_op_pending && !mem_done;
 
 // System Instruction Detection
 wire dec_is_ecall  = (dec_op == SYSTEM_INST) && (dec_funct3 == 3'b000) && (if_id_ir[31:20] == 12'h000);
@@ -452,15 +725,25 @@ wire dec_is_ebreak = (dec_op == SYSTEM_INST) && (dec_funct3 == 3'b000) && (if_id
 wire misalign_branch = id_ex_valid && id_ex_is_branch && alu_branch && (branch_target[1:0] != 2'b00);
 wire misalign_jump   = id_ex_valid && (id_ex_is_jal || id_ex_is_jalr) && (jump_target[1:0] != 2'b00);
 
+// Misaligned loads and stores are split in the LSU (MEM stage) unless
+// mzcfg.MISALIGN_TRAP is set
+wire csr_misalign_trap;
+
+// Atomics are never split: a misaligned LR traps as a load, SC/AMO as a store
+wire misalign_amo = id_ex_valid && id_ex_is_amo && (alu_out[1:0] != 2'b00);
+wire id_ex_is_lr  = id_ex_is_amo && (id_ex_ir[31:27] == AMO_LR);
+
 // Misaligned load (cause 4): LH/LHU at odd addr, LW at non-4B-aligned addr
-wire misalign_load = id_ex_valid && id_ex_is_load &&
+wire misalign_load = (id_ex_valid && id_ex_is_load && csr_misalign_trap &&
     ((id_ex_funct3[1:0] == 2'b01 && alu_out[0]  != 1'b0) ||      // LH/LHU
-     (id_ex_funct3[1:0] == 2'b10 && alu_out[1:0] != 2'b00));     // LW
+     (id_ex_funct3[1:0] == 2'b10 && alu_out[1:0] != 2'b00))) ||  // LW
+    (misalign_amo && id_ex_is_lr);                               // LR.W
 
 // Misaligned store (cause 6): SH at odd addr, SW at non-4B-aligned addr
-wire misalign_store = id_ex_valid && id_ex_is_store &&
+wire misalign_store = (id_ex_valid && id_ex_is_store && csr_misalign_trap &&
     ((id_ex_funct3[1:0] == 2'b01 && alu_out[0]  != 1'b0) ||      // SH
-     (id_ex_funct3[1:0] == 2'b10 && alu_out[1:0] != 2'b00));     // SW
+     (id_ex_funct3[1:0] == 2'b10 && alu_out[1:0] != 2'b00))) ||  // SW
+    (misalign_amo && !id_ex_is_lr);                              // SC.W / AMO*.W
 
 // ##################################################
 //     CSR FILE INSTANTIATION (Zicsr Extension)
@@ -492,6 +775,8 @@ reg  [31:0] trap_mepc_r;
 reg  [31:0] trap_mcause_r;
 reg  [31:0] trap_mtval_r;
 wire mret_in_ex = id_ex_valid && id_ex_is_mret;
+wire mret_chain;              // MRET goes straight to the next interrupt (tail-chaining)
+reg  [31:0] irq_cause;
 
 wire        csr_mstatus_mie;
 wire [31:0] csr_mtvec;
@@ -500,9 +785,19 @@ wire        csr_irq_pending;
 wire        csr_mie_meie;
 wire        csr_mie_mtie;
 wire        csr_mie_msie;
+wire [1:0]  lb_fetch_count;   // Instructions supplied by the loop buffer (fetch section)
+wire        icache_cmd;
+wire [31:0] icache_cmd_data;
+wire [31:0] icache_addr;
+wire        csr_irq_waiting;
+wire        csr_irq_wake;
+wire        wfi_hold;         // WFI asleep in ID
+wire        csr_reg_bank;
 
 z_core_csr_file #(
-    .DATA_WIDTH(DATA_WIDTH)
+    .DATA_WIDTH(DATA_WIDTH),
+    .HART_ID(HART_ID),
+    .SHADOW_REGS(SHADOW_REGS)
 ) u_csr_file (
     .clk(clk),
     .rstn(rstn),
@@ -514,18 +809,33 @@ z_core_csr_file #(
     .trap_mepc(trap_mepc_r),
     .trap_mcause(trap_mcause_r),
     .trap_mtval(trap_mtval_r),
-    .mret_exec(mret_in_ex),
+    .mret_exec(mret_in_ex && !mret_chain),
+    .chain_exec(mret_chain),
+    .chain_mcause(irq_cause),
     .meip(meip),
     .mtip(mtip),
     .msip(msip),
     .instret_pulse(mem_wb_valid),
+    .instret_pulse_lane1(mem_wb1_valid),
+    .stall_events(stall_cause),
+    .misalign_split(mem_split_step),
+    .loop_buf_fetch(lb_fetch_count),
+    .wfi_sleep(wfi_hold && !ex_stall),
     .mstatus_mie(csr_mstatus_mie),
     .mtvec_out(csr_mtvec),
     .mepc_out(csr_mepc),
     .irq_pending(csr_irq_pending),
     .mie_meie_out(csr_mie_meie),
     .mie_mtie_out(csr_mie_mtie),
-    .mie_msie_out(csr_mie_msie)
+    .mie_msie_out(csr_mie_msie),
+    .misalign_trap_out(csr_misalign_trap),
+    .irq_waiting(csr_irq_waiting),
+    .irq_wake(csr_irq_wake),
+    .reg_bank(csr_reg_bank),
+    .icache_cmd(icache_cmd),
+    .icache_cmd_data(icache_cmd_data),
+    .icache_addr_out(icache_addr),
+    .icache_status({pre_left, 15'b0, pre_active})
 );
 
 
@@ -536,12 +846,46 @@ z_core_csr_file #(
 wire div_stall = id_ex_valid && id_ex_is_div && !div_complete;
 
 wire ex_stall = mem_stall || 
-                (ex_mem_valid && (ex_mem_is_load || ex_mem_is_store) && 
+                (ex_mem_valid && (ex_mem_is_load || ex_mem_is_store || ex_mem_is_amo) && 
                  (!mem_op_pending || mem_busy)) ||
                 div_stall;
 
+// ##################################################
+//     BANK SWITCH & TAIL-CHAINING (SHADOW_REGS)
+// ##################################################
+//
+// The CSR file flips mzcfg.BANK on interrupt entry and MRET. The
+// register file follows once every older instruction has written
+// back, so no result lands in (or forwards into) the wrong bank. ID/EX
+// takes bubbles meanwhile, like a load-use stall.
+
+wire bank_hold = SHADOW_REGS && (rf_bank != csr_reg_bank);
+wire bank_drained = !id_ex_valid && !id_ex1_valid && !ex_mem_valid && !ex_mem1_valid &&
+                    !mem_wb_valid && !mem_wb1_valid;
+
+always @(posedge clk) begin
+    if (~rstn)
+        rf_bank <= 1'b0;
+    else if (bank_hold && bank_drained)
+        rf_bank <= csr_reg_bank;
+end
+
+// An MRET that would be interrupted at once vectors to mtvec instead
+// of refetching mepc: mcause takes the new cause, mepc is kept. Not
+// while a load/store is in flight, as it may be the write that clears
+// the interrupt source.
+assign mret_chain = mret_in_ex && csr_irq_waiting && !trap_enter_r && !ex_stall &&
+                    !(ex_mem_valid && (ex_mem_is_load || ex_mem_is_store || ex_mem_is_amo));
+
+// WFI waits in ID until an enabled interrupt is pending (with MIE
+// clear it then just continues). Fetch stops once the fetch buffer is
+// full, so the bus is left to the older instructions and the other
+// masters. WFI retires as a NOP, so an interrupt taken on wake-up
+// saves the next PC in mepc.
+assign wfi_hold = if_id_valid && dec_is_wfi && !csr_irq_wake;
+
 // Stall the pipeline (note: fetch_wait does NOT stall EX/MEM/WB stages)
-wire stall = load_use_hazard || ex_stall;
+wire stall = load_use_hazard || ex_stall || bank_hold || wfi_hold;
 
 // ##################################################
 //              BRANCH/JUMP CONTROL
@@ -551,6 +895,7 @@ wire branch_taken = id_ex_valid && id_ex_is_branch && alu_branch;
 wire is_jump   = id_ex_valid && (id_ex_is_jal || id_ex_is_jalr);
 
 wire branch_taken_pred;
+wire branch_hit;
 wire id_ex_branch_taken_pred_valid = id_ex_branch_taken_pred & id_ex_valid;
 wire [31:0] branch_target_pred;
 wire is_branch = id_ex_is_branch & id_ex_valid;
@@ -567,6 +912,7 @@ z_core_branch_pred branch_predictor(
     .branch_target_wr(branch_predictor_target),
     .inst_addr_rd(PC),
     .branch_taken_pred(branch_taken_pred),
+    .branch_hit(branch_hit),
     .branch_target_pred(branch_target_pred)
 );
 
@@ -589,79 +935,263 @@ wire [31:0] branch_target = id_ex_pc + id_ex_imm;
 wire [31:0] jalr_target   = (fwd_rs1_data + id_ex_imm) & ~32'b1;
 wire [31:0] jump_target   = id_ex_is_jalr ? jalr_target : branch_target;
 
+// ##################################################
+//        EARLY BRANCH RESOLUTION (DECODE)
+// ##################################################
+
+// Forwarding for decode stage (into ID/EX)
+wire [31:0] dec_fwd_rs1 = 
+    (ex_mem1_valid && ex_mem1_reg_write && ex_mem1_rd == dec_rs1 && ex_mem1_rd != 5'b0) ? ex_mem1_result :
+    (ex_mem_valid && ex_mem_reg_write && ex_mem_rd == dec_rs1 && ex_mem_rd != 5'b0) ? ex_mem_alu_result :
+    (mem_wb1_valid && mem_wb1_reg_write && mem_wb1_rd == dec_rs1 && mem_wb1_rd != 5'b0) ? mem_wb1_result :
+    (mem_wb_valid && mem_wb_reg_write && mem_wb_rd == dec_rs1 && mem_wb_rd != 5'b0) ? mem_wb_result :
+    rf_rs1_data;
+
+wire [31:0] dec_fwd_rs2 = 
+    (ex_mem1_valid && ex_mem1_reg_write && ex_mem1_rd == dec_rs2 && ex_mem1_rd != 5'b0) ? ex_mem1_result :
+    (ex_mem_valid && ex_mem_reg_write && ex_mem_rd == dec_rs2 && ex_mem_rd != 5'b0) ? ex_mem_alu_result :
+    (mem_wb1_valid && mem_wb1_reg_write && mem_wb1_rd == dec_rs2 && mem_wb1_rd != 5'b0) ? mem_wb1_result :
+    (mem_wb_valid && mem_wb_reg_write && mem_wb_rd == dec_rs2 && mem_wb_rd != 5'b0) ? mem_wb_result :
+    rf_rs2_data;
+
+wire [31:0] dec1_fwd_rs1 = 
+    (ex_mem1_valid && ex_mem1_reg_write && ex_mem1_rd == dec1_rs1 && ex_mem1_rd != 5'b0) ? ex_mem1_result :
+    (ex_mem_valid && ex_mem_reg_write && ex_mem_rd == dec1_rs1 && ex_mem_rd != 5'b0) ? ex_mem_alu_result :
+    (mem_wb1_valid && mem_wb1_reg_write && mem_wb1_rd == dec1_rs1 && mem_wb1_rd != 5'b0) ? mem_wb1_result :
+    (mem_wb_valid && mem_wb_reg_write && mem_wb_rd == dec1_rs1 && mem_wb_rd != 5'b0) ? mem_wb_result :
+    rf1_rs1_data;
+
+wire [31:0] dec1_fwd_rs2 = 
+    (ex_mem1_valid && ex_mem1_reg_write && ex_mem1_rd == dec1_rs2 && ex_mem1_rd != 5'b0) ? ex_mem1_result :
+    (ex_mem_valid && ex_mem_reg_write && ex_mem_rd == dec1_rs2 && ex_mem_rd != 5'b0) ? ex_mem_alu_result :
+    (mem_wb1_valid && mem_wb1_reg_write && mem_wb1_rd == dec1_rs2 && mem_wb1_rd != 5'b0) ? mem_wb1_result :
+    (mem_wb_valid && mem_wb_reg_write && mem_wb_rd == dec1_rs2 && mem_wb_rd != 5'b0) ? mem_wb_result :
+    rf1_rs2_data;
+
+// A branch in IF/ID is resolved here when its operands are final: no
+// older instruction in ID/EX still has to write them and no load in
+// EX/MEM is waiting for data. Otherwise it resolves in EX as before.
+wire id_br_rs1_busy = (dec_rs1 != 5'b0) &&
+    ((id_ex_valid  && id_ex_reg_write  && id_ex_rd  == dec_rs1) ||
+     (id_ex1_valid && id_ex1_reg_write && id_ex1_rd == dec_rs1) ||
+     (ex_mem_valid && (ex_mem_is_load || ex_mem_is_amo) && ex_mem_rd == dec_rs1));
+
+wire id_br_rs2_busy = (dec_rs2 != 5'b0) &&
+    ((id_ex_valid  && id_ex_reg_write  && id_ex_rd  == dec_rs2) ||
+     (id_ex1_valid && id_ex1_reg_write && id_ex1_rd == dec_rs2) ||
+     (ex_mem_valid && (ex_mem_is_load || ex_mem_is_amo) && ex_mem_rd == dec_rs2));
+
+reg id_br_cond;
+always @(*) begin
+    case (dec_funct3)
+        3'b000:  id_br_cond = (dec_fwd_rs1 == dec_fwd_rs2);                   // BEQ
+        3'b001:  id_br_cond = (dec_fwd_rs1 != dec_fwd_rs2);                   // BNE
+        3'b100:  id_br_cond = ($signed(dec_fwd_rs1) <  $signed(dec_fwd_rs2)); // BLT
+        3'b101:  id_br_cond = ($signed(dec_fwd_rs1) >= $signed(dec_fwd_rs2)); // BGE
+        3'b110:  id_br_cond = (dec_fwd_rs1 <  dec_fwd_rs2);                   // BLTU
+        3'b111:  id_br_cond = (dec_fwd_rs1 >= dec_fwd_rs2);                   // BGEU
+        default: id_br_cond = 1'b0;
+    endcase
+end
+
+wire [31:0] id_br_target = if_id_pc + dec_Bimm;
+
+// Misaligned targets are left to EX, which raises the exception
+wire id_br_resolved = if_id_valid && dec_is_branch && !id_br_rs1_busy && !id_br_rs2_busy &&
+                      (id_br_target[1:0] == 2'b00);
+
+wire id_br_mispredict = (id_br_cond != if_id_branch_taken_pred) ||
+                        (id_br_cond && (if_id_branch_target_pred != id_br_target));
+
+// Redirect fetch from ID: only the IF stage is squashed (one bubble)
+wire id_redirect = id_br_resolved && id_br_mispredict && !stall && !flush;
+wire [31:0] id_redirect_pc = id_br_cond ? id_br_target : (if_id_pc + 32'd4);
+
 // ##################################################
 //              PIPELINE STAGE: FETCH
 // ##################################################
 
 // Cache address priority (Read Port): trap > MRET > redirection > normal PC
 assign instr_cache_address = trap_enter_r               ? csr_mtvec :
+                             mret_chain                 ? csr_mtvec :
                              mret_in_ex                 ? csr_mepc :
                              (is_jump && flush)         ? jump_target :
                              (id_ex_branch_taken_pred && flush) ? (id_ex_pc + 4) :
                              (branch_taken && flush)    ? branch_target :
                              PC;
 
+// Loop buffer: short loops are replayed from here, with their branches
+// predicted by trip count instead of the BTB
+localparam LB_DEPTH = 8;
+
+wire        lb_hit_raw;
+wire        lb_hit = (LOOP_BUF != 0) && lb_hit_raw;
+wire [31:0] lb_inst0, lb_inst1;
+wire        lb_hit2;
+wire        lb_pred_taken;
+wire [31:0] lb_pred_target;
+wire [15:0] lb_iter;
+
+// IF takes the word(s) at PC from the I-cache or the loop buffer
+wire fetch_hit      = lb_hit || (instr_cache_valid && instr_cache_cache_hit);
+wire fetch_hit_take = !flush && !id_redirect && !fetch_wait && !stall && !fetch_buffer_valid && fetch_hit;
+
+// Redirects by a mispredicted EX branch (not a trap or MRET) carry its
+// loop-buffer tag
+wire lb_ex_redirect = prediction_flush && !trap_enter_r && !mret_in_ex;
+
+z_core_loop_buf #(
+    .DEPTH(LB_DEPTH),
+    .CNT_WIDTH(16)
+) loop_buf (
+    .clk(clk),
+    .rstn(rstn),
+    .fetch_addr(instr_cache_address),
+    .hit(lb_hit_raw),
+    .inst0(lb_inst0),
+    .inst1(lb_inst1),
+    .hit2(lb_hit2),
+    .pred_taken(lb_pred_taken),
+    .pred_target(lb_pred_target),
+    .iter(lb_iter),
+    .take(fetch_hit_take && lb_hit),
+    .cap_en(fetch_hit_take && !lb_hit),
+    .cap_inst0(instr_cache_data_out),
+    .cap_inst1(instr_cache_data_out2),
+    .cap_hit2(instr_cache_cache_hit2),
+    .br_valid((LOOP_BUF != 0) && is_branch && !ex_stall),
+    .br_taken(branch_taken),
+    .br_pc(id_ex_pc),
+    .br_target(branch_target),
+    .br_from_lb(id_ex_from_lb),
+    .br_iter(id_ex_lb_iter),
+    .redirect(flush || id_redirect),
+    .redirect_lb(flush ? (lb_ex_redirect && id_ex_from_lb) : if_id_from_lb),
+    .redirect_iter(flush ? id_ex_lb_iter : if_id_lb_iter),
+    .redirect_pc(flush ? (branch_taken ? branch_target : id_ex_pc + 32'd4) : id_redirect_pc),
+    .inval(instr_cache_inval)
+);
+
+assign fetch_inst0 = lb_hit ? lb_inst0 : instr_cache_data_out;
+assign fetch_inst1 = lb_hit ? lb_inst1 : instr_cache_data_out2;
+wire   fetch_hit2  = lb_hit ? lb_hit2  : instr_cache_cache_hit2;
+
+// Fetch prediction. JAL is always taken to its predecoded target. For
+// branches the BTB decides when it has an entry; otherwise backward
+// branches (loops) are predicted taken.
+wire        pd_jal        = instr_cache_pd_out[33];
+wire        pd_bwd_branch = instr_cache_pd_out[32];
+wire [31:0] pd_target     = instr_cache_pd_out[31:0];
+
+wire        fetch_pred_taken  = lb_hit ? lb_pred_taken :
+                                pd_jal || (branch_hit ? branch_taken_pred : pd_bwd_branch);
+wire [31:0] fetch_pred_target = lb_hit ? lb_pred_target :
+                                (pd_jal || !branch_hit) ? pd_target : branch_target_pred;
+
+wire        fill_pred_taken  = fill_pd_jal || (branch_hit ? branch_taken_pred : fill_pd_bwd_branch);
+wire [31:0] fill_pred_target = (fill_pd_jal || !branch_hit) ? fill_pd_target : branch_target_pred;
+
+// Dual-issue: take PC + 4 along with PC when both hit in the cache, the
+// pair is legal and PC is not a predicted-taken branch
+wire fetch_pair = (DUAL_ISSUE != 0) && fetch_hit2 && pair_can_issue && !fetch_pred_taken;
+
+// Instructions supplied by the loop buffer (mhpmcounter11)
+assign lb_fetch_count = (fetch_hit_take && lb_hit) ? (fetch_pair ? 2'd2 : 2'd1) : 2'd0;
+
 // New instruction arriving this cycle (from any source)
 wire new_instr_arriving = fetch_buffer_valid || // From Fetch Buffer
                           (fetch_wait && mem_ready) || // From Memory
-                          (instr_cache_valid && instr_cache_cache_hit); // From I-Cache
+                          fetch_hit; // From I-Cache or loop buffer
 
 always @(posedge clk) begin
     if (~rstn) begin
-        PC <= PC_INIT;
+        PC <= reset_pc;
         fetch_wait <= 1'b0;
-        fetch_pc <= PC_INIT;
+        fetch_pc <= reset_pc;
         if_id_ir <= 32'h00000013;  // NOP
         if_id_pc <= 32'b0;
         if_id_valid <= 1'b0;
+        if_id1_ir <= 32'h00000013;  // NOP
+        if_id1_valid <= 1'b0;
         if_id_branch_taken_pred <= 1'b0;
         if_id_branch_target_pred <= 32'b0;
+        if_id_from_lb <= 1'b0;
+        if_id_lb_iter <= 16'b0;
         fetch_buffer_valid <= 1'b0;
         fetch_buffer_ir <= 32'b0;
         fetch_buffer_pc <= 32'b0;
         instr_cache_wen <= 1'b0;
+        instr_cache_wlock <= 1'b0;
+        instr_cache_inval <= 1'b0;
+        instr_cache_unlock <= 1'b0;
+        pre_active <= 1'b0;
+        pre_wait <= 1'b0;
+        pre_lock <= 1'b0;
+        pre_addr <= 32'b0;
+        pre_left <= 16'b0;
     end else begin
         instr_cache_wen <= 1'b0;
+        instr_cache_wlock <= 1'b0;
+        instr_cache_inval <= icache_cmd && icache_cmd_data[2];
+        instr_cache_unlock <= icache_cmd && icache_cmd_data[3];
         if (flush) begin
             // Flush: invalidate IF/ID (delay slot) and redirect PC to target
             perf_pipeline_flush <= perf_pipeline_flush + 1;
             if_id_valid <= 1'b0;
             if_id_ir <= 32'h00000013;
+            if_id1_valid <= 1'b0;
             // Also invalidate the fetch buffer to prevent stale instructions from being loaded
             fetch_buffer_valid <= 1'b0;
             // PC redirect priority: trap > MRET > jump/branch misprediction
             PC <= trap_enter_r           ? csr_mtvec :
+                  mret_chain             ? csr_mtvec :
                   mret_in_ex             ? csr_mepc :
                   is_jump                ? jump_target :
                   id_ex_branch_taken_pred ? (id_ex_pc + 4) :
                   branch_target;
             fetch_wait <= 1'b0;
+        end else if (id_redirect) begin
+            // Branch resolved in ID against its prediction: drop the
+            // wrong-path fetch and restart from the resolved PC
+            if_id_valid <= 1'b0;
+            if_id_ir <= 32'h00000013;
+            if_id1_valid <= 1'b0;
+            fetch_buffer_valid <= 1'b0;
+            PC <= id_redirect_pc;
+            fetch_wait <= 1'b0;
         end else begin            
             // Clear if_id_valid when consumed (unless new instruction arriving)
-            if (!stall && if_id_valid && !new_instr_arriving)
+            if (!stall && if_id_valid && !new_instr_arriving) begin
                 if_id_valid <= 1'b0;
+                if_id1_valid <= 1'b0;
+            end
             
             if (!stall && fetch_buffer_valid) begin
                 // Move buffer to IF/ID
                 if_id_ir <= fetch_buffer_ir;
                 if_id_pc <= fetch_buffer_pc;
                 if_id_valid <= 1'b1;
+                if_id1_valid <= 1'b0;
+                if_id_from_lb <= 1'b0;
                 fetch_buffer_valid <= 1'b0;
             end else if (fetch_wait && mem_ready) begin
                 // Fetch complete - use fetch_pc for the address, not current PC
                 perf_inst_fetch <= perf_inst_fetch + 1;
                 // Make branch prediction
-                if_id_branch_taken_pred <= branch_taken_pred;
-                if_id_branch_target_pred <= branch_target_pred;
+                if_id_branch_taken_pred <= fill_pred_taken;
+                if_id_branch_target_pred <= fill_pred_target;
+                if_id_from_lb <= 1'b0;
                 // Write the new instruction to the cache
                 instr_cache_wen <= 1'b1;
                 instr_cache_data_in <= mem_rdata;
+                instr_cache_pd_in <= {fill_pd_jal, fill_pd_bwd_branch, fill_pd_target};
 
                 if (!stall && !fetch_buffer_valid) begin
                     // Pipeline active and buffer empty: load directly to IF/ID
                     if_id_ir <= mem_rdata;
                     if_id_pc <= fetch_pc;
                     if_id_valid <= 1'b1;
+                    if_id1_valid <= 1'b0;
                 end else begin
                     // Pipeline stalled or buffer full: load to buffer
                     fetch_buffer_ir <= mem_rdata;
@@ -670,27 +1200,59 @@ always @(posedge clk) begin
                 end
                 
                 // Advance PC from the address we just fetched and clear flags
-                PC <= branch_taken_pred ? branch_target_pred : fetch_pc + 4;
+                PC <= fill_pred_taken ? fill_pred_target : fetch_pc + 4;
                 fetch_wait <= 1'b0;
-            end else if (!fetch_wait && !stall && (instr_cache_valid && instr_cache_cache_hit) && !fetch_buffer_valid) begin
-                // Cache hit: load instruction and advance PC
-                if_id_ir <= instr_cache_data_out;
+            end else if (!fetch_wait && !stall && fetch_hit && !fetch_buffer_valid) begin
+                // Cache (or loop buffer) hit: load instruction and advance PC
+                if_id_ir <= fetch_inst0;
                 if_id_pc <= instr_cache_address;
                 if_id_valid <= 1'b1;
-                PC <= branch_taken_pred ? branch_target_pred : PC + 4;
-                perf_inst_cache_hits <= perf_inst_cache_hits + 1;
+                if_id1_ir <= fetch_inst1;
+                if_id1_valid <= fetch_pair;
+                PC <= fetch_pred_taken ? fetch_pred_target :
+                      fetch_pair       ? PC + 8 :
+                      PC + 4;
+                if (!lb_hit)
+                    perf_inst_cache_hits <= perf_inst_cache_hits + 1;
                 // Make branch prediction
-                if_id_branch_taken_pred <= branch_taken_pred;
-                if_id_branch_target_pred <= branch_target_pred;
-            end else if (!fetch_wait && !mem_op_pending && !mem_busy &&
-                         !(ex_mem_valid && (ex_mem_is_load || ex_mem_is_store)) && 
+                if_id_branch_taken_pred <= fetch_pred_taken;
+                if_id_branch_target_pred <= fetch_pred_target;
+                if_id_from_lb <= lb_hit;
+                if_id_lb_iter <= lb_iter;
+            end else if (!fetch_wait && !pre_active && !mem_op_pending && !mem_busy &&
+                         !(ex_mem_valid && (ex_mem_is_load || ex_mem_is_store || ex_mem_is_amo)) && 
                          (!fetch_buffer_valid || !stall) && 
-                         !instr_cache_valid && !instr_cache_cache_hit) begin
-                // Cache miss - start memory fetch
+                         !lb_hit && !instr_cache_valid && !instr_cache_cache_hit) begin
+                // Cache miss - start memory fetch (after any preload)
                 fetch_wait <= 1'b1;
                 fetch_pc <= PC;
             end
         end
+
+        // Preload: one word at a time in the bus slots a miss would
+        // use. Redirects do not cancel it.
+        if (pre_wait && mem_ready) begin
+            instr_cache_wen <= 1'b1;
+            instr_cache_wlock <= pre_lock;
+            instr_cache_data_in <= mem_rdata;
+            instr_cache_pd_in <= {fill_pd_jal, fill_pd_bwd_branch, fill_pd_target};
+            pre_wait <= 1'b0;
+            pre_addr <= pre_addr + 32'd4;
+            pre_left <= pre_left - 16'd1;
+            pre_active <= (pre_left != 16'd1);
+        end else if (pre_active && !pre_wait && !fetch_wait && !mem_op_pending && !mem_busy &&
+                     !(ex_mem_valid && (ex_mem_is_load || ex_mem_is_store || ex_mem_is_amo))) begin
+            pre_wait <= 1'b1;
+            fetch_pc <= pre_addr;
+        end
+
+        // PRELOAD is ignored while one is still running
+        if (icache_cmd && icache_cmd_data[0] && !pre_active) begin
+            pre_active <= (icache_cmd_data[31:16] != 16'd0);
+            pre_addr <= icache_addr;
+            pre_left <= icache_cmd_data[31:16];
+            pre_lock <= icache_cmd_data[1];
+        end
     end
 end
 
@@ -698,17 +1260,6 @@ end
 //              PIPELINE STAGE: DECODE
 // ##################################################
 
-// Forwarding for decode stage (into ID/EX)
-wire [31:0] dec_fwd_rs1 = 
-    (ex_mem_valid && ex_mem_reg_write && ex_mem_rd == dec_rs1 && dec_rs1 != 5'b0) ? ex_mem_alu_result :
-    (mem_wb_valid && mem_wb_reg_write && mem_wb_rd == dec_rs1 && mem_wb_rd != 5'b0) ? mem_wb_result :
-    rf_rs1_data;
-
-wire [31:0] dec_fwd_rs2 = 
-    (ex_mem_valid && ex_mem_reg_write && ex_mem_rd == dec_rs2 && dec_rs2 != 5'b0) ? ex_mem_alu_result :
-    (mem_wb_valid && mem_wb_reg_write && mem_wb_rd == dec_rs2 && mem_wb_rd != 5'b0) ? mem_wb_result :
-    rf_rs2_data;
-
 always @(posedge clk) begin
     if (~rstn) begin
         id_ex_valid <= 1'b0;
@@ -719,10 +1270,11 @@ always @(posedge clk) begin
         id_ex_rd <= 5'b0;
         id_ex_rs1_addr <= 5'b0;
         id_ex_rs2_addr <= 5'b0;
-        id_ex_alu_op <= 5'b0;
+        id_ex_alu_op <= 6'b0;
         id_ex_funct3 <= 3'b0;
         id_ex_is_load <= 1'b0;
         id_ex_is_store <= 1'b0;
+        id_ex_is_amo <= 1'b0;
         id_ex_is_branch <= 1'b0;
         id_ex_is_jal <= 1'b0;
         id_ex_is_jalr <= 1'b0;
@@ -733,6 +1285,8 @@ always @(posedge clk) begin
         id_ex_reg_write <= 1'b0;
         id_ex_branch_taken_pred <= 1'b0;
         id_ex_branch_target_pred <= 32'b0;
+        id_ex_from_lb <= 1'b0;
+        id_ex_lb_iter <= 16'b0;
         id_ex_is_csr <= 1'b0;
         id_ex_is_mret <= 1'b0;
         id_ex_csr_addr <= 12'b0;
@@ -741,7 +1295,7 @@ always @(posedge clk) begin
         id_ex_is_ebreak <= 1'b0;
         id_ex_is_illegal <= 1'b0;
         id_ex_ir <= 32'b0;
-    end else if (trap_enter_r || mret_in_ex || ((prediction_flush || load_use_hazard) && !ex_stall)) begin
+    end else if (trap_enter_r || mret_in_ex || ((prediction_flush || load_use_hazard || bank_hold || wfi_hold) && !ex_stall)) begin
         // Insert bubble on flush or load-use hazard.
         // prediction_flush is gated by !ex_stall: if the EX stage is stalled,
         // the jump/branch result hasn't been latched into EX/MEM yet, so we
@@ -752,6 +1306,7 @@ always @(posedge clk) begin
         id_ex_reg_write <= 1'b0;
         id_ex_is_load <= 1'b0;
         id_ex_is_store <= 1'b0;
+        id_ex_is_amo <= 1'b0;
         id_ex_is_branch <= 1'b0;
         id_ex_is_jal <= 1'b0;
         id_ex_is_jalr <= 1'b0;
@@ -760,6 +1315,7 @@ always @(posedge clk) begin
         id_ex_is_div <= 1'b0;
         id_ex_branch_taken_pred <= 1'b0;
         id_ex_branch_target_pred <= 32'b0;
+        id_ex_from_lb <= 1'b0;
         id_ex_is_csr <= 1'b0;
         id_ex_is_mret <= 1'b0;
         id_ex_is_ecall <= 1'b0;
@@ -777,6 +1333,7 @@ always @(posedge clk) begin
         id_ex_funct3 <= dec_funct3;
         id_ex_is_load <= dec_is_load;
         id_ex_is_store <= dec_is_store;
+        id_ex_is_amo <= dec_is_amo;
         id_ex_is_branch <= dec_is_branch;
         id_ex_is_jal <= dec_is_jal;
         id_ex_is_jalr <= dec_is_jalr;
@@ -793,14 +1350,58 @@ always @(posedge clk) begin
         id_ex_is_illegal <= dec_is_illegal;
         id_ex_ir <= if_id_ir;
         id_ex_reg_write <= dec_reg_write;
-        id_ex_branch_taken_pred <= if_id_branch_taken_pred;
-        id_ex_branch_target_pred <= if_id_branch_target_pred;
+        // A branch resolved in ID carries its outcome as the prediction,
+        // so EX only flushes if the early resolution was skipped
+        id_ex_branch_taken_pred <= id_br_resolved ? id_br_cond : if_id_branch_taken_pred;
+        id_ex_branch_target_pred <= id_br_resolved ? id_br_target : if_id_branch_target_pred;
+        id_ex_from_lb <= if_id_from_lb;
+        id_ex_lb_iter <= if_id_lb_iter;
         id_ex_valid <= 1'b1;
     end else if (!stall) begin
         id_ex_valid <= 1'b0;
     end
 end
 
+// Lane 1 follows lane 0 through ID/EX (same bubble and stall rules)
+always @(posedge clk) begin
+    if (~rstn) begin
+        id_ex1_valid <= 1'b0;
+        id_ex1_pc <= 32'b0;
+        id_ex1_rs1_data <= 32'b0;
+        id_ex1_rs2_data <= 32'b0;
+        id_ex1_imm <= 32'b0;
+        id_ex1_rd <= 5'b0;
+        id_ex1_rs1_addr <= 5'b0;
+        id_ex1_rs2_addr <= 5'b0;
+        id_ex1_alu_op <= 6'b0;
+        id_ex1_is_i_alu <= 1'b0;
+        id_ex1_is_lui <= 1'b0;
+        id_ex1_is_auipc <= 1'b0;
+        id_ex1_reg_write <= 1'b0;
+        id_ex1_ir <= 32'b0;
+    end else if (trap_enter_r || mret_in_ex || ((prediction_flush || load_use_hazard || bank_hold || wfi_hold) && !ex_stall)) begin
+        id_ex1_valid <= 1'b0;
+        id_ex1_reg_write <= 1'b0;
+    end else if (!stall && if_id_valid) begin
+        id_ex1_pc <= if_id_pc + 32'd4;
+        id_ex1_rs1_data <= dec1_fwd_rs1;
+        id_ex1_rs2_data <= dec1_fwd_rs2;
+        id_ex1_imm <= dec1_imm;
+        id_ex1_rd <= dec1_rd;
+        id_ex1_rs1_addr <= dec1_rs1;
+        id_ex1_rs2_addr <= dec1_rs2;
+        id_ex1_alu_op <= dec1_alu_op;
+        id_ex1_is_i_alu <= dec1_is_i_alu;
+        id_ex1_is_lui <= dec1_is_lui;
+        id_ex1_is_auipc <= dec1_is_auipc;
+        id_ex1_ir <= if_id1_ir;
+        id_ex1_reg_write <= if_id1_valid && !id_redirect;
+        id_ex1_valid <= if_id1_valid && !id_redirect;
+    end else if (!stall) begin
+        id_ex1_valid <= 1'b0;
+    end
+end
+
 // ##################################################
 //              PIPELINE STAGE: EXECUTE
 // ##################################################
@@ -812,6 +1413,28 @@ wire [31:0] ex_result = id_ex_is_csr   ? csr_read_data :    // CSR read (old val
                         id_ex_is_div ? div_final_result :
                         alu_out;
 
+// Lane 1 is younger than lane 0: drop it when lane 0 redirects or traps
+wire ex_lane0_kill = prediction_flush || trap_enter_r ||
+                     misalign_load || misalign_store || misalign_branch || misalign_jump;
+
+always @(posedge clk) begin
+    if (~rstn) begin
+        ex_mem1_valid <= 1'b0;
+        ex_mem1_result <= 32'b0;
+        ex_mem1_rd <= 5'b0;
+        ex_mem1_reg_write <= 1'b0;
+        ex_mem1_pc <= 32'b0;
+        ex_mem1_ir <= 32'b0;
+    end else if (!mem_stall && !ex_stall) begin
+        ex_mem1_result <= alu1_out;
+        ex_mem1_pc <= id_ex1_pc;
+        ex_mem1_ir <= id_ex1_ir;
+        ex_mem1_rd <= id_ex1_rd;
+        ex_mem1_reg_write <= id_ex1_reg_write && !ex_lane0_kill;
+        ex_mem1_valid <= id_ex1_valid && !ex_lane0_kill;
+    end
+end
+
 always @(posedge clk) begin
     if (~rstn) begin
         ex_mem_valid <= 1'b0;
@@ -821,14 +1444,22 @@ always @(posedge clk) begin
         ex_mem_funct3 <= 3'b0;
         ex_mem_is_load <= 1'b0;
         ex_mem_is_store <= 1'b0;
+        ex_mem_is_amo <= 1'b0;
+        ex_mem_amo_op <= 5'b0;
         ex_mem_reg_write <= 1'b0;
+        ex_mem_pc <= 32'b0;
+        ex_mem_ir <= 32'b0;
     end else if (!mem_stall && !ex_stall) begin
         ex_mem_alu_result <= ex_result;
+        ex_mem_pc <= id_ex_pc;
+        ex_mem_ir <= id_ex_ir;
         ex_mem_rs2_data <= fwd_rs2_data;
         ex_mem_rd <= id_ex_rd;
         ex_mem_funct3 <= id_ex_funct3;
         ex_mem_is_load <= id_ex_is_load;
         ex_mem_is_store <= id_ex_is_store;
+        ex_mem_is_amo <= id_ex_is_amo;
+        ex_mem_amo_op <= id_ex_ir[31:27];
         ex_mem_reg_write <= id_ex_reg_write && !id_ex_is_branch && !id_ex_is_store && !id_ex_is_mret
                            && !id_ex_is_ecall && !id_ex_is_ebreak && !id_ex_is_illegal && !trap_enter_r
                            && !misalign_load && !misalign_store && !misalign_branch && !misalign_jump;
@@ -842,33 +1473,83 @@ end
 //              PIPELINE STAGE: MEMORY
 // ##################################################
 
+// Atomics. LR is a read that takes a reservation, SC a write that needs
+// it; the monitor returns excl_fail with the write response and that is
+// SC's result. An AMO is a reserved read followed by a reserved write of
+// the combined value. If another master wrote the word in between, the
+// write is dropped and the pair is retried, so the op stays pending
+// until a write goes through.
+wire mem_is_lr  = ex_mem_is_amo && (ex_mem_amo_op == AMO_LR);
+wire mem_is_sc  = ex_mem_is_amo && (ex_mem_amo_op == AMO_SC);
+wire mem_is_rmw = ex_mem_is_amo && !mem_is_lr && !mem_is_sc;
+
+reg        mem_amo_phase;      // Write half of an AMO
+reg [31:0] mem_amo_old;        // Word read by the first half (rd result)
+
+wire mem_amo_step = mem_op_pending && mem_is_rmw && mem_ready && (!mem_amo_phase || excl_fail);
+
+assign excl_rd = mem_op_pending && (mem_is_lr || (mem_is_rmw && !mem_amo_phase));
+assign excl_wr = mem_op_pending && (mem_is_sc || (mem_is_rmw && mem_amo_phase));
+
+reg [31:0] amo_result;
+always @* begin
+    case (ex_mem_amo_op)
+        AMO_SWAP: amo_result = ex_mem_rs2_data;
+        AMO_ADD:  amo_result = mem_rdata + ex_mem_rs2_data;
+        AMO_XOR:  amo_result = mem_rdata ^ ex_mem_rs2_data;
+        AMO_AND:  amo_result = mem_rdata & ex_mem_rs2_data;
+        AMO_OR:   amo_result = mem_rdata | ex_mem_rs2_data;
+        AMO_MIN:  amo_result = ($signed(mem_rdata) < $signed(ex_mem_rs2_data)) ? mem_rdata : ex_mem_rs2_data;
+        AMO_MAX:  amo_result = ($signed(mem_rdata) > $signed(ex_mem_rs2_data)) ? mem_rdata : ex_mem_rs2_data;
+        AMO_MINU: amo_result = (mem_rdata < ex_mem_rs2_data) ? mem_rdata : ex_mem_rs2_data;
+        AMO_MAXU: amo_result = (mem_rdata > ex_mem_rs2_data) ? mem_rdata : ex_mem_rs2_data;
+        default:  amo_result = ex_mem_rs2_data;
+    endcase
+end
+
+wire [31:0] mem_amo_data = mem_is_lr ? mem_rdata :
+                           mem_is_sc ? {31'b0, excl_fail} :
+                           mem_amo_old;
+
+// Misaligned accesses. A halfword at byte 1 stays inside one word and
+// only needs shifting; a halfword at byte 3 or a word at bytes 1..3
+// crosses into the next word and is split into two aligned bus
+// transactions (low word first). The pipeline stays stalled until the
+// second one completes.
+wire mem_misaligned = (ex_mem_funct3[1:0] == 2'b01 && ex_mem_alu_result[0]) ||
+                      (ex_mem_funct3[1:0] == 2'b10 && ex_mem_alu_result[1:0] != 2'b00);
+wire mem_cross      = (ex_mem_funct3[1:0] == 2'b01 && ex_mem_alu_result[1:0] == 2'b11) ||
+                      (ex_mem_funct3[1:0] == 2'b10 && ex_mem_alu_result[1:0] != 2'b00);
+
+reg        mem_split_phase;    // Second (high word) transaction of a split
+reg [31:0] mem_split_lo;       // Low word read by the first transaction
+
+wire mem_split_first = mem_op_pending && mem_cross && !mem_split_phase;
+
+// The load/store is complete (the first half of a split is not)
+assign mem_split_step = mem_split_first && mem_ready;
+assign mem_done       = mem_ready && !mem_split_first && !mem_amo_step;
+
+// Store data and strobes over the two words of a split
+wire [3:0]  store_size_strb = (ex_mem_funct3[1:0] == 2'b00) ? 4'b0001 :
+                              (ex_mem_funct3[1:0] == 2'b01) ? 4'b0011 : 4'b1111;
+wire [63:0] store_window    = {32'b0, ex_mem_rs2_data} << {ex_mem_alu_result[1:0], 3'b000};
+wire [7:0]  store_strb      = {4'b0, store_size_strb} << ex_mem_alu_result[1:0];
+
 // Combinational load data extraction from mem_rdata
 // Acts as a LSU (Load Store Unit)
 // This allows WB stage to use the correct data immediately
+wire [63:0] load_window  = mem_split_phase ? {mem_rdata, mem_split_lo} : {32'b0, mem_rdata};
+wire [31:0] load_shifted = load_window >> {ex_mem_alu_result[1:0], 3'b000};
+
 reg [31:0] mem_load_data;
 always @* begin
     case (ex_mem_funct3)
-        3'b000: case (ex_mem_alu_result[1:0])  // LB (signed)
-            2'b00: mem_load_data = {{24{mem_rdata[7]}}, mem_rdata[7:0]};
-            2'b01: mem_load_data = {{24{mem_rdata[15]}}, mem_rdata[15:8]};
-            2'b10: mem_load_data = {{24{mem_rdata[23]}}, mem_rdata[23:16]};
-            2'b11: mem_load_data = {{24{mem_rdata[31]}}, mem_rdata[31:24]};
-        endcase
-        3'b001: case (ex_mem_alu_result[1])  // LH (signed)
-            1'b0: mem_load_data = {{16{mem_rdata[15]}}, mem_rdata[15:0]};
-            1'b1: mem_load_data = {{16{mem_rdata[31]}}, mem_rdata[31:16]};
-        endcase
-        3'b010: mem_load_data = mem_rdata;  // LW
-        3'b100: case (ex_mem_alu_result[1:0])  // LBU (unsigned)
-            2'b00: mem_load_data = {24'b0, mem_rdata[7:0]};
-            2'b01: mem_load_data = {24'b0, mem_rdata[15:8]};
-            2'b10: mem_load_data = {24'b0, mem_rdata[23:16]};
-            2'b11: mem_load_data = {24'b0, mem_rdata[31:24]};
-        endcase
-        3'b101: case (ex_mem_alu_result[1])  // LHU (unsigned)
-            1'b0: mem_load_data = {16'b0, mem_rdata[15:0]};
-            1'b1: mem_load_data = {16'b0, mem_rdata[31:16]};
-        endcase
+        3'b000: mem_load_data = {{24{load_shifted[7]}}, load_shifted[7:0]};    // LB
+        3'b001: mem_load_data = {{16{load_shifted[15]}}, load_shifted[15:0]};  // LH
+        3'b010: mem_load_data = load_shifted;                                  // LW
+        3'b100: mem_load_data = {24'b0, load_shifted[7:0]};                    // LBU
+        3'b101: mem_load_data = {16'b0, load_shifted[15:0]};                   // LHU
         default: mem_load_data = mem_rdata;
     endcase
 end
@@ -878,34 +1559,69 @@ always @(posedge clk) begin
         mem_op_pending <= 1'b0;
         mem_data_out_r <= 32'b0;
         mem_wstrb_r <= 4'b1111;
+        mem_split_phase <= 1'b0;
+        mem_split_lo <= 32'b0;
+        mem_amo_phase <= 1'b0;
+        mem_amo_old <= 32'b0;
     end else begin
         // Start mem_op_pending when:
         // - Not currently pending
         // - mem_busy is false (AXI bus available - either idle or just completed)
         // This allows stores to be queued while waiting for fetch to complete
-        if (ex_mem_valid && (ex_mem_is_load || ex_mem_is_store) && !mem_op_pending && !mem_busy) begin
+        if (ex_mem_valid && (ex_mem_is_load || ex_mem_is_store || ex_mem_is_amo) && !mem_op_pending && !mem_busy) begin
             mem_op_pending <= 1'b1;
+            mem_split_phase <= 1'b0;
+            mem_amo_phase <= 1'b0;
             if (ex_mem_is_store) begin
                 perf_memory_writes <= perf_memory_writes + 1;
-                case (ex_mem_funct3[1:0])
-                    2'b00: begin
-                        mem_data_out_r <= {4{ex_mem_rs2_data[7:0]}};
-                        mem_wstrb_r <= 4'b0001 << ex_mem_alu_result[1:0];
-                    end
-                    2'b01: begin
-                        mem_data_out_r <= {2{ex_mem_rs2_data[15:0]}};
-                        mem_wstrb_r <= 4'b0011 << ex_mem_alu_result[1:0];
-                    end
-                    default: begin
-                        mem_data_out_r <= ex_mem_rs2_data;
-                        mem_wstrb_r <= 4'b1111;
-                    end
-                endcase
+                if (mem_misaligned) begin
+                    mem_data_out_r <= store_window[31:0];
+                    mem_wstrb_r <= store_strb[3:0];
+                end else begin
+                    case (ex_mem_funct3[1:0])
+                        2'b00: begin
+                            mem_data_out_r <= {4{ex_mem_rs2_data[7:0]}};
+                            mem_wstrb_r <= 4'b0001 << ex_mem_alu_result[1:0];
+                        end
+                        2'b01: begin
+                            mem_data_out_r <= {2{ex_mem_rs2_data[15:0]}};
+                            mem_wstrb_r <= 4'b0011 << ex_mem_alu_result[1:0];
+                        end
+                        default: begin
+                            mem_data_out_r <= ex_mem_rs2_data;
+                            mem_wstrb_r <= 4'b1111;
+                        end
+                    endcase
+                end
+            end else if (ex_mem_is_amo) begin
+                // SC writes rs2; an AMO replaces it with amo_result after the read
+                mem_data_out_r <= ex_mem_rs2_data;
+                mem_wstrb_r <= 4'b1111;
+                if (mem_is_sc)
+                    perf_memory_writes <= perf_memory_writes + 1;
+                else
+                    perf_memory_reads <= perf_memory_reads + 1;
             end else if (ex_mem_is_load) begin
                 perf_memory_reads <= perf_memory_reads + 1;
             end
+        end else if (mem_amo_step) begin
+            // Read done: write the combined value. Write dropped: read again.
+            mem_amo_phase <= !mem_amo_phase;
+            if (!mem_amo_phase) begin
+                mem_amo_old <= mem_rdata;
+                mem_data_out_r <= amo_result;
+                perf_memory_writes <= perf_memory_writes + 1;
+            end
+        end else if (mem_split_step) begin
+            // Low word done: keep the op pending for the high word
+            mem_split_phase <= 1'b1;
+            mem_split_lo <= mem_rdata;
+            mem_data_out_r <= store_window[63:32];
+            mem_wstrb_r <= store_strb[7:4];
         end else if (mem_op_pending && mem_ready) begin
             mem_op_pending <= 1'b0;
+            mem_split_phase <= 1'b0;
+            mem_amo_phase <= 1'b0;
         end
     end
 end
@@ -920,16 +1636,24 @@ always @(posedge clk) begin
         mem_wb_result <= 32'b0;
         mem_wb_rd <= 5'b0;
         mem_wb_reg_write <= 1'b0;
-    end else if ((!mem_stall && !ex_stall) || (mem_op_pending && mem_ready)) begin
+        mem_wb_commit <= 1'b0;
+        mem_wb_pc <= 32'b0;
+        mem_wb_ir <= 32'b0;
+    end else if ((!mem_stall && !ex_stall) || (mem_op_pending && mem_done)) begin
         // Advance MEM/WB pipeline register when:
         // 1. No stalls (neither memory nor EX stage stalled), OR
         // 2. A memory operation just completed (even if stalled, we take the result)
         mem_wb_rd <= ex_mem_rd;
         mem_wb_reg_write <= ex_mem_reg_write && !ex_mem_is_store;
         mem_wb_valid <= ex_mem_valid && !ex_mem_is_store;
+        mem_wb_commit <= ex_mem_valid;
+        mem_wb_pc <= ex_mem_pc;
+        mem_wb_ir <= ex_mem_ir;
         
-        if (ex_mem_is_load && mem_op_pending && mem_ready) begin
+        if (ex_mem_is_load && mem_op_pending && mem_done) begin
             mem_wb_result <= mem_load_data;
+        end else if (ex_mem_is_amo && mem_op_pending && mem_done) begin
+            mem_wb_result <= mem_amo_data;
         end else begin
             mem_wb_result <= ex_mem_alu_result;
         end
@@ -938,6 +1662,30 @@ always @(posedge clk) begin
         mem_wb_valid <= 1'b0;
         mem_wb_reg_write <= 1'b0;
         mem_wb_rd <= 5'b0;
+        mem_wb_commit <= 1'b0;
+    end
+end
+
+// Lane 1 has no memory access: its result passes straight through
+always @(posedge clk) begin
+    if (~rstn) begin
+        mem_wb1_valid <= 1'b0;
+        mem_wb1_result <= 32'b0;
+        mem_wb1_rd <= 5'b0;
+        mem_wb1_reg_write <= 1'b0;
+        mem_wb1_pc <= 32'b0;
+        mem_wb1_ir <= 32'b0;
+    end else if ((!mem_stall && !ex_stall) || (mem_op_pending && mem_done)) begin
+        mem_wb1_pc <= ex_mem1_pc;
+        mem_wb1_ir <= ex_mem1_ir;
+        mem_wb1_rd <= ex_mem1_rd;
+        mem_wb1_reg_write <= ex_mem1_reg_write;
+        mem_wb1_valid <= ex_mem1_valid;
+        mem_wb1_result <= ex_mem1_result;
+    end else begin
+        mem_wb1_valid <= 1'b0;
+        mem_wb1_reg_write <= 1'b0;
+        mem_wb1_rd <= 5'b0;
     end
 end
 
@@ -948,7 +1696,6 @@ end
 // Interrupt priority (§3.1.9): MEI (11) > MSI (3) > MTI (7)
 // Taken only when pipeline is not stalled and no flush in progress.
 
-reg [31:0] irq_cause;
 always @(*) begin
     if (meip && csr_mie_meie)
         irq_cause = {1'b1, 31'd11};  // Machine External Interrupt
@@ -1006,7 +1753,8 @@ always @(posedge clk) begin
         end
 
         // Asynchronous interrupts (lower priority than exceptions)
-        if (csr_irq_pending && !flush && !stall && !trap_enter_r &&
+        // A WFI in IF/ID moves on first, so mepc is the instruction after it
+        if (csr_irq_pending && !flush && !stall && !trap_enter_r && !(if_id_valid && dec_is_wfi) &&
             !(id_ex_valid && (id_ex_is_illegal || id_ex_is_ecall || id_ex_is_ebreak ||
                              misalign_branch || misalign_jump || misalign_load || misalign_store))) begin
             trap_enter_r  <= 1'b1;
@@ -1017,6 +1765,47 @@ always @(posedge clk) begin
     end
 end
 
+// ##################################################
+//              STALL ATTRIBUTION
+// ##################################################
+//
+// Exactly one cause per lost cycle, highest priority first, so the
+// mhpmcounter4..9 totals add up:
+//   [0] MEM      data load/store in flight on the bus
+//   [1] BUS      load/store in EX/MEM waiting for the bus (fetch owns it)
+//   [2] DIV      divider busy
+//   [3] LOAD_USE load-use bubble
+//   [4] FETCH    ID/EX starved, nothing in IF/ID (I-cache miss, refill)
+//   [5] FLUSH    control-flow redirect (mispredict, trap, MRET), bank switch
+
+wire stall_bus = ex_mem_valid && (ex_mem_is_load || ex_mem_is_store || ex_mem_is_amo) &&
+                 (!mem_op_pending || mem_busy);
+
+assign stall_cause[0] = mem_stall;
+assign stall_cause[1] = !mem_stall && stall_bus;
+assign stall_cause[2] = !mem_stall && !stall_bus && div_stall;
+assign stall_cause[3] = !ex_stall && load_use_hazard;
+assign stall_cause[4] = !stall && !flush && !id_redirect && !if_id_valid;
+assign stall_cause[5] = (!stall && (flush || id_redirect)) ||
+                        (!ex_stall && !load_use_hazard && bank_hold);
+
+// ##################################################
+//                 COMMIT TRACE
+// ##################################################
+
+assign trace_valid   = {mem_wb1_valid, mem_wb_commit};
+assign trace_pc      = {mem_wb1_pc, mem_wb_pc};
+assign trace_insn    = {mem_wb1_ir, mem_wb_ir};
+assign trace_rd      = {mem_wb1_rd, mem_wb_rd};
+assign trace_rd_we   = {mem_wb1_valid && mem_wb1_reg_write && mem_wb1_rd != 5'b0,
+                        mem_wb_valid && mem_wb_reg_write && mem_wb_rd != 5'b0};
+assign trace_rd_data = {mem_wb1_result, mem_wb_result};
+
+// Interrupt entry, so a reference model can take it at the same point
+assign trace_irq       = (trap_enter_r && trap_mcause_r[31]) || mret_chain;
+assign trace_irq_epc   = mret_chain ? csr_mepc : trap_mepc_r;
+assign trace_irq_cause = mret_chain ? irq_cause : trap_mcause_r;
+
 // ##################################################
 //           STATE FOR TESTBENCH COMPATIBILITY
 // ##################################################
@@ -1030,7 +1819,7 @@ localparam STATE_WRITE_b = 4;
 
 wire [N_STATES-1:0] state;
 
-assign state = {mem_wb_valid, ex_mem_valid, id_ex_valid, if_id_valid, fetch_wait | (instr_cache_valid && instr_cache_cache_hit)};
+assign state = {mem_wb_valid, ex_mem_valid, id_ex_valid, if_id_valid, fetch_wait | fetch_hit};
 
 // Unified Memory Request Logic (Arbiter)
 // mem_addr is defined as reg above but driven combinationally here.
@@ -1039,12 +1828,14 @@ assign state = {mem_wb_valid, ex_mem_valid, id_ex_valid, if_id_valid, fetch_wait
 always @* begin
     if (mem_op_pending && !mem_ready) begin
         mem_req_comb = 1'b1;
-        mem_wen_comb = ex_mem_is_store;
-        mem_addr = ex_mem_alu_result;
-    end else if (fetch_wait && !mem_ready) begin
+        mem_wen_comb = ex_mem_is_store || excl_wr;
+        mem_addr = !mem_cross      ? ex_mem_alu_result :
+                   mem_split_phase ? {ex_mem_alu_result[31:2] + 30'd1, 2'b00} :
+                                     {ex_mem_alu_result[31:2], 2'b00};
+    end else if ((fetch_wait || pre_wait) && !mem_ready) begin
         mem_req_comb = 1'b1;
         mem_wen_comb = 1'b0;
-        mem_addr = fetch_pc;  // Use captured fetch_pc, not current PC
+        mem_addr = fetch_pc;  // Use captured fetch_pc, not current PC (miss or preload)
     end else begin
         mem_req_comb = 1'b0;
         mem_wen_comb = 1'b0;
@@ -1069,9 +1860,7 @@ always @(posedge clk) begin
         perf_cycle <= perf_cycle + 1;
         
         // Count committed instructions (MEM/WB stage valid)
-        if (mem_wb_valid) begin
-            perf_instret <= perf_instret + 1;
-        end
+        perf_instret <= perf_instret + mem_wb_valid + mem_wb1_valid;
     end
 end
 
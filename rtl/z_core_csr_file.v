@@ -39,7 +39,9 @@ SOFTWARE.
 //
 
 module z_core_csr_file #(
-    parameter DATA_WIDTH = 32
+    parameter DATA_WIDTH = 32,
+    parameter HART_ID    = 0,     // Value read from mhartid
+    parameter SHADOW_REGS = 0     // 1: mzcfg.SHADOW can be set (see z_core_reg_file)
 ) (
     input  wire clk,
     input  wire rstn,
@@ -61,6 +63,8 @@ module z_core_csr_file #(
     input  wire [DATA_WIDTH-1:0] trap_mtval,      // Trap value (faulting addr/insn)
 
     input  wire                 mret_exec,        // MRET execution pulse
+    input  wire                 chain_exec,       // MRET tail-chained into an interrupt
+    input  wire [DATA_WIDTH-1:0] chain_mcause,    // ... with this cause
 
     // ============================================
     // Interrupt Pending Inputs (directly wired)
@@ -73,6 +77,15 @@ module z_core_csr_file #(
     // Instruction Retired Pulse (from pipeline WB)
     // ============================================
     input  wire                 instret_pulse,    // Pulse when instruction retires
+    input  wire                 instret_pulse_lane1, // Pulse when dual-issue lane 1 retires
+
+    // ============================================
+    // Stall Attribution (one-hot, one cause per cycle)
+    // ============================================
+    input  wire [5:0]           stall_events,     // Counted in mhpmcounter4..9
+    input  wire                 misalign_split,   // Misaligned access split in two (mhpmcounter10)
+    input  wire [1:0]           loop_buf_fetch,   // Instructions fetched from the loop buffer (mhpmcounter11)
+    input  wire                 wfi_sleep,        // Cycle spent asleep in WFI (mhpmcounter12)
 
     // ============================================
     // CSR Outputs (directly used by control unit)
@@ -83,7 +96,19 @@ module z_core_csr_file #(
     output wire                 irq_pending,       // Any enabled interrupt is pending
     output wire                 mie_meie_out,      // Machine External Interrupt Enable
     output wire                 mie_mtie_out,      // Machine Timer Interrupt Enable
-    output wire                 mie_msie_out       // Machine Software Interrupt Enable
+    output wire                 mie_msie_out,      // Machine Software Interrupt Enable
+    output wire                 misalign_trap_out, // mzcfg.MISALIGN_TRAP: trap instead of split
+    output wire                 irq_waiting,       // An MRET now would be interrupted at once
+    output wire                 irq_wake,          // An enabled interrupt is pending (ends WFI)
+    output wire                 reg_bank,          // mzcfg.BANK: register bank in use
+
+    // ============================================
+    // I-Cache Control (mzicaddr / mzicctl)
+    // ============================================
+    output wire                 icache_cmd,       // mzicctl written this cycle
+    output wire [DATA_WIDTH-1:0] icache_cmd_data, // ... with this value
+    output wire [DATA_WIDTH-1:0] icache_addr_out, // Preload start address
+    input  wire [DATA_WIDTH-1:0] icache_status    // mzicctl read value
 );
 
     // =========================================================================
@@ -111,11 +136,48 @@ module z_core_csr_file #(
     localparam ADDR_MINSTRET   = 12'hB02;
     localparam ADDR_MINSTRETH  = 12'hB82;
 
+    // Hardware Performance Monitor
+    localparam ADDR_MHPMCOUNTER3  = 12'hB03;  // Dual-issue: lane 1 retired instructions
+    localparam ADDR_MHPMCOUNTER3H = 12'hB83;
+    // mhpmcounter4..9 (0xB04..0xB09, high halves 0xB84..0xB89) count
+    // stall_events[0..5]; read-only aliases at 0xC04..0xC09 / 0xC84..0xC89
+    localparam N_STALL_CTR = 6;
+    localparam ADDR_MHPMCOUNTER10  = 12'hB0A;  // Misaligned loads/stores split by the LSU
+    localparam ADDR_MHPMCOUNTER10H = 12'hB8A;
+    localparam ADDR_MHPMCOUNTER11  = 12'hB0B;  // Instructions supplied by the loop buffer
+    localparam ADDR_MHPMCOUNTER11H = 12'hB8B;
+    localparam ADDR_MHPMCOUNTER12  = 12'hB0C;  // Cycles asleep in WFI
+    localparam ADDR_MHPMCOUNTER12H = 12'hB8C;
+
+    // Z-Core custom configuration (custom M-mode read/write space)
+    //   Bit 0: MISALIGN_TRAP - misaligned LH/LHU/LW/SH/SW raise cause 4/6
+    //          instead of being split in hardware (compliance testing)
+    //   Bit 1: SHADOW - interrupts switch to the shadow register bank
+    //          (reads 0 unless built with SHADOW_REGS)
+    //   Bit 2: BANK   - bank in use (read-only)
+    //   Bit 3: PBANK  - bank before the last trap, restored by MRET (read-only)
+    localparam ADDR_MZCFG      = 12'h7C0;
+
+    // I-cache control (custom)
+    //   mzicaddr: preload start address (word aligned)
+    //   mzicctl:  write = command (PRELOAD, LOCK, INVAL, UNLOCK, COUNT),
+    //             read  = {words left [31:16], 15'b0, BUSY}
+    localparam ADDR_MZICADDR   = 12'h7C1;
+    localparam ADDR_MZICCTL    = 12'h7C2;
+
     // User-visible counter aliases (Read-Only)
     localparam ADDR_CYCLE      = 12'hC00;
     localparam ADDR_CYCLEH     = 12'hC80;
     localparam ADDR_INSTRET    = 12'hC02;
     localparam ADDR_INSTRETH   = 12'hC82;
+    localparam ADDR_HPMCOUNTER3  = 12'hC03;
+    localparam ADDR_HPMCOUNTER3H = 12'hC83;
+    localparam ADDR_HPMCOUNTER10  = 12'hC0A;
+    localparam ADDR_HPMCOUNTER10H = 12'hC8A;
+    localparam ADDR_HPMCOUNTER11  = 12'hC0B;
+    localparam ADDR_HPMCOUNTER11H = 12'hC8B;
+    localparam ADDR_HPMCOUNTER12  = 12'hC0C;
+    localparam ADDR_HPMCOUNTER12H = 12'hC8C;
 
     // =========================================================================
     //  CSR Registers
@@ -143,11 +205,11 @@ module z_core_csr_file #(
     };
 
     // --- misa (Machine ISA) ---
-    // RV32IM + Zicsr: MXL=1 (32-bit), Extensions: I(bit 8) + M(bit 12)
+    // RV32IMA + Zicsr: MXL=1 (32-bit), Extensions: A(bit 0) + I(bit 8) + M(bit 12)
     wire [DATA_WIDTH-1:0] misa_val = {
         2'b01,                  // MXL = 1 (XLEN=32)
         4'b0,                   // Bits 29:26 = 0
-        26'b00_0000_0000_0001_0001_0000_0000  // I(bit 8) + M(bit 12)
+        26'b00_0000_0000_0001_0001_0000_0001  // A(bit 0) + I(bit 8) + M(bit 12)
     };
 
     // --- mie (Machine Interrupt Enable) ---
@@ -206,6 +268,26 @@ module z_core_csr_file #(
     // --- Performance Counters ---
     reg [63:0] mcycle_r;
     reg [63:0] minstret_r;
+    reg [63:0] mhpmcounter3_r;  // Dual-issue rate = mhpmcounter3 / minstret
+    reg [63:0] mhpmcounter10_r; // Misaligned split rate = mhpmcounter10 / minstret
+    reg [63:0] mhpmcounter11_r; // Loop buffer coverage = mhpmcounter11 / minstret
+    reg [63:0] mhpmcounter12_r; // Idle time = mhpmcounter12 / mcycle
+
+    // --- mzcfg (Z-Core configuration) ---
+    reg        mzcfg_misalign_trap;
+    reg        mzcfg_shadow;
+    reg        mzcfg_bank;
+    reg        mzcfg_pbank;
+    reg [31:0] mzicaddr_r;
+
+    // --- Stall Attribution Counters ---
+    wire [64*N_STALL_CTR-1:0] stall_ctr_flat;
+
+    wire       stall_ctr_hit  = (csr_addr[11:8] == 4'hB || csr_addr[11:8] == 4'hC) &&
+                                (csr_addr[6:4] == 3'b000) &&
+                                (csr_addr[3:0] >= 4'd4) && (csr_addr[3:0] <= 4'd9);
+    wire [3:0] stall_ctr_idx  = csr_addr[3:0] - 4'd4;
+    wire       stall_ctr_high = csr_addr[7];
 
     // =========================================================================
     //  Output Assignments
@@ -217,6 +299,11 @@ module z_core_csr_file #(
     assign mie_meie_out = mie_meie;
     assign mie_mtie_out = mie_mtie;
     assign mie_msie_out = mie_msie;
+    assign misalign_trap_out = mzcfg_misalign_trap;
+    assign reg_bank          = mzcfg_bank;
+    assign icache_cmd        = csr_wen && (csr_addr == ADDR_MZICCTL);
+    assign icache_cmd_data   = csr_write_data;
+    assign icache_addr_out   = mzicaddr_r;
 
     // Interrupt pending: any enabled interrupt that is pending, gated by global MIE
     assign irq_pending = mstatus_mie_r & (
@@ -225,6 +312,12 @@ module z_core_csr_file #(
         (mie_msie & msip)     // Software interrupt
     );
 
+    // WFI wakes on an enabled pending interrupt whatever MIE is
+    assign irq_wake = (mie_meie & meip) | (mie_mtie & mtip) | (mie_msie & msip);
+
+    // Tail-chaining: MRET would set MIE from MPIE and take this at once
+    assign irq_waiting = mstatus_mpie_r & irq_wake;
+
     // =========================================================================
     //  Combinational Read Logic
     // =========================================================================
@@ -245,7 +338,7 @@ module z_core_csr_file #(
             ADDR_MVENDORID: csr_read_data = 32'h0;
             ADDR_MARCHID:   csr_read_data = 32'h0;
             ADDR_MIMPID:    csr_read_data = 32'h0;
-            ADDR_MHARTID:   csr_read_data = 32'h0;
+            ADDR_MHARTID:   csr_read_data = HART_ID;
 
             // Performance Counters
             ADDR_MCYCLE,
@@ -256,11 +349,62 @@ module z_core_csr_file #(
             ADDR_INSTRET:   csr_read_data = minstret_r[31:0];
             ADDR_MINSTRETH,
             ADDR_INSTRETH:  csr_read_data = minstret_r[63:32];
+            ADDR_MHPMCOUNTER3,
+            ADDR_HPMCOUNTER3:  csr_read_data = mhpmcounter3_r[31:0];
+            ADDR_MHPMCOUNTER3H,
+            ADDR_HPMCOUNTER3H: csr_read_data = mhpmcounter3_r[63:32];
+            ADDR_MHPMCOUNTER10,
+            ADDR_HPMCOUNTER10:  csr_read_data = mhpmcounter10_r[31:0];
+            ADDR_MHPMCOUNTER10H,
+            ADDR_HPMCOUNTER10H: csr_read_data = mhpmcounter10_r[63:32];
+            ADDR_MHPMCOUNTER11,
+            ADDR_HPMCOUNTER11:  csr_read_data = mhpmcounter11_r[31:0];
+            ADDR_MHPMCOUNTER11H,
+            ADDR_HPMCOUNTER11H: csr_read_data = mhpmcounter11_r[63:32];
+            ADDR_MHPMCOUNTER12,
+            ADDR_HPMCOUNTER12:  csr_read_data = mhpmcounter12_r[31:0];
+            ADDR_MHPMCOUNTER12H,
+            ADDR_HPMCOUNTER12H: csr_read_data = mhpmcounter12_r[63:32];
+
+            ADDR_MZCFG:     csr_read_data = {28'b0, mzcfg_pbank, mzcfg_bank,
+                                             mzcfg_shadow, mzcfg_misalign_trap};
+            ADDR_MZICADDR:  csr_read_data = mzicaddr_r;
+            ADDR_MZICCTL:   csr_read_data = icache_status;
 
             default:        csr_read_data = 32'h0;
         endcase
+
+        if (stall_ctr_hit)
+            csr_read_data = stall_ctr_high ? stall_ctr_flat[64*stall_ctr_idx + 32 +: 32] :
+                                             stall_ctr_flat[64*stall_ctr_idx +: 32];
     end
 
+    // =========================================================================
+    //  Stall Attribution Counters (mhpmcounter4..9)
+    // =========================================================================
+
+    genvar g;
+    generate
+        for (g = 0; g < N_STALL_CTR; g = g + 1) begin : g_stall_ctr
+            reg [63:0] count;
+            wire sel = csr_wen && stall_ctr_hit && (csr_addr[11:8] == 4'hB) &&
+                       (stall_ctr_idx == g) && !trap_enter && !mret_exec;
+
+            always @(posedge clk) begin
+                if (~rstn)
+                    count <= 64'h0;
+                else if (sel && !stall_ctr_high)
+                    count[31:0] <= csr_write_data;
+                else if (sel && stall_ctr_high)
+                    count[63:32] <= csr_write_data;
+                else if (stall_events[g])
+                    count <= count + 1;
+            end
+
+            assign stall_ctr_flat[64*g +: 64] = count;
+        end
+    endgenerate
+
     // =========================================================================
     //  Sequential Write Logic
     // =========================================================================
@@ -280,12 +424,27 @@ module z_core_csr_file #(
             mtval_r        <= 32'h0;
             mcycle_r       <= 64'h0;
             minstret_r     <= 64'h0;
+            mhpmcounter3_r <= 64'h0;
+            mhpmcounter10_r <= 64'h0;
+            mhpmcounter11_r <= 64'h0;
+            mhpmcounter12_r <= 64'h0;
+            mzcfg_misalign_trap <= 1'b0;
+            mzcfg_shadow   <= 1'b0;
+            mzcfg_bank     <= 1'b0;
+            mzcfg_pbank    <= 1'b0;
+            mzicaddr_r     <= 32'h0;
         end else begin
 
             // --- Always-running counters ---
             mcycle_r <= mcycle_r + 1;
-            if (instret_pulse)
-                minstret_r <= minstret_r + 1;
+            minstret_r <= minstret_r + instret_pulse + instret_pulse_lane1;
+            if (instret_pulse_lane1)
+                mhpmcounter3_r <= mhpmcounter3_r + 1;
+            if (misalign_split)
+                mhpmcounter10_r <= mhpmcounter10_r + 1;
+            mhpmcounter11_r <= mhpmcounter11_r + loop_buf_fetch;
+            if (wfi_sleep)
+                mhpmcounter12_r <= mhpmcounter12_r + 1;
 
             // --- Trap Entry (highest priority over CSR writes) ---
             // Per Privileged Spec §3.1.6.1:
@@ -294,12 +453,26 @@ module z_core_csr_file #(
             //   MPIE    <- MIE
             //   MIE     <- 0 (disable interrupts)
             //   MPP     <- M (hardwired, no change needed)
+            // Interrupts also switch to the shadow bank when SHADOW is set;
+            // exceptions stay on the current one (ecall arguments).
             if (trap_enter) begin
                 mepc_r         <= trap_mepc & 32'hFFFFFFFC; // Enforce alignment
                 mcause_r       <= trap_mcause;
                 mtval_r        <= trap_mtval;
                 mstatus_mpie_r <= mstatus_mie_r;
                 mstatus_mie_r  <= 1'b0;
+                mzcfg_pbank    <= mzcfg_bank;
+                if (trap_mcause[31] && mzcfg_shadow)
+                    mzcfg_bank <= 1'b1;
+            end
+
+            // --- Tail-chained MRET ---
+            // Same state as MRET followed by the interrupt: mepc, MPIE
+            // and PBANK are unchanged, MIE stays 0
+            else if (chain_exec) begin
+                mcause_r       <= chain_mcause;
+                mtval_r        <= 32'h0;
+                mzcfg_bank     <= mzcfg_shadow | mzcfg_pbank;
             end
 
             // --- MRET Execution ---
@@ -310,6 +483,7 @@ module z_core_csr_file #(
             else if (mret_exec) begin
                 mstatus_mie_r  <= mstatus_mpie_r;
                 mstatus_mpie_r <= 1'b1;
+                mzcfg_bank     <= mzcfg_pbank;
             end
 
             // --- Normal CSR Write (from CSRRW/CSRRS/CSRRC) ---
@@ -356,6 +530,37 @@ module z_core_csr_file #(
                     ADDR_MINSTRETH: begin
                         minstret_r[63:32] <= csr_write_data;
                     end
+                    ADDR_MHPMCOUNTER3: begin
+                        mhpmcounter3_r[31:0] <= csr_write_data;
+                    end
+                    ADDR_MHPMCOUNTER3H: begin
+                        mhpmcounter3_r[63:32] <= csr_write_data;
+                    end
+                    ADDR_MHPMCOUNTER10: begin
+                        mhpmcounter10_r[31:0] <= csr_write_data;
+                    end
+                    ADDR_MHPMCOUNTER10H: begin
+                        mhpmcounter10_r[63:32] <= csr_write_data;
+                    end
+                    ADDR_MHPMCOUNTER11: begin
+                        mhpmcounter11_r[31:0] <= csr_write_data;
+                    end
+                    ADDR_MHPMCOUNTER11H: begin
+                        mhpmcounter11_r[63:32] <= csr_write_data;
+                    end
+                    ADDR_MHPMCOUNTER12: begin
+                        mhpmcounter12_r[31:0] <= csr_write_data;
+                    end
+                    ADDR_MHPMCOUNTER12H: begin
+                        mhpmcounter12_r[63:32] <= csr_write_data;
+                    end
+                    ADDR_MZCFG: begin
+                        mzcfg_misalign_trap <= csr_write_data[0];
+                        mzcfg_shadow        <= csr_write_data[1] && SHADOW_REGS;
+                    end
+                    ADDR_MZICADDR: begin
+                        mzicaddr_r <= {csr_write_data[31:2], 2'b00};
+                    end
                     // default: ignore writes to unknown/read-only CSRs
                 endcase
             end
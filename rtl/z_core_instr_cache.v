@@ -1,25 +1,43 @@
 module z_core_instr_cache #(
     parameter DATA_WIDTH = 32,
     parameter ADDR_WIDTH = 32,
-    parameter CACHE_DEPTH = 256
+    parameter CACHE_DEPTH = 256,
+    parameter PD_WIDTH = ADDR_WIDTH + 2   // Predecode bits stored per line
 ) (
     input wire clk,
     input wire rstn,
     input wire wen,
+    input wire wlock,                     // Lock the line written (preload)
+    input wire inval,                     // Invalidate every unlocked line
+    input wire unlock,                    // Clear every lock bit
     input wire [ADDR_WIDTH-1:0] addr_rd,
     input wire [ADDR_WIDTH-1:0] addr_wr,
     input wire [DATA_WIDTH-1:0] data_in,
     output wire [DATA_WIDTH-1:0] data_out,
 
+    // Predecode side-band, written with the line and read on Port A
+    input wire [PD_WIDTH-1:0] pd_in,
+    output wire [PD_WIDTH-1:0] pd_out,
+
     output wire valid,
     output wire cache_hit,
-    output wire cache_miss
+    output wire cache_miss,
+
+    // Second read port (next sequential word, dual-issue fetch)
+    input wire [ADDR_WIDTH-1:0] addr_rd2,
+    output wire [DATA_WIDTH-1:0] data_out2,
+    output wire cache_hit2
 );
 
 // **************************************************
 //      Dual-Port Instruction Cache (256x32)
 //      Port A: Asynchronous Read (Fetch)
+//      Port C: Asynchronous Read (Fetch, PC + 4)
 //      Port B: Synchronous Write (Memory Fill)
+//
+//      A locked line is only replaced by another
+//      locked write; ordinary fills that map to it
+//      are dropped, so that address runs uncached.
 // **************************************************
 
 localparam CACHE_ADDR_WIDTH = $clog2(CACHE_DEPTH);
@@ -28,16 +46,26 @@ localparam CACHE_TAG_WIDTH = ADDR_WIDTH - 2 - CACHE_ADDR_WIDTH;
 reg [DATA_WIDTH-1:0] instr_cache [CACHE_DEPTH-1:0];
 reg [CACHE_TAG_WIDTH-1:0] instr_cache_tag [CACHE_DEPTH-1:0];
 reg [CACHE_DEPTH-1:0] instr_cache_valid;
+reg [CACHE_DEPTH-1:0] instr_cache_lock;
+reg [PD_WIDTH-1:0] instr_cache_pd [CACHE_DEPTH-1:0];
 
 // Port A: Read Logic
 wire [CACHE_TAG_WIDTH-1:0] tag_rd = addr_rd[ADDR_WIDTH-1:ADDR_WIDTH-CACHE_TAG_WIDTH];
 wire [CACHE_ADDR_WIDTH-1:0] index_rd = addr_rd[CACHE_ADDR_WIDTH+1:2];
 
 assign data_out = instr_cache[index_rd];
+assign pd_out = instr_cache_pd[index_rd];
 assign cache_hit = (instr_cache_tag[index_rd] == tag_rd) && instr_cache_valid[index_rd];
 assign cache_miss = !((instr_cache_tag[index_rd] == tag_rd) && instr_cache_valid[index_rd]);
 assign valid = (instr_cache_tag[index_rd] == tag_rd) && instr_cache_valid[index_rd];
 
+// Port C: Second Read Logic
+wire [CACHE_TAG_WIDTH-1:0] tag_rd2 = addr_rd2[ADDR_WIDTH-1:ADDR_WIDTH-CACHE_TAG_WIDTH];
+wire [CACHE_ADDR_WIDTH-1:0] index_rd2 = addr_rd2[CACHE_ADDR_WIDTH+1:2];
+
+assign data_out2 = instr_cache[index_rd2];
+assign cache_hit2 = (instr_cache_tag[index_rd2] == tag_rd2) && instr_cache_valid[index_rd2];
+
 // Port B: Write Logic
 wire [CACHE_TAG_WIDTH-1:0] tag_wr = addr_wr[ADDR_WIDTH-1:ADDR_WIDTH-CACHE_TAG_WIDTH];
 wire [CACHE_ADDR_WIDTH-1:0] index_wr = addr_wr[CACHE_ADDR_WIDTH+1:2];
@@ -45,10 +73,20 @@ wire [CACHE_ADDR_WIDTH-1:0] index_wr = addr_wr[CACHE_ADDR_WIDTH+1:2];
 always @(posedge clk) begin
     if (!rstn) begin
         instr_cache_valid <= {CACHE_DEPTH{1'b0}};
-    end else if (wen) begin
-        instr_cache[index_wr] <= data_in;
-        instr_cache_tag[index_wr] <= tag_wr;
-        instr_cache_valid[index_wr] <= 1'b1;
+        instr_cache_lock <= {CACHE_DEPTH{1'b0}};
+    end else begin
+        if (unlock)
+            instr_cache_lock <= {CACHE_DEPTH{1'b0}};
+        if (inval)
+            instr_cache_valid <= instr_cache_valid & (unlock ? {CACHE_DEPTH{1'b0}} : instr_cache_lock);
+        if (wen && (wlock || !instr_cache_lock[index_wr])) begin
+            instr_cache[index_wr] <= data_in;
+            instr_cache_pd[index_wr] <= pd_in;
+            instr_cache_tag[index_wr] <= tag_wr;
+            instr_cache_valid[index_wr] <= 1'b1;
+            if (wlock)
+                instr_cache_lock[index_wr] <= 1'b1;
+        end
     end
 end
 
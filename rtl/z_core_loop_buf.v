@@ -0,0 +1,251 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// **************************************************
+//              Z-Core Loop Buffer
+//
+// Holds the body of one short loop (up to DEPTH words
+// closed by a backward conditional branch) and
+// supplies it to fetch instead of the I-cache and the
+// BTB.
+//
+//   arm      a taken backward branch within DEPTH-1
+//            words resolves in EX
+//   capture  the body words are copied as fetch reads
+//            them from the I-cache; a jump or another
+//            backward branch in the body abandons the
+//            capture (forward branches are allowed)
+//   replay   once every word is present, fetch reads
+//            the loop from here and the closing branch
+//            loops back with no bubble
+//
+// Exit prediction: fetch counts the loop-backs of the
+// current visit and tags every instruction it supplies
+// with the count. The branch that leaves the loop (the
+// closing branch falling through, or a forward branch
+// out of the body) reports its tag and slot from EX.
+// Once two visits in a row leave at the same count and
+// slot, that branch is predicted to exit there. A
+// redirect by a buffered instruction resynchronizes
+// the count from its tag; any other redirect restarts
+// it.
+//
+// An active loop that is still being fetched from is
+// only replaced after a second arm attempt, so an outer
+// loop cannot evict the inner loop it contains.
+// **************************************************
+
+module z_core_loop_buf #(
+    parameter DEPTH     = 8,        // Body words (power of two)
+    parameter CNT_WIDTH = 16        // Trip count bits
+)(
+    input  wire                 clk,
+    input  wire                 rstn,
+
+    // Lookup (IF)
+    input  wire [31:0]          fetch_addr,
+    output wire                 hit,            // fetch_addr is inside the loop
+    output wire [31:0]          inst0,          // Word at fetch_addr
+    output wire [31:0]          inst1,          // Word at fetch_addr + 4
+    output wire                 hit2,           // inst1 is inside the loop too
+    output wire                 pred_taken,     // inst0 is a branch predicted taken
+    output wire [31:0]          pred_target,
+    output wire [CNT_WIDTH-1:0] iter,           // Loop-backs fetched this visit
+    input  wire                 take,           // IF took inst0 (and inst1) from here
+
+    // Capture (IF, I-cache hit at fetch_addr)
+    input  wire                 cap_en,
+    input  wire [31:0]          cap_inst0,
+    input  wire [31:0]          cap_inst1,
+    input  wire                 cap_hit2,
+
+    // Conditional branch resolved in EX
+    input  wire                 br_valid,
+    input  wire                 br_taken,
+    input  wire [31:0]          br_pc,
+    input  wire [31:0]          br_target,
+    input  wire                 br_from_lb,     // Fetched from the buffer
+    input  wire [CNT_WIDTH-1:0] br_iter,        // ... with this tag
+
+    // Fetch redirect (EX flush or ID early resolution)
+    input  wire                 redirect,
+    input  wire                 redirect_lb,    // Caused by a buffered instruction
+    input  wire [CNT_WIDTH-1:0] redirect_iter,  // ... with this tag
+    input  wire [31:0]          redirect_pc,
+
+    // I-cache invalidate: the captured body may be stale
+    input  wire                 inval
+);
+
+    localparam IDX_W = $clog2(DEPTH);
+    localparam B_INST    = 7'b1100011;
+    localparam JAL_INST  = 7'b1101111;
+    localparam JALR_INST = 7'b1100111;
+    localparam [CNT_WIDTH-1:0] CNT_MAX = {CNT_WIDTH{1'b1}};
+
+    reg [31:0]          body [0:DEPTH-1];
+    reg [DEPTH-1:0]     filled;
+    reg                 capturing;
+    reg                 active;
+    reg                 hot;            // Supplied fetch since the last declined arm
+    reg [31:0]          start;
+    reg [IDX_W-1:0]     last;           // Index of the closing branch
+    reg [CNT_WIDTH-1:0] fetch_cnt;
+    reg [CNT_WIDTH-1:0] trip;           // Loop-backs before the last exit
+    reg [IDX_W-1:0]     exit_slot;      // Branch that took it
+    reg [31:0]          exit_target;    // ... and where it went
+    reg                 trip_conf;      // Two visits in a row agreed
+
+    // Slot of an address, and whether it lies inside the loop
+    function [IDX_W:0] slot_of(input [31:0] addr);
+        reg [31:0] off;
+        begin
+            off = addr - start;
+            slot_of = {(off[1:0] == 2'b00) && (off[31:IDX_W+2] == 0) && (off[IDX_W+1:2] <= last),
+                       off[IDX_W+1:2]};
+        end
+    endfunction
+
+    // ---- Lookup ----
+    wire [IDX_W:0]   fslot    = slot_of(fetch_addr);
+    wire             in_loop  = fslot[IDX_W];
+    wire [IDX_W-1:0] idx      = fslot[IDX_W-1:0];
+    wire             exit_now = trip_conf && fetch_cnt == trip && idx == exit_slot;
+
+    assign hit         = active && in_loop;
+    assign inst0       = body[idx];
+    assign inst1       = body[idx + 1'b1];
+    assign hit2        = (idx != last);
+    assign pred_taken  = exit_now ? (exit_slot != last) : (idx == last);
+    assign pred_target = exit_now ? exit_target : start;
+    assign iter        = fetch_cnt;
+
+    // ---- Capture ----
+    // The closing slot holds the backward branch; the others may hold
+    // forward branches but no jumps or inner loops
+    function slot_ok(input [31:0] w, input is_last);
+        slot_ok = is_last ? (w[6:0] == B_INST) :
+                  !((w[6:0] == B_INST && w[31]) || w[6:0] == JAL_INST || w[6:0] == JALR_INST);
+    endfunction
+
+    wire             cap0    = capturing && in_loop && cap_en;
+    wire             cap1    = cap0 && cap_hit2 && (idx != last);
+    wire [IDX_W-1:0] idx1    = idx + 1'b1;
+    wire             cap_bad = (cap0 && !slot_ok(cap_inst0, idx == last)) ||
+                               (cap1 && !slot_ok(cap_inst1, idx1 == last));
+
+    wire [DEPTH-1:0] need        = {DEPTH{1'b1}} >> (DEPTH - 1 - last);
+    wire [DEPTH-1:0] filled_next = filled | (cap0 ? (1 << idx) : 0) | (cap1 ? (1 << idx1) : 0);
+
+    // ---- Arm ----
+    wire [31:0] dist      = br_pc - br_target;
+    wire        short_bwd = (dist[1:0] == 2'b00) && (dist[31:IDX_W+2] == 0);
+    wire        same      = (capturing || active) && start == br_target && last == dist[IDX_W+1:2];
+    wire        arm_req   = br_valid && br_taken && !br_from_lb && short_bwd && !same;
+    wire        arm       = arm_req && !(active && hot);
+
+    // ---- Exit (buffered branch leaving the loop) ----
+    wire [IDX_W:0]   bslot   = slot_of(br_pc);
+    wire [IDX_W:0]   tslot   = slot_of(br_target);
+    wire             br_exit = br_valid && br_from_lb && active && bslot[IDX_W] &&
+                               (bslot[IDX_W-1:0] == last ? !br_taken : (br_taken && !tslot[IDX_W]));
+
+    // ---- Redirect ----
+    wire [IDX_W:0]   rslot   = slot_of(redirect_pc);
+
+    integer i;
+    always @(posedge clk) begin
+        if (!rstn) begin
+            filled      <= {DEPTH{1'b0}};
+            capturing   <= 1'b0;
+            active      <= 1'b0;
+            hot         <= 1'b0;
+            start       <= 32'b0;
+            last        <= {IDX_W{1'b0}};
+            fetch_cnt   <= {CNT_WIDTH{1'b0}};
+            trip        <= {CNT_WIDTH{1'b0}};
+            exit_slot   <= {IDX_W{1'b0}};
+            exit_target <= 32'b0;
+            trip_conf   <= 1'b0;
+            for (i = 0; i < DEPTH; i = i + 1)
+                body[i] <= 32'b0;
+        end else if (inval) begin
+            capturing   <= 1'b0;
+            active      <= 1'b0;
+            hot         <= 1'b0;
+        end else if (arm) begin
+            start     <= br_target;
+            last      <= dist[IDX_W+1:2];
+            filled    <= {DEPTH{1'b0}};
+            capturing <= 1'b1;
+            active    <= 1'b0;
+            hot       <= 1'b0;
+            trip      <= CNT_MAX;
+            trip_conf <= 1'b0;
+        end else begin
+            if (arm_req)
+                hot <= 1'b0;
+
+            if (cap0)
+                body[idx] <= cap_inst0;
+            if (cap1)
+                body[idx1] <= cap_inst1;
+            if (cap_bad) begin
+                capturing <= 1'b0;
+            end else if (capturing) begin
+                filled <= filled_next;
+                if ((filled_next & need) == need) begin
+                    capturing <= 1'b0;
+                    active    <= 1'b1;
+                    fetch_cnt <= {CNT_WIDTH{1'b0}};
+                end
+            end
+
+            if (br_exit) begin
+                trip        <= br_iter;
+                exit_slot   <= bslot[IDX_W-1:0];
+                exit_target <= br_taken ? br_target : br_pc + 32'd4;
+                trip_conf   <= (br_iter == trip) && (bslot[IDX_W-1:0] == exit_slot) &&
+                               (br_iter != CNT_MAX);
+            end
+
+            if (redirect) begin
+                // Back to the top: one more loop-back; inside: same visit
+                if (!redirect_lb || !rslot[IDX_W])
+                    fetch_cnt <= {CNT_WIDTH{1'b0}};
+                else if (rslot[IDX_W-1:0] == 0)
+                    fetch_cnt <= redirect_iter + (redirect_iter != CNT_MAX);
+                else
+                    fetch_cnt <= redirect_iter;
+            end else if (take) begin
+                hot <= 1'b1;
+                if (exit_now)
+                    fetch_cnt <= {CNT_WIDTH{1'b0}};
+                else if (idx == last)
+                    fetch_cnt <= fetch_cnt + (fetch_cnt != CNT_MAX);
+            end
+        end
+    end
+
+endmodule
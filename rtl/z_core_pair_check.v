@@ -0,0 +1,92 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// **************************************************
+//          Z-Core Dual-Issue Pairing Rules
+//
+// Decides at fetch whether two sequential instructions
+// (inst0 at PC, inst1 at PC + 4) can issue together.
+//
+// Lane 0 (older) takes anything that does not redirect
+// or serialize the pipeline: ALU, MUL/DIV, load/store,
+// conditional branch, LUI/AUIPC and packed-SIMD.
+//
+// Lane 1 (younger) only has an ALU: R/I-type ALU ops
+// (no DIV/REM), LUI/AUIPC and packed-SIMD.
+//
+// Pairs are rejected when inst1 reads the register
+// inst0 writes (no intra-pair forwarding). A WAW pair
+// is allowed: lane 1 has write priority.
+// **************************************************
+
+module z_core_pair_check (
+    input  [31:0] inst0,
+    input  [31:0] inst1,
+    output        can_pair
+);
+
+localparam R_INST       = 7'b0110011;
+localparam I_INST       = 7'b0010011;
+localparam I_LOAD_INST  = 7'b0000011;
+localparam S_INST       = 7'b0100011;
+localparam B_INST       = 7'b1100011;
+localparam LUI_INST     = 7'b0110111;
+localparam AUIPC_INST   = 7'b0010111;
+localparam CUSTOM0_INST = 7'b0001011;
+localparam CUSTOM1_INST = 7'b0101011;
+
+wire [6:0] op0 = inst0[6:0];
+wire [6:0] op1 = inst1[6:0];
+wire [4:0] rd0 = inst0[11:7];
+wire [4:0] rs1_1 = inst1[19:15];
+wire [4:0] rs2_1 = inst1[24:20];
+
+// Lane 0 eligibility
+wire lane0_ok = (op0 == R_INST) || (op0 == I_INST) || (op0 == I_LOAD_INST) ||
+                (op0 == S_INST) || (op0 == B_INST) || (op0 == LUI_INST) ||
+                (op0 == AUIPC_INST) || (op0 == CUSTOM0_INST) || (op0 == CUSTOM1_INST);
+
+wire lane0_writes = (op0 == R_INST) || (op0 == I_INST) || (op0 == I_LOAD_INST) ||
+                    (op0 == LUI_INST) || (op0 == AUIPC_INST) ||
+                    (op0 == CUSTOM0_INST) || (op0 == CUSTOM1_INST);
+
+// Lane 1 eligibility (DIV/DIVU/REM/REMU: funct7 = 0000001, funct3[2] = 1)
+wire inst1_is_div = (op1 == R_INST) && (inst1[31:25] == 7'b0000001) && inst1[14];
+
+wire lane1_ok = ((op1 == R_INST) && !inst1_is_div) || (op1 == I_INST) ||
+                (op1 == LUI_INST) || (op1 == AUIPC_INST) ||
+                (op1 == CUSTOM0_INST) || (op1 == CUSTOM1_INST);
+
+wire lane1_reads_rs1 = (op1 == R_INST) || (op1 == I_INST) ||
+                       (op1 == CUSTOM0_INST) || (op1 == CUSTOM1_INST);
+wire lane1_reads_rs2 = (op1 == R_INST) || (op1 == CUSTOM0_INST);
+
+// Read-after-write inside the pair
+wire raw_hazard = lane0_writes && (rd0 != 5'b0) &&
+                  ((lane1_reads_rs1 && rs1_1 == rd0) ||
+                   (lane1_reads_rs2 && rs2_1 == rd0));
+
+assign can_pair = lane0_ok && lane1_ok && !raw_hazard;
+
+endmodule
@@ -0,0 +1,58 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// **************************************************
+//            Z-Core Fetch Predecoder
+//
+// Runs on the instruction word being filled into the
+// I-cache. Marks JAL and conditional branches and
+// precomputes their PC-relative targets so fetch can
+// redirect without waiting for EX.
+// **************************************************
+
+module z_core_predecode (
+    input  [31:0] inst,
+    input  [31:0] pc,
+    output        is_jal,
+    output        is_bwd_branch,   // Conditional branch with a negative offset
+    output [31:0] target
+);
+
+    localparam B_INST   = 7'b1100011;
+    localparam JAL_INST = 7'b1101111;
+
+    wire is_branch = (inst[6:0] == B_INST);
+    assign is_jal  = (inst[6:0] == JAL_INST);
+
+    // B-type: imm[12|10:5|4:1|11] = inst[31|30:25|11:8|7], sign-extended
+    wire [31:0] Bimm = {{20{inst[31]}}, inst[7], inst[30:25], inst[11:8], 1'b0};
+    // J-type: imm[20|10:1|11|19:12] = inst[31|30:21|20|19:12], sign-extended
+    wire [31:0] Jimm = {{12{inst[31]}}, inst[19:12], inst[20], inst[30:21], 1'b0};
+
+    // Sign bit is inst[31] for both formats
+    assign is_bwd_branch = is_branch && inst[31];
+
+    assign target = pc + (is_jal ? Jimm : Bimm);
+
+endmodule
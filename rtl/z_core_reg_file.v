@@ -22,7 +22,9 @@ SOFTWARE.
 
 */
 
-module z_core_reg_file(
+module z_core_reg_file #(
+    parameter SHADOW = 0    // 1: second bank of the caller-saved registers
+) (
     // Inputs
     input clk,
     input [4:0] rd,
@@ -31,6 +33,7 @@ module z_core_reg_file(
     input [4:0] rs2,
     input write_enable,
     input reset,
+    input bank,             // Use the shadow bank (ignored when SHADOW = 0)
 
     // Outputs
     output [31:0] rs1_out,
@@ -71,6 +74,25 @@ module z_core_reg_file(
     reg [31:0] reg_r30_q;
     reg [31:0] reg_r31_q;
 
+    // Shadow bank: ra, t0-t6 and a0-a7 (x1, x5-x7, x10-x17, x28-x31)
+    // have a second copy, selected by bank. An interrupt handler runs on
+    // it and needs no spill; sp, gp, tp and s0-s11 stay shared.
+
+    function banked;
+        input [4:0] r;
+        banked = r == 5'd1 || (r >= 5'd5 && r <= 5'd7) ||
+                 (r >= 5'd10 && r <= 5'd17) || r >= 5'd28;
+    endfunction
+
+    function [3:0] shadow_idx;
+        input [4:0] r;
+        shadow_idx = r == 5'd1  ? 4'd0 :
+                     r <= 5'd7  ? r - 5'd4 :
+                     r <= 5'd17 ? r - 5'd6 :
+                                  r - 5'd16;
+    endfunction
+
+    wire wr_shadow = SHADOW && bank && banked(rd);
 
      /* Synchronous read */
 
@@ -108,7 +130,7 @@ module z_core_reg_file(
             reg_r30_q <= 32'b0;
             reg_r31_q <= 32'b0;
         end
-        else if (write_enable) begin
+        else if (write_enable && !wr_shadow) begin
             if(rd == 5'h1) reg_r1_q <= rd_in;
             if(rd == 5'h2) reg_r2_q <= rd_in;
             if(rd == 5'h3) reg_r3_q <= rd_in;
@@ -222,7 +244,26 @@ module z_core_reg_file(
         endcase
     end
 
-assign rs1_out = rs1_reg;
-assign rs2_out = rs2_reg;
+    generate
+    if (SHADOW) begin : g_shadow
+        reg [31:0] shadow_q [0:15];
+        integer i;
+
+        always @(posedge clk) begin
+            if (reset) begin
+                for (i = 0; i < 16; i = i + 1)
+                    shadow_q[i] <= 32'b0;
+            end else if (write_enable && wr_shadow) begin
+                shadow_q[shadow_idx(rd)] <= rd_in;
+            end
+        end
+
+        assign rs1_out = (bank && banked(rs1)) ? shadow_q[shadow_idx(rs1)] : rs1_reg;
+        assign rs2_out = (bank && banked(rs2)) ? shadow_q[shadow_idx(rs2)] : rs2_reg;
+    end else begin : g_no_shadow
+        assign rs1_out = rs1_reg;
+        assign rs2_out = rs2_reg;
+    end
+    endgenerate
 
 endmodule
\ No newline at end of file
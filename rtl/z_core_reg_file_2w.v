@@ -0,0 +1,123 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// **************************************************
+//        Z-Core Register File (4-Read / 2-Write)
+//
+// Dual-issue variant of z_core_reg_file. Lane 0 is
+// the older instruction of an issue pair; when both
+// lanes write the same register, lane 1 (younger)
+// wins.
+//
+// SHADOW = 1 adds the same shadow bank of the
+// caller-saved registers as z_core_reg_file.
+// **************************************************
+
+module z_core_reg_file_2w #(
+    parameter SHADOW = 0    // 1: second bank of the caller-saved registers
+) (
+    // Inputs
+    input clk,
+    input reset,
+    input bank,             // Use the shadow bank (ignored when SHADOW = 0)
+
+    // Write port 0 (lane 0)
+    input [4:0] rd0,
+    input [31:0] rd0_in,
+    input write_enable0,
+
+    // Write port 1 (lane 1)
+    input [4:0] rd1,
+    input [31:0] rd1_in,
+    input write_enable1,
+
+    // Read ports (lane 0: rs1/rs2, lane 1: rs3/rs4)
+    input [4:0] rs1,
+    input [4:0] rs2,
+    input [4:0] rs3,
+    input [4:0] rs4,
+
+    // Outputs
+    output [31:0] rs1_out,
+    output [31:0] rs2_out,
+    output [31:0] rs3_out,
+    output [31:0] rs4_out
+);
+
+    reg [31:0] regs [1:31];
+    reg [31:0] shadow [0:15];
+    integer i;
+
+    // Shadow bank: x1, x5-x7, x10-x17, x28-x31 (see z_core_reg_file)
+    function banked;
+        input [4:0] r;
+        banked = r == 5'd1 || (r >= 5'd5 && r <= 5'd7) ||
+                 (r >= 5'd10 && r <= 5'd17) || r >= 5'd28;
+    endfunction
+
+    function [3:0] shadow_idx;
+        input [4:0] r;
+        shadow_idx = r == 5'd1  ? 4'd0 :
+                     r <= 5'd7  ? r - 5'd4 :
+                     r <= 5'd17 ? r - 5'd6 :
+                                  r - 5'd16;
+    endfunction
+
+    wire sh0 = SHADOW && bank && banked(rd0);
+    wire sh1 = SHADOW && bank && banked(rd1);
+
+    /* Synchronous write */
+
+    always @(posedge clk) begin
+        if (reset) begin
+            for (i = 1; i < 32; i = i + 1)
+                regs[i] <= 32'b0;
+        end else begin
+            if (write_enable0 && rd0 != 5'h0 && !sh0 && !(write_enable1 && rd1 == rd0))
+                regs[rd0] <= rd0_in;
+            if (write_enable1 && rd1 != 5'h0 && !sh1)
+                regs[rd1] <= rd1_in;
+        end
+    end
+
+    always @(posedge clk) begin
+        if (reset) begin
+            for (i = 0; i < 16; i = i + 1)
+                shadow[i] <= 32'b0;
+        end else begin
+            if (write_enable0 && sh0 && !(write_enable1 && rd1 == rd0))
+                shadow[shadow_idx(rd0)] <= rd0_in;
+            if (write_enable1 && sh1)
+                shadow[shadow_idx(rd1)] <= rd1_in;
+        end
+    end
+
+    /* Asynchronous read */
+
+    assign rs1_out = (rs1 == 5'h0) ? 32'd0 : (SHADOW && bank && banked(rs1)) ? shadow[shadow_idx(rs1)] : regs[rs1];
+    assign rs2_out = (rs2 == 5'h0) ? 32'd0 : (SHADOW && bank && banked(rs2)) ? shadow[shadow_idx(rs2)] : regs[rs2];
+    assign rs3_out = (rs3 == 5'h0) ? 32'd0 : (SHADOW && bank && banked(rs3)) ? shadow[shadow_idx(rs3)] : regs[rs3];
+    assign rs4_out = (rs4 == 5'h0) ? 32'd0 : (SHADOW && bank && banked(rs4)) ? shadow[shadow_idx(rs4)] : regs[rs4];
+
+endmodule
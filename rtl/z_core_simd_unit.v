@@ -0,0 +1,145 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ============================================================================
+// Packed-SIMD Unit
+// 4 x 8-bit lanes, operating on 3-3-2 (RRRGGGBB) pixels
+//
+// Custom-0 (R-type) / Custom-1 (I-type) opcode group, decoded in
+// z_core_alu_ctrl and selected here with simd_op:
+//
+//   PADDUSB  : per-byte unsigned add, saturating at 0xFF
+//   PSUBUSB  : per-byte unsigned subtract, saturating at 0x00
+//   PCMPEQB  : per-byte 0xFF if equal, else 0x00
+//   PCMPLTUB : per-byte 0xFF if in1 < in2 (unsigned), else 0x00
+//   PMINUB   : per-byte unsigned minimum
+//   PMAXUB   : per-byte unsigned maximum
+//   PSELNZB  : per-byte in1 if non-zero, else in2 (color-key sprite overlay)
+//   PSHUFB   : byte shuffle, lane i = in1 byte in2[2i+1:2i]
+//   PAVG332  : per-channel 1/2 + 1/2 blend of 3-3-2 colors
+//   PBLD332  : per-channel 3/4 in1 + 1/4 in2 blend of 3-3-2 colors
+//   PADDS332 : per-channel saturating add of 3-3-2 colors
+//   PSUBS332 : per-channel saturating subtract of 3-3-2 colors
+// ============================================================================
+
+module z_core_simd_unit (
+    input  [31:0] simd_in1,
+    input  [31:0] simd_in2,
+    input  [3:0]  simd_op,
+    output [31:0] simd_out
+);
+
+localparam SIMD_PADDUSB  = 4'd0;
+localparam SIMD_PSUBUSB  = 4'd1;
+localparam SIMD_PCMPEQB  = 4'd2;
+localparam SIMD_PCMPLTUB = 4'd3;
+localparam SIMD_PMINUB   = 4'd4;
+localparam SIMD_PMAXUB   = 4'd5;
+localparam SIMD_PSELNZB  = 4'd6;
+localparam SIMD_PSHUFB   = 4'd7;
+localparam SIMD_PAVG332  = 4'd8;
+localparam SIMD_PBLD332  = 4'd9;
+localparam SIMD_PADDS332 = 4'd10;
+localparam SIMD_PSUBS332 = 4'd11;
+
+// ============================================================================
+// Per-Lane Results
+// ============================================================================
+wire [31:0] paddusb_v, psubusb_v, pcmpeqb_v, pcmpltub_v;
+wire [31:0] pminub_v, pmaxub_v, pselnzb_v, pshufb_v;
+wire [31:0] pavg332_v, pbld332_v, padds332_v, psubs332_v;
+
+genvar i;
+generate
+    for (i = 0; i < 4; i = i + 1) begin : lane
+        wire [7:0] a = simd_in1[8*i +: 8];
+        wire [7:0] b = simd_in2[8*i +: 8];
+
+        // Byte arithmetic
+        wire [8:0] sum  = {1'b0, a} + {1'b0, b};
+        wire [8:0] diff = {1'b0, a} - {1'b0, b};
+
+        assign paddusb_v[8*i +: 8]  = sum[8]  ? 8'hFF : sum[7:0];
+        assign psubusb_v[8*i +: 8]  = diff[8] ? 8'h00 : diff[7:0];
+        assign pcmpeqb_v[8*i +: 8]  = (a == b) ? 8'hFF : 8'h00;
+        assign pcmpltub_v[8*i +: 8] = (a < b)  ? 8'hFF : 8'h00;
+        assign pminub_v[8*i +: 8]   = (a < b)  ? a : b;
+        assign pmaxub_v[8*i +: 8]   = (a < b)  ? b : a;
+        assign pselnzb_v[8*i +: 8]  = (|a)     ? a : b;
+
+        // Byte shuffle: 2-bit source selector per destination lane
+        wire [1:0] sel = simd_in2[2*i +: 2];
+        assign pshufb_v[8*i +: 8] = simd_in1[8*sel +: 8];
+
+        // 3-3-2 channel split
+        wire [2:0] ar = a[7:5], ag = a[4:2];
+        wire [1:0] ab = a[1:0];
+        wire [2:0] br = b[7:5], bg = b[4:2];
+        wire [1:0] bb = b[1:0];
+
+        // 1/2 + 1/2 blend
+        wire [3:0] avg_r = ar + br;
+        wire [3:0] avg_g = ag + bg;
+        wire [2:0] avg_b = ab + bb;
+        assign pavg332_v[8*i +: 8] = {avg_r[3:1], avg_g[3:1], avg_b[2:1]};
+
+        // 3/4 + 1/4 blend: (3a + b) / 4
+        wire [4:0] bld_r = {ar, 1'b0} + ar + br;
+        wire [4:0] bld_g = {ag, 1'b0} + ag + bg;
+        wire [3:0] bld_b = {ab, 1'b0} + ab + bb;
+        assign pbld332_v[8*i +: 8] = {bld_r[4:2], bld_g[4:2], bld_b[3:2]};
+
+        // Per-channel saturating add (additive light)
+        wire [3:0] add_r = ar + br;
+        wire [3:0] add_g = ag + bg;
+        wire [2:0] add_b = ab + bb;
+        assign padds332_v[8*i +: 8] = {add_r[3] ? 3'd7 : add_r[2:0],
+                                       add_g[3] ? 3'd7 : add_g[2:0],
+                                       add_b[2] ? 2'd3 : add_b[1:0]};
+
+        // Per-channel saturating subtract (fade)
+        assign psubs332_v[8*i +: 8] = {(ar > br) ? ar - br : 3'd0,
+                                       (ag > bg) ? ag - bg : 3'd0,
+                                       (ab > bb) ? ab - bb : 2'd0};
+    end
+endgenerate
+
+// ============================================================================
+// Result Select
+// ============================================================================
+assign simd_out = (simd_op == SIMD_PADDUSB)  ? paddusb_v  :
+                  (simd_op == SIMD_PSUBUSB)  ? psubusb_v  :
+                  (simd_op == SIMD_PCMPEQB)  ? pcmpeqb_v  :
+                  (simd_op == SIMD_PCMPLTUB) ? pcmpltub_v :
+                  (simd_op == SIMD_PMINUB)   ? pminub_v   :
+                  (simd_op == SIMD_PMAXUB)   ? pmaxub_v   :
+                  (simd_op == SIMD_PSELNZB)  ? pselnzb_v  :
+                  (simd_op == SIMD_PSHUFB)   ? pshufb_v   :
+                  (simd_op == SIMD_PAVG332)  ? pavg332_v  :
+                  (simd_op == SIMD_PBLD332)  ? pbld332_v  :
+                  (simd_op == SIMD_PADDS332) ? padds332_v :
+                  (simd_op == SIMD_PSUBS332) ? psubs332_v :
+                  32'd0;
+
+endmodule
@@ -25,8 +25,9 @@ SOFTWARE.
 // **************************************************
 //                    Z-Core Top Model
 // 
-// A complete RISC-V RV32I processor with AXI-Lite
-// memory interface.
+// A complete RISC-V RV32IMA processor with AXI-Lite
+// memory interface. NUM_HARTS cores share RAM and
+// the peripherals through the interconnect.
 //
 // **************************************************
 
@@ -37,6 +38,11 @@ module z_core_top #(
     parameter MEM_ADDR_WIDTH = 14,      // 16KB memory
     parameter N_GPIO = 16,
 	 parameter CACHE_DEPTH = 256,
+    parameter DUAL_ISSUE = 0,           // 1: dual-issue ALU pairs
+    parameter LOOP_BUF = 1,             // 1: loop buffer for short loops
+    parameter SHADOW_REGS = 1,          // 1: shadow register bank for interrupts
+    parameter NUM_HARTS = 1,            // Cores (1..4); see axil_hartctl
+    parameter BUS_MON = 1,              // 1: bus monitor counters (M7)
     parameter PIPELINE_OUTPUT = 0,
     parameter INIT_FILE_0 = "software/bootloader_byte0.mif",
     parameter INIT_FILE_1 = "software/bootloader_byte1.mif",
@@ -65,8 +71,41 @@ module z_core_top #(
 
     // Timer External Event
     input wire timer_ext_event_i
+`ifdef Z_CORE_TRACE
+    ,
+    // Commit trace and stall attribution (Verilator harness, see sim/)
+    output wire [1:0]  trace_valid,
+    output wire [63:0] trace_pc,
+    output wire [63:0] trace_insn,
+    output wire [9:0]  trace_rd,
+    output wire [1:0]  trace_rd_we,
+    output wire [63:0] trace_rd_data,
+    output wire        trace_irq,
+    output wire [31:0] trace_irq_epc,
+    output wire [31:0] trace_irq_cause,
+    output wire [5:0]  stall_cause,
+    // Bus monitor side-band read (word index into the M7 window)
+    input  wire [9:0]  busmon_idx,
+    output wire [31:0] busmon_data
+`endif
 );
 
+`ifndef Z_CORE_TRACE
+// Trace outputs are left unconnected on the FPGA build
+wire [1:0]  trace_valid;
+wire [63:0] trace_pc;
+wire [63:0] trace_insn;
+wire [9:0]  trace_rd;
+wire [1:0]  trace_rd_we;
+wire [63:0] trace_rd_data;
+wire        trace_irq;
+wire [31:0] trace_irq_epc;
+wire [31:0] trace_irq_cause;
+wire [5:0]  stall_cause;
+wire [9:0]  busmon_idx = 10'd0;
+wire [31:0] busmon_data;
+`endif
+
 wire rstn = KEY[0];
 
 
@@ -78,6 +117,13 @@ always @(posedge clk) heartbeat <= heartbeat + 1;
 
 wire cpu_halt;
 
+// DMA completion and VGA raster interrupts (shared on meip),
+// UART request lines
+wire dma_irq;
+wire vga_irq;
+wire uart_dma_rx_req;
+wire uart_dma_tx_req;
+
 // **************************************************
 //              AXI-Lite Interconnect Wires
 // **************************************************
@@ -89,8 +135,9 @@ wire cpu_halt;
 // **************************************************
 
 // Interconnect Parameters
-localparam S_COUNT = 1;
-localparam M_COUNT = 5;
+localparam S_COUNT = NUM_HARTS + 1;     // S0..S(NUM_HARTS-1): harts, then DMA
+localparam S_DMA   = NUM_HARTS;
+localparam M_COUNT = 8;
 localparam M_REGIONS = 1;
 
 // Address Map
@@ -99,8 +146,14 @@ localparam M_REGIONS = 1;
 // M2: GPIO   (0x0400_1000 - 0x0400_1FFF) 4KB
 // M3: Timer  (0x0400_2000 - 0x0400_2FFF) 4KB
 // M4: VGA    (0x0400_3000 - 0x0400_3FFF) 4KB
+// M5: DMA    (0x0400_4000 - 0x0400_4FFF) 4KB
+// M6: Harts  (0x0400_5000 - 0x0400_5FFF) 4KB
+// M7: BusMon (0x0400_6000 - 0x0400_6FFF) 4KB
 
 localparam [M_COUNT*ADDR_WIDTH-1:0] M_BASE_ADDR = {
+    32'h0400_6000, // M7: Bus monitor
+    32'h0400_5000, // M6: Hart control
+    32'h0400_4000, // M5: DMA
     32'h0400_3000, // M4: VGA
     32'h0400_2000, // M3: Timer
     32'h0400_1000, // M2: GPIO
@@ -109,6 +162,9 @@ localparam [M_COUNT*ADDR_WIDTH-1:0] M_BASE_ADDR = {
 };
 
 localparam [M_COUNT*32-1:0] M_ADDR_WIDTH_CONF = {
+    32'd12, // M7: BusMon (4KB = 2^12)
+    32'd12, // M6: Harts (4KB = 2^12)
+    32'd12, // M5: DMA   (4KB = 2^12)
     32'd12, // M4: VGA   (4KB = 2^12)
     32'd12, // M3: Timer (4KB = 2^12)
     32'd12, // M2: GPIO  (4KB = 2^12)
@@ -214,45 +270,167 @@ axil_interconnect #(
 );
 
 // **************************************************
-//                Control Unit (Master 0)
+//          Hart Control and LR/SC Monitor
+// **************************************************
+
+wire [NUM_HARTS-1:0]            hart_run;
+wire [31:0]                     hart_boot;
+
+wire [NUM_HARTS-1:0]            excl_rd;
+wire [NUM_HARTS-1:0]            excl_wr;
+wire [NUM_HARTS-1:0]            excl_fail;
+wire [NUM_HARTS*STRB_WIDTH-1:0] hart_wstrb;
+
+// Reservations for LR/SC/AMO; also gates the strobes of a failed SC
+axil_excl_monitor #(
+    .NUM_HARTS(NUM_HARTS),
+    .S_COUNT(S_COUNT),
+    .ADDR_WIDTH(ADDR_WIDTH),
+    .STRB_WIDTH(STRB_WIDTH)
+) u_excl_monitor (
+    .clk(clk),
+    .rstn(rstn),
+    .s_axil_awaddr(s_axil_awaddr),
+    .s_axil_awvalid(s_axil_awvalid),
+    .s_axil_awready(s_axil_awready),
+    .s_axil_araddr(s_axil_araddr),
+    .s_axil_arvalid(s_axil_arvalid),
+    .s_axil_arready(s_axil_arready),
+    .excl_rd(excl_rd),
+    .excl_wr(excl_wr),
+    .excl_fail(excl_fail),
+    .hart_wstrb(hart_wstrb),
+    .s_axil_wstrb(s_axil_wstrb[0 +: NUM_HARTS*STRB_WIDTH])
+);
+
+// **************************************************
+//          Control Unit (Hart 0, Master 0)
 // **************************************************
 
 z_core_control_u #(
     .DATA_WIDTH(DATA_WIDTH),
     .ADDR_WIDTH(ADDR_WIDTH),
     .STRB_WIDTH(STRB_WIDTH),
-    .CACHE_DEPTH(CACHE_DEPTH)
+    .CACHE_DEPTH(CACHE_DEPTH),
+    .DUAL_ISSUE(DUAL_ISSUE),
+    .LOOP_BUF(LOOP_BUF),
+    .SHADOW_REGS(SHADOW_REGS),
+    .HART_ID(0)
 ) u_control_unit (
     .clk(clk),
     .rstn(rstn),
+    .reset_pc(32'h0000_0000),
     
     // AXI-Lite Master Interface -> Interconnect Slave 0
-    .m_axil_awaddr(s_axil_awaddr),
-    .m_axil_awprot(s_axil_awprot),
-    .m_axil_awvalid(s_axil_awvalid),
-    .m_axil_awready(s_axil_awready),
-    .m_axil_wdata(s_axil_wdata),
-    .m_axil_wstrb(s_axil_wstrb),
-    .m_axil_wvalid(s_axil_wvalid),
-    .m_axil_wready(s_axil_wready),
-    .m_axil_bresp(s_axil_bresp),
-    .m_axil_bvalid(s_axil_bvalid),
-    .m_axil_bready(s_axil_bready),
-    .m_axil_araddr(s_axil_araddr),
-    .m_axil_arprot(s_axil_arprot),
-    .m_axil_arvalid(s_axil_arvalid),
-    .m_axil_arready(s_axil_arready),
-    .m_axil_rdata(s_axil_rdata),
-    .m_axil_rresp(s_axil_rresp),
-    .m_axil_rvalid(s_axil_rvalid),
-    .m_axil_rready(s_axil_rready),
+    .m_axil_awaddr(s_axil_awaddr[0*ADDR_WIDTH +: ADDR_WIDTH]),
+    .m_axil_awprot(s_axil_awprot[0*3 +: 3]),
+    .m_axil_awvalid(s_axil_awvalid[0]),
+    .m_axil_awready(s_axil_awready[0]),
+    .m_axil_wdata(s_axil_wdata[0*DATA_WIDTH +: DATA_WIDTH]),
+    .m_axil_wstrb(hart_wstrb[0*STRB_WIDTH +: STRB_WIDTH]),
+    .m_axil_wvalid(s_axil_wvalid[0]),
+    .m_axil_wready(s_axil_wready[0]),
+    .m_axil_bresp(s_axil_bresp[0*2 +: 2]),
+    .m_axil_bvalid(s_axil_bvalid[0]),
+    .m_axil_bready(s_axil_bready[0]),
+    .m_axil_araddr(s_axil_araddr[0*ADDR_WIDTH +: ADDR_WIDTH]),
+    .m_axil_arprot(s_axil_arprot[0*3 +: 3]),
+    .m_axil_arvalid(s_axil_arvalid[0]),
+    .m_axil_arready(s_axil_arready[0]),
+    .m_axil_rdata(s_axil_rdata[0*DATA_WIDTH +: DATA_WIDTH]),
+    .m_axil_rresp(s_axil_rresp[0*2 +: 2]),
+    .m_axil_rvalid(s_axil_rvalid[0]),
+    .m_axil_rready(s_axil_rready[0]),
 
     // Interrupt Inputs (directly wired)
-    .meip(1'b0),    // Machine External Interrupt - connect to external interrupt controller
+    .meip(dma_irq | vga_irq), // Machine External Interrupt - DMA completion / VGA raster
     .mtip(timer_irq), // Machine Timer Interrupt - Connected to timer peripheral
-    .msip(1'b0)     // Machine Software Interrupt - connect to software interrupt source
+    .msip(1'b0),    // Machine Software Interrupt - connect to software interrupt source
+
+    // LR/SC reservation
+    .excl_rd(excl_rd[0]),
+    .excl_wr(excl_wr[0]),
+    .excl_fail(excl_fail[0]),
+
+    // Commit Trace
+    .trace_valid(trace_valid),
+    .trace_pc(trace_pc),
+    .trace_insn(trace_insn),
+    .trace_rd(trace_rd),
+    .trace_rd_we(trace_rd_we),
+    .trace_rd_data(trace_rd_data),
+    .trace_irq(trace_irq),
+    .trace_irq_epc(trace_irq_epc),
+    .trace_irq_cause(trace_irq_cause),
+    .stall_cause(stall_cause)
 );
 
+// **************************************************
+//       Secondary Harts (Masters 1..NUM_HARTS-1)
+// **************************************************
+
+// Held in reset until released through HART_RUN, then start at
+// HART_BOOT. Interrupts go to hart 0 only; the commit trace follows
+// hart 0.
+genvar h;
+generate
+    for (h = 1; h < NUM_HARTS; h = h + 1) begin : g_hart
+        z_core_control_u #(
+            .DATA_WIDTH(DATA_WIDTH),
+            .ADDR_WIDTH(ADDR_WIDTH),
+            .STRB_WIDTH(STRB_WIDTH),
+            .CACHE_DEPTH(CACHE_DEPTH),
+            .DUAL_ISSUE(DUAL_ISSUE),
+            .LOOP_BUF(LOOP_BUF),
+            .SHADOW_REGS(SHADOW_REGS),
+            .HART_ID(h)
+        ) u_control_unit (
+            .clk(clk),
+            .rstn(rstn && hart_run[h]),
+            .reset_pc(hart_boot),
+
+            .m_axil_awaddr(s_axil_awaddr[h*ADDR_WIDTH +: ADDR_WIDTH]),
+            .m_axil_awprot(s_axil_awprot[h*3 +: 3]),
+            .m_axil_awvalid(s_axil_awvalid[h]),
+            .m_axil_awready(s_axil_awready[h]),
+            .m_axil_wdata(s_axil_wdata[h*DATA_WIDTH +: DATA_WIDTH]),
+            .m_axil_wstrb(hart_wstrb[h*STRB_WIDTH +: STRB_WIDTH]),
+            .m_axil_wvalid(s_axil_wvalid[h]),
+            .m_axil_wready(s_axil_wready[h]),
+            .m_axil_bresp(s_axil_bresp[h*2 +: 2]),
+            .m_axil_bvalid(s_axil_bvalid[h]),
+            .m_axil_bready(s_axil_bready[h]),
+            .m_axil_araddr(s_axil_araddr[h*ADDR_WIDTH +: ADDR_WIDTH]),
+            .m_axil_arprot(s_axil_arprot[h*3 +: 3]),
+            .m_axil_arvalid(s_axil_arvalid[h]),
+            .m_axil_arready(s_axil_arready[h]),
+            .m_axil_rdata(s_axil_rdata[h*DATA_WIDTH +: DATA_WIDTH]),
+            .m_axil_rresp(s_axil_rresp[h*2 +: 2]),
+            .m_axil_rvalid(s_axil_rvalid[h]),
+            .m_axil_rready(s_axil_rready[h]),
+
+            .meip(1'b0),
+            .mtip(1'b0),
+            .msip(1'b0),
+
+            .excl_rd(excl_rd[h]),
+            .excl_wr(excl_wr[h]),
+            .excl_fail(excl_fail[h]),
+
+            .trace_valid(),
+            .trace_pc(),
+            .trace_insn(),
+            .trace_rd(),
+            .trace_rd_we(),
+            .trace_rd_data(),
+            .trace_irq(),
+            .trace_irq_epc(),
+            .trace_irq_cause(),
+            .stall_cause()
+        );
+    end
+endgenerate
+
 
 // **************************************************
 //              Memory (Slave 0)
@@ -330,7 +508,11 @@ axil_uart #(
     
     // External Interface
     .uart_tx(uart_tx),
-    .uart_rx(uart_rx)
+    .uart_rx(uart_rx),
+
+    // DMA request lines
+    .dma_rx_req(uart_dma_rx_req),
+    .dma_tx_req(uart_dma_tx_req)
 );
 
 // **************************************************
@@ -443,7 +625,159 @@ axil_vga #(
     .vga_g(VGA_G),
     .vga_b(VGA_B),
     .vga_hs(VGA_HS),
-    .vga_vs(VGA_VS)
+    .vga_vs(VGA_VS),
+
+    .irq(vga_irq)
+);
+
+
+// **************************************************
+//         DMA (Slave 5, Master S_DMA)
+// **************************************************
+
+axil_dma #(
+    .DATA_WIDTH(DATA_WIDTH),
+    .ADDR_WIDTH(12), // 4KB
+    .M_ADDR_WIDTH(ADDR_WIDTH),
+    .STRB_WIDTH(STRB_WIDTH)
+) u_dma (
+    .clk(clk),
+    .rstn(rstn), // Active low reset
+
+    // Registers <- Interconnect Master 5
+    .s_axil_awaddr(m_axil_awaddr[5*ADDR_WIDTH +: 12]),
+    .s_axil_awprot(m_axil_awprot[5*3 +: 3]),
+    .s_axil_awvalid(m_axil_awvalid[5]),
+    .s_axil_awready(m_axil_awready[5]),
+    .s_axil_wdata(m_axil_wdata[5*DATA_WIDTH +: DATA_WIDTH]),
+    .s_axil_wstrb(m_axil_wstrb[5*STRB_WIDTH +: STRB_WIDTH]),
+    .s_axil_wvalid(m_axil_wvalid[5]),
+    .s_axil_wready(m_axil_wready[5]),
+    .s_axil_bresp(m_axil_bresp[5*2 +: 2]),
+    .s_axil_bvalid(m_axil_bvalid[5]),
+    .s_axil_bready(m_axil_bready[5]),
+    .s_axil_araddr(m_axil_araddr[5*ADDR_WIDTH +: 12]),
+    .s_axil_arprot(m_axil_arprot[5*3 +: 3]),
+    .s_axil_arvalid(m_axil_arvalid[5]),
+    .s_axil_arready(m_axil_arready[5]),
+    .s_axil_rdata(m_axil_rdata[5*DATA_WIDTH +: DATA_WIDTH]),
+    .s_axil_rresp(m_axil_rresp[5*2 +: 2]),
+    .s_axil_rvalid(m_axil_rvalid[5]),
+    .s_axil_rready(m_axil_rready[5]),
+
+    // Transfers -> Interconnect Slave S_DMA (after the harts)
+    .m_axil_awaddr(s_axil_awaddr[S_DMA*ADDR_WIDTH +: ADDR_WIDTH]),
+    .m_axil_awprot(s_axil_awprot[S_DMA*3 +: 3]),
+    .m_axil_awvalid(s_axil_awvalid[S_DMA]),
+    .m_axil_awready(s_axil_awready[S_DMA]),
+    .m_axil_wdata(s_axil_wdata[S_DMA*DATA_WIDTH +: DATA_WIDTH]),
+    .m_axil_wstrb(s_axil_wstrb[S_DMA*STRB_WIDTH +: STRB_WIDTH]),
+    .m_axil_wvalid(s_axil_wvalid[S_DMA]),
+    .m_axil_wready(s_axil_wready[S_DMA]),
+    .m_axil_bresp(s_axil_bresp[S_DMA*2 +: 2]),
+    .m_axil_bvalid(s_axil_bvalid[S_DMA]),
+    .m_axil_bready(s_axil_bready[S_DMA]),
+    .m_axil_araddr(s_axil_araddr[S_DMA*ADDR_WIDTH +: ADDR_WIDTH]),
+    .m_axil_arprot(s_axil_arprot[S_DMA*3 +: 3]),
+    .m_axil_arvalid(s_axil_arvalid[S_DMA]),
+    .m_axil_arready(s_axil_arready[S_DMA]),
+    .m_axil_rdata(s_axil_rdata[S_DMA*DATA_WIDTH +: DATA_WIDTH]),
+    .m_axil_rresp(s_axil_rresp[S_DMA*2 +: 2]),
+    .m_axil_rvalid(s_axil_rvalid[S_DMA]),
+    .m_axil_rready(s_axil_rready[S_DMA]),
+
+    .dreq_i({uart_dma_tx_req, uart_dma_rx_req}),
+
+    // Completion interrupt -> wired to core meip
+    .dma_irq_o(dma_irq)
+);
+
+// **************************************************
+//              Hart Control (Slave 6)
+// **************************************************
+
+axil_hartctl #(
+    .DATA_WIDTH(DATA_WIDTH),
+    .ADDR_WIDTH(12), // 4KB
+    .STRB_WIDTH(STRB_WIDTH),
+    .NUM_HARTS(NUM_HARTS)
+) u_hartctl (
+    .clk(clk),
+    .rstn(rstn),
+
+    .s_axil_awaddr(m_axil_awaddr[6*ADDR_WIDTH +: 12]),
+    .s_axil_awprot(m_axil_awprot[6*3 +: 3]),
+    .s_axil_awvalid(m_axil_awvalid[6]),
+    .s_axil_awready(m_axil_awready[6]),
+    .s_axil_wdata(m_axil_wdata[6*DATA_WIDTH +: DATA_WIDTH]),
+    .s_axil_wstrb(m_axil_wstrb[6*STRB_WIDTH +: STRB_WIDTH]),
+    .s_axil_wvalid(m_axil_wvalid[6]),
+    .s_axil_wready(m_axil_wready[6]),
+    .s_axil_bresp(m_axil_bresp[6*2 +: 2]),
+    .s_axil_bvalid(m_axil_bvalid[6]),
+    .s_axil_bready(m_axil_bready[6]),
+    .s_axil_araddr(m_axil_araddr[6*ADDR_WIDTH +: 12]),
+    .s_axil_arprot(m_axil_arprot[6*3 +: 3]),
+    .s_axil_arvalid(m_axil_arvalid[6]),
+    .s_axil_arready(m_axil_arready[6]),
+    .s_axil_rdata(m_axil_rdata[6*DATA_WIDTH +: DATA_WIDTH]),
+    .s_axil_rresp(m_axil_rresp[6*2 +: 2]),
+    .s_axil_rvalid(m_axil_rvalid[6]),
+    .s_axil_rready(m_axil_rready[6]),
+
+    .hart_run(hart_run),
+    .hart_boot(hart_boot)
+);
+
+// **************************************************
+//              Bus Monitor (Slave 7)
+// **************************************************
+
+// Watches M0..M6; its own port is left out so reading the
+// counters does not disturb them.
+axil_bus_mon #(
+    .DATA_WIDTH(DATA_WIDTH),
+    .ADDR_WIDTH(12), // 4KB
+    .STRB_WIDTH(STRB_WIDTH),
+    .M_MON(M_COUNT-1),
+    .ENABLE(BUS_MON)
+) u_bus_mon (
+    .clk(clk),
+    .rstn(rstn),
+
+    .s_axil_awaddr(m_axil_awaddr[7*ADDR_WIDTH +: 12]),
+    .s_axil_awprot(m_axil_awprot[7*3 +: 3]),
+    .s_axil_awvalid(m_axil_awvalid[7]),
+    .s_axil_awready(m_axil_awready[7]),
+    .s_axil_wdata(m_axil_wdata[7*DATA_WIDTH +: DATA_WIDTH]),
+    .s_axil_wstrb(m_axil_wstrb[7*STRB_WIDTH +: STRB_WIDTH]),
+    .s_axil_wvalid(m_axil_wvalid[7]),
+    .s_axil_wready(m_axil_wready[7]),
+    .s_axil_bresp(m_axil_bresp[7*2 +: 2]),
+    .s_axil_bvalid(m_axil_bvalid[7]),
+    .s_axil_bready(m_axil_bready[7]),
+    .s_axil_araddr(m_axil_araddr[7*ADDR_WIDTH +: 12]),
+    .s_axil_arprot(m_axil_arprot[7*3 +: 3]),
+    .s_axil_arvalid(m_axil_arvalid[7]),
+    .s_axil_arready(m_axil_arready[7]),
+    .s_axil_rdata(m_axil_rdata[7*DATA_WIDTH +: DATA_WIDTH]),
+    .s_axil_rresp(m_axil_rresp[7*2 +: 2]),
+    .s_axil_rvalid(m_axil_rvalid[7]),
+    .s_axil_rready(m_axil_rready[7]),
+
+    .mon_arvalid(m_axil_arvalid[M_COUNT-2:0]),
+    .mon_arready(m_axil_arready[M_COUNT-2:0]),
+    .mon_rvalid(m_axil_rvalid[M_COUNT-2:0]),
+    .mon_rready(m_axil_rready[M_COUNT-2:0]),
+    .mon_awvalid(m_axil_awvalid[M_COUNT-2:0]),
+    .mon_awready(m_axil_awready[M_COUNT-2:0]),
+    .mon_wvalid(m_axil_wvalid[M_COUNT-2:0]),
+    .mon_wready(m_axil_wready[M_COUNT-2:0]),
+    .mon_bvalid(m_axil_bvalid[M_COUNT-2:0]),
+    .mon_bready(m_axil_bready[M_COUNT-2:0]),
+
+    .dbg_idx(busmon_idx),
+    .dbg_data(busmon_data)
 );
 
 
@@ -0,0 +1,1188 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ================================================================
+// Z-Core Instruction-Set Simulator
+//
+// Each RAM word has a decoded-instruction slot; an instruction is
+// decoded on its first execution and the slot is cleared again when
+// a store hits the word. The execute loop is a single switch over
+// the decoded opcodes, shared by run() and step() through a template
+// so the fast path carries no tracing code.
+// ================================================================
+
+#include "iss.h"
+#include "vga_font.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+enum Op : uint8_t {
+    OP_DECODE = 0,      // Slot not decoded yet
+    OP_NOP,
+    OP_LUI, OP_AUIPC, OP_JAL, OP_JALR,
+    OP_BEQ, OP_BNE, OP_BLT, OP_BGE, OP_BLTU, OP_BGEU,
+    OP_LB, OP_LH, OP_LW, OP_LBU, OP_LHU,
+    OP_SB, OP_SH, OP_SW,
+    OP_LR, OP_SC,
+    OP_AMO,             // imm = funct5
+    OP_ADDI, OP_SLTI, OP_SLTIU, OP_XORI, OP_ORI, OP_ANDI,
+    OP_SLLI, OP_SRLI, OP_SRAI, OP_RORI,
+    OP_CLZ, OP_CTZ, OP_CPOP, OP_SEXTB, OP_SEXTH, OP_ORCB, OP_REV8,
+    OP_ADD, OP_SUB, OP_SLL, OP_SLT, OP_SLTU, OP_XOR, OP_SRL, OP_SRA, OP_OR, OP_AND,
+    OP_MUL, OP_MULH, OP_MULHSU, OP_MULHU, OP_DIV, OP_DIVU, OP_REM, OP_REMU,
+    OP_SH1ADD, OP_SH2ADD, OP_SH3ADD, OP_ANDN, OP_ORN, OP_XNOR,
+    OP_MIN, OP_MINU, OP_MAX, OP_MAXU, OP_ZEXTH, OP_ROL, OP_ROR,
+    OP_SIMD,            // imm = z_core_simd_unit op, rs2 register
+    OP_PSHUFBI,         // imm = selectors
+    OP_CSR,             // imm = funct3 << 12 | csr, rs1 = register or zimm
+    OP_ECALL, OP_EBREAK, OP_MRET, OP_WFI,
+    OP_ILLEGAL          // imm = instruction (mtval)
+};
+
+const uint32_t MIP_MTIP = 1u << 7;
+const uint32_t MIP_MEIP = 1u << 11;
+const uint32_t MCAUSE_MTI = 0x80000007;
+const uint32_t MCAUSE_MEI = 0x8000000B;
+
+// mzcfg (0x7C0) bit 0: misaligned loads/stores trap instead of splitting;
+// bit 1: interrupts switch to the shadow register bank; bits 2/3: the
+// bank in use and the one MRET restores (read-only)
+const uint32_t MZCFG_MISALIGN_TRAP = 1u << 0;
+const uint32_t MZCFG_SHADOW        = 1u << 1;
+const uint32_t MZCFG_BANK          = 1u << 2;
+const uint32_t MZCFG_PBANK         = 1u << 3;
+
+// Registers with a shadow copy: ra, t0-t6, a0-a7
+const uint32_t BANKED_REGS = 1u << 1 | 7u << 5 | 0xFFu << 10 | 0xFu << 28;
+
+// One byte time at 115200 baud
+const uint64_t UART_POLL_CLKS = 4340;
+
+// Elements per dma_run() call, so a looping descriptor list cannot
+// hang the model
+const uint32_t DMA_RUN_MAX = 1u << 20;
+
+// VGA timing in system clocks (25 MHz pixel enable, 800 x 525)
+const uint64_t VGA_LINE_CLKS  = 2 * 800;
+const uint64_t VGA_FRAME_CLKS = VGA_LINE_CLKS * 525;
+const uint32_t VGA_V_START = 35;
+const uint32_t VGA_V_END   = 515;
+
+inline uint32_t rd32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+inline int32_t sx(uint32_t v, int bits) {
+    return (int32_t)(v << (32 - bits)) >> (32 - bits);
+}
+
+// Packed-SIMD, lane for lane as z_core_simd_unit
+uint32_t simd(uint32_t op, uint32_t a, uint32_t b) {
+    uint32_t out = 0;
+    for (int i = 0; i < 4; i++) {
+        uint32_t p = (a >> (8 * i)) & 0xFF, q = (b >> (8 * i)) & 0xFF;
+        uint32_t pr = p >> 5, pg = (p >> 2) & 7, pb = p & 3;
+        uint32_t qr = q >> 5, qg = (q >> 2) & 7, qb = q & 3;
+        uint32_t r;
+        switch (op) {
+        case 0:  r = p + q > 0xFF ? 0xFF : p + q; break;             // PADDUSB
+        case 1:  r = p > q ? p - q : 0; break;                        // PSUBUSB
+        case 2:  r = p == q ? 0xFF : 0; break;                        // PCMPEQB
+        case 3:  r = p < q ? 0xFF : 0; break;                         // PCMPLTUB
+        case 4:  r = p < q ? p : q; break;                            // PMINUB
+        case 5:  r = p < q ? q : p; break;                            // PMAXUB
+        case 6:  r = p ? p : q; break;                                // PSELNZB
+        case 7:  r = (a >> (8 * ((b >> (2 * i)) & 3))) & 0xFF; break;  // PSHUFB
+        case 8:  r = ((pr + qr) >> 1) << 5 | ((pg + qg) >> 1) << 2 | (pb + qb) >> 1; break;
+        case 9:  r = ((3 * pr + qr) >> 2) << 5 | ((3 * pg + qg) >> 2) << 2 | (3 * pb + qb) >> 2; break;
+        case 10: r = (pr + qr > 7 ? 7 : pr + qr) << 5 | (pg + qg > 7 ? 7 : pg + qg) << 2 |
+                     (pb + qb > 3 ? 3 : pb + qb); break;
+        case 11: r = (pr > qr ? pr - qr : 0) << 5 | (pg > qg ? pg - qg : 0) << 2 |
+                     (pb > qb ? pb - qb : 0); break;
+        default: r = 0; break;
+        }
+        out |= r << (8 * i);
+    }
+    return out;
+}
+
+} // namespace
+
+Iss::Iss() {
+    memset(x, 0, sizeof(x));
+    memset(x_shadow, 0, sizeof(x_shadow));
+    memset(ram, 0, sizeof(ram));
+    memset(dcache, 0, sizeof(dcache));
+    memset(fb, 0, sizeof(fb));
+    memset(txt_ram, 0, sizeof(txt_ram));
+    // Palette reset contents expand 3-3-2 like mode 0
+    for (int i = 0; i < 256; i++)
+        vga_pal[i] = (i >> 5) << 9 | (i >> 7) << 8 | ((i >> 2) & 7) << 5 |
+                     ((i >> 4) & 1) << 4 | (i & 3) << 2 | (i & 3);
+    pc = 0;
+}
+
+// ----------------------------------------------------------------
+// Image loading
+// ----------------------------------------------------------------
+
+bool Iss::load(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) { perror(path); return false; }
+
+    std::vector<uint8_t> data;
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        data.insert(data.end(), buf, buf + n);
+
+    bool ok;
+    const char *ext = strrchr(path, '.');
+    if (data.size() >= 4 && !memcmp(data.data(), "\x7f" "ELF", 4)) {
+        ok = load_elf(data.data(), data.size());
+    } else if (ext && !strcmp(ext, ".hex")) {
+        rewind(f);
+        ok = load_hex(f);
+        pc = 0;
+    } else {
+        if (data.size() > RAM_SIZE) {
+            fprintf(stderr, "%s: %zu bytes do not fit in RAM\n", path, data.size());
+            ok = false;
+        } else {
+            memcpy(ram, data.data(), data.size());
+            pc = 0;
+            ok = true;
+        }
+    }
+    fclose(f);
+
+    memset(dcache, 0, sizeof(dcache));
+    if (!ok) fprintf(stderr, "%s: cannot load image\n", path);
+    return ok;
+}
+
+bool Iss::load_elf(const uint8_t *data, size_t size) {
+    if (size < 52 || data[4] != 1 || data[5] != 1) return false;   // ELF32, little-endian
+
+    uint32_t entry = rd32(data + 0x18);
+    uint32_t phoff = rd32(data + 0x1C);
+    uint32_t phentsize = data[0x2A] | (data[0x2B] << 8);
+    uint32_t phnum = data[0x2C] | (data[0x2D] << 8);
+
+    for (uint32_t i = 0; i < phnum; i++) {
+        const uint8_t *ph = data + phoff + i * phentsize;
+        if (ph + 32 > data + size) return false;
+        if (rd32(ph) != 1) continue;                                // PT_LOAD
+        uint32_t off = rd32(ph + 4), paddr = rd32(ph + 12);
+        uint32_t filesz = rd32(ph + 16), memsz = rd32(ph + 20);
+        if (!memsz) continue;
+        if (paddr >= RAM_SIZE || memsz > RAM_SIZE - paddr || off + filesz > size) {
+            fprintf(stderr, "segment 0x%08x+0x%x outside RAM\n", paddr, memsz);
+            return false;
+        }
+        memcpy(ram + paddr, data + off, filesz);
+        memset(ram + paddr + filesz, 0, memsz - filesz);
+    }
+    pc = entry;
+    return true;
+}
+
+bool Iss::load_hex(FILE *f) {
+    char tok[64];
+    uint32_t addr = 0;
+    while (fscanf(f, "%63s", tok) == 1) {
+        if (tok[0] == '/' && tok[1] == '/') {
+            int c;
+            while ((c = fgetc(f)) != EOF && c != '\n') {}
+            continue;
+        }
+        if (tok[0] == '@') {
+            addr = strtoul(tok + 1, nullptr, 16);
+            continue;
+        }
+        uint32_t w = strtoul(tok, nullptr, 16);
+        if (addr < RAM_SIZE / 4) {
+            ram[4 * addr + 0] = w;
+            ram[4 * addr + 1] = w >> 8;
+            ram[4 * addr + 2] = w >> 16;
+            ram[4 * addr + 3] = w >> 24;
+        }
+        addr++;
+    }
+    return true;
+}
+
+bool Iss::write_frame(const char *path) const {
+    FILE *f = fopen(path, "wb");
+    if (!f) { perror(path); return false; }
+    // Scanout as axil_vga does it, before upscaling. With the text
+    // layer on, the image is 320x240 in every mode.
+    static const uint16_t txt_colors[16] = {
+        0x000, 0x00A, 0x0A0, 0x0AA, 0xA00, 0xA0A, 0xA50, 0xAAA,
+        0x555, 0x55F, 0x5F5, 0x5FF, 0xF55, 0xF5F, 0xFF5, 0xFFF
+    };
+    bool hires = vga_mode == 2;
+    bool text = txt_ctrl & 1;
+    int w = hires || text ? 2 * FB_WIDTH : FB_WIDTH;
+    int h = hires || text ? 2 * FB_HEIGHT : FB_HEIGHT;
+    uint32_t fb_w = hires ? 2 * FB_WIDTH : FB_WIDTH;
+    uint32_t fb_h = hires ? 2 * FB_HEIGHT : FB_HEIGHT;
+    fprintf(f, "P6\n%d %d\n255\n", w, h);
+    for (int i = 0; i < w * h; i++) {
+        int x = i % w, y = i / w;
+        // Scroll wraps with a single subtract, as in the RTL
+        uint32_t fx = (text && !hires ? x >> 1 : x) + vga_scroll_x;
+        uint32_t fy = (text && !hires ? y >> 1 : y) + vga_scroll_y;
+        if (fx >= fb_w) fx -= fb_w;
+        if (fy >= fb_h) fy -= fb_h;
+        uint32_t p = fy * fb_w + fx;
+        uint8_t c = hires ? (p >> 1 < (uint32_t)FB_BYTES ? fb[p >> 1] >> (4 * (p & 1)) & 0xF : 0)
+                          : (p < (uint32_t)FB_BYTES ? fb[p] : 0);
+        uint8_t rgb[3];
+        if (text) {
+            int cell = ((y / 8 + txt_origin) % TXT_ROWS) * TXT_COLS + x / 8;
+            uint16_t v = txt_ram[cell];
+            uint8_t attr = v >> 8;
+            bool fg = (vga_font8x8[v & 0x7F][y & 7] >> (x & 7)) & 1;
+            if ((txt_ctrl & 2) && (uint32_t)cell == txt_pos && (y & 7) >= 6)
+                fg = true;                          // Cursor (drawn without blinking)
+            if (fg || (attr & 0x80)) {
+                uint16_t p = txt_colors[fg ? attr & 0xF : (attr >> 4) & 7];
+                rgb[0] = (uint8_t)((p >> 8) * 17);
+                rgb[1] = (uint8_t)(((p >> 4) & 0xF) * 17);
+                rgb[2] = (uint8_t)((p & 0xF) * 17);
+                fwrite(rgb, 1, 3, f);
+                continue;
+            }
+        }
+        if (vga_mode == 0) {
+            rgb[0] = (uint8_t)((c >> 5) * 255 / 7);
+            rgb[1] = (uint8_t)(((c >> 2) & 7) * 255 / 7);
+            rgb[2] = (uint8_t)((c & 3) * 255 / 3);
+        } else {
+            uint8_t idx = hires ? (vga_pal_offset & 0xF0) | ((c + vga_pal_offset) & 0xF)
+                                : (uint8_t)(c + vga_pal_offset);
+            uint16_t p = vga_pal[idx];
+            rgb[0] = (uint8_t)((p >> 8) * 17);
+            rgb[1] = (uint8_t)(((p >> 4) & 0xF) * 17);
+            rgb[2] = (uint8_t)((p & 0xF) * 17);
+        }
+        fwrite(rgb, 1, 3, f);
+    }
+    fclose(f);
+    return true;
+}
+
+// ----------------------------------------------------------------
+// Decode (mirrors z_core_control_u / z_core_alu_ctrl)
+// ----------------------------------------------------------------
+
+void Iss::decode(uint32_t insn, Decoded &d) {
+    uint32_t opc = insn & 0x7F;
+    uint32_t f3 = (insn >> 12) & 7;
+    uint32_t f7 = insn >> 25;
+
+    d.rd  = (insn >> 7) & 31;
+    d.rs1 = (insn >> 15) & 31;
+    d.rs2 = (insn >> 20) & 31;
+    d.imm = (uint32_t)sx(insn >> 20, 12);
+    d.op  = OP_ILLEGAL;
+
+    static const uint8_t branch_ops[8] = {
+        OP_BEQ, OP_BNE, OP_NOP, OP_NOP, OP_BLT, OP_BGE, OP_BLTU, OP_BGEU
+    };
+    static const uint8_t load_ops[8] = {
+        OP_LB, OP_LH, OP_LW, OP_ILLEGAL, OP_LBU, OP_LHU, OP_ILLEGAL, OP_ILLEGAL
+    };
+    static const uint8_t store_ops[8] = {
+        OP_SB, OP_SH, OP_SW, OP_ILLEGAL, OP_ILLEGAL, OP_ILLEGAL, OP_ILLEGAL, OP_ILLEGAL
+    };
+
+    switch (opc) {
+    case 0x37: d.op = OP_LUI;   d.imm = insn & 0xFFFFF000; break;
+    case 0x17: d.op = OP_AUIPC; d.imm = insn & 0xFFFFF000; break;
+    case 0x6F:
+        d.op = OP_JAL;
+        d.imm = (uint32_t)sx(((insn >> 31) << 20) | (((insn >> 12) & 0xFF) << 12) |
+                             (((insn >> 20) & 1) << 11) | (((insn >> 21) & 0x3FF) << 1), 21);
+        break;
+    case 0x67: d.op = OP_JALR; break;
+    case 0x63:
+        d.op = branch_ops[f3];
+        d.imm = (uint32_t)sx(((insn >> 31) << 12) | (((insn >> 7) & 1) << 11) |
+                             (((insn >> 25) & 0x3F) << 5) | (((insn >> 8) & 0xF) << 1), 13);
+        d.rd = 0;
+        break;
+    case 0x03: d.op = load_ops[f3]; break;
+    case 0x23:
+        d.op = store_ops[f3];
+        d.imm = (uint32_t)sx(((insn >> 25) << 5) | ((insn >> 7) & 31), 12);
+        d.rd = 0;
+        break;
+    case 0x13:
+        switch (f3) {
+        case 0: d.op = OP_ADDI; break;
+        case 1:
+            if (f7 == 0x30) {
+                static const uint8_t unary[8] = {
+                    OP_CLZ, OP_CTZ, OP_CPOP, OP_SLLI, OP_SEXTB, OP_SEXTH, OP_SLLI, OP_SLLI
+                };
+                d.op = d.rs2 < 8 ? unary[d.rs2] : (uint8_t)OP_SLLI;
+            } else {
+                d.op = OP_SLLI;
+            }
+            break;
+        case 2: d.op = OP_SLTI; break;
+        case 3: d.op = OP_SLTIU; break;
+        case 4: d.op = OP_XORI; break;
+        case 5:
+            if (f7 == 0x30)                       d.op = OP_RORI;
+            else if (f7 == 0x14 && d.rs2 == 0x07) d.op = OP_ORCB;
+            else if (f7 == 0x34 && d.rs2 == 0x18) d.op = OP_REV8;
+            else d.op = (f7 & 0x20) ? OP_SRAI : OP_SRLI;
+            break;
+        case 6: d.op = OP_ORI; break;
+        case 7: d.op = OP_ANDI; break;
+        }
+        break;
+    case 0x33:
+        switch (f3) {
+        case 0: d.op = (f7 & 0x20) ? OP_SUB : (f7 & 1) ? OP_MUL : OP_ADD; break;
+        case 1: d.op = f7 == 0x30 ? OP_ROL : (f7 & 1) ? OP_MULH : OP_SLL; break;
+        case 2: d.op = f7 == 0x10 ? OP_SH1ADD : (f7 & 1) ? OP_MULHSU : OP_SLT; break;
+        case 3: d.op = (f7 & 1) ? OP_MULHU : OP_SLTU; break;
+        case 4:
+            d.op = f7 == 0x01 ? OP_DIV : f7 == 0x20 ? OP_XNOR : f7 == 0x10 ? OP_SH2ADD :
+                   f7 == 0x05 ? OP_MIN : (f7 == 0x04 && d.rs2 == 0) ? OP_ZEXTH : OP_XOR;
+            break;
+        case 5:
+            d.op = f7 == 0x01 ? OP_DIVU : f7 == 0x05 ? OP_MINU : f7 == 0x30 ? OP_ROR :
+                   (f7 & 0x20) ? OP_SRA : OP_SRL;
+            break;
+        case 6:
+            d.op = f7 == 0x01 ? OP_REM : f7 == 0x20 ? OP_ORN : f7 == 0x10 ? OP_SH3ADD :
+                   f7 == 0x05 ? OP_MAX : OP_OR;
+            break;
+        case 7:
+            d.op = f7 == 0x01 ? OP_REMU : f7 == 0x20 ? OP_ANDN : f7 == 0x05 ? OP_MAXU : OP_AND;
+            break;
+        }
+        break;
+    case 0x0B:
+        d.op = OP_SIMD;
+        d.imm = f7 == 0x00 ? f3 : (f7 == 0x01 && f3 < 4) ? 8 + f3 : 15;   // 15: result 0
+        break;
+    case 0x2B:
+        if (f3 == 0) d.op = OP_PSHUFBI;
+        else { d.op = OP_SIMD; d.imm = 15; }
+        break;
+    case 0x0F: d.op = OP_NOP; d.rd = 0; break;                      // FENCE
+    case 0x2F:
+        // A extension, word only; aq/rl are ignored (one hart, in order)
+        if (f3 != 2) break;
+        d.imm = insn >> 27;
+        switch (d.imm) {
+        case 0x02: d.op = OP_LR; break;
+        case 0x03: d.op = OP_SC; break;
+        case 0x00: case 0x01: case 0x04: case 0x08: case 0x0C:
+        case 0x10: case 0x14: case 0x18: case 0x1C:
+            d.op = OP_AMO; break;
+        }
+        break;
+    case 0x73:
+        if (f3) {
+            d.op = OP_CSR;
+            d.imm = (f3 << 12) | (insn >> 20);
+        } else {
+            uint32_t f12 = insn >> 20;
+            d.op = f12 == 0x000 ? OP_ECALL : f12 == 0x001 ? OP_EBREAK :
+                   f12 == 0x302 ? OP_MRET : f12 == 0x105 ? OP_WFI : OP_ILLEGAL;
+            d.rd = 0;
+        }
+        break;
+    }
+
+    if (insn == 0) {                    // Treated as a NOP by the core
+        d.op = OP_NOP;
+        d.rd = 0;
+    }
+    if (d.op == OP_ILLEGAL) {
+        d.imm = insn;
+        d.rd = 0;
+    }
+}
+
+// ----------------------------------------------------------------
+// Traps and interrupts
+// ----------------------------------------------------------------
+
+void Iss::trap(uint32_t cause, uint32_t tval, uint32_t epc) {
+    mepc = epc & ~3u;
+    mcause = cause;
+    mtval = tval;
+    mstatus_mpie = mstatus_mie;
+    mstatus_mie = false;
+    mzcfg = (mzcfg & ~MZCFG_PBANK) | ((mzcfg & MZCFG_BANK) ? MZCFG_PBANK : 0);
+    if ((cause >> 31) && (mzcfg & MZCFG_SHADOW))
+        set_bank(true);
+    pc = mtvec;
+}
+
+void Iss::set_bank(bool shadow) {
+    if (shadow == !!(mzcfg & MZCFG_BANK)) return;
+    for (int i = 1; i < 32; i++)
+        if (BANKED_REGS & (1u << i))
+            std::swap(x[i], x_shadow[i]);
+    mzcfg ^= MZCFG_BANK;
+}
+
+void Iss::take_interrupt(uint32_t cause) {
+    trap(cause, 0, pc);
+}
+
+void Iss::check_irq() {
+    // A transfer waiting on UART RX polls for input once per byte time
+    uint64_t next = ~0ull;
+    if (dma_busy) {
+        dma_run();
+        if (dma_busy) next = cycle + UART_POLL_CLKS;
+    }
+
+    uint32_t cause;
+    if (mstatus_mie && (cause = irq_wake(next)))
+        trap(cause, 0, pc);
+    irq_check_at = next;
+}
+
+uint32_t Iss::irq_wake(uint64_t &next) {
+    // meip is the DMA completion or a VGA raster interrupt, msip is
+    // tied off in z_core_top
+    if (mie & MIP_MEIP) {
+        if (dma_irq() || vga_irq())
+            return MCAUSE_MEI;
+        for (int s = 0; s < 2; s++) {
+            if (vga_irq_en & (1u << s)) {
+                uint64_t t = vga_event_after(s, cycle);
+                if (t < next) next = t;
+            }
+        }
+    }
+    if (mie & MIP_MTIP) {
+        if (timer_irq())
+            return MCAUSE_MTI;
+        uint64_t t = timer_next_irq();
+        if (t < next) next = t;
+    }
+    return 0;
+}
+
+// ----------------------------------------------------------------
+// CSRs (z_core_csr_file)
+// ----------------------------------------------------------------
+
+uint32_t Iss::csr_read(uint32_t addr) {
+    uint64_t mcycle = cycle + mcycle_adj;
+    switch (addr) {
+    case 0x300: return 0x1800 | (mstatus_mpie << 7) | (mstatus_mie << 3);
+    case 0x301: return 0x40001101;                  // RV32IMA
+    case 0x304: return mie;
+    case 0x305: return mtvec;
+    case 0x340: return mscratch;
+    case 0x341: return mepc;
+    case 0x342: return mcause;
+    case 0x343: return mtval;
+    case 0x344: return (timer_irq() ? MIP_MTIP : 0) | (dma_irq() ? MIP_MEIP : 0);
+    case 0xB00: case 0xC00: return (uint32_t)mcycle;
+    case 0xB80: case 0xC80: return (uint32_t)(mcycle >> 32);
+    case 0xB02: case 0xC02: return (uint32_t)minstret;
+    case 0xB82: case 0xC82: return (uint32_t)(minstret >> 32);
+    case 0xB0A: case 0xC0A: return (uint32_t)misalign_splits;
+    case 0xB8A: case 0xC8A: return (uint32_t)(misalign_splits >> 32);
+    case 0xB0C: case 0xC0C: return (uint32_t)wfi_cycles;
+    case 0xB8C: case 0xC8C: return (uint32_t)(wfi_cycles >> 32);
+    case 0x7C0: return mzcfg;
+    case 0x7C1: return mzicaddr;
+    default:    return 0;   // mhartid etc., and mhpmcounter3..9/11 (no pipeline)
+    }
+}
+
+void Iss::csr_write(uint32_t addr, uint32_t v) {
+    uint64_t mcycle = cycle + mcycle_adj;
+    switch (addr) {
+    case 0x300:
+        mstatus_mie  = (v >> 3) & 1;
+        mstatus_mpie = (v >> 7) & 1;
+        irq_check_at = 0;
+        break;
+    case 0x304: mie = v & 0x888; irq_check_at = 0; break;
+    case 0x305: mtvec = v; break;
+    case 0x340: mscratch = v; break;
+    case 0x341: mepc = v & ~3u; break;
+    case 0x342: mcause = v; break;
+    case 0x343: mtval = v; break;
+    case 0xB00: mcycle_adj = (int64_t)(((mcycle & ~0xFFFFFFFFull) | v) - cycle); break;
+    case 0xB80: mcycle_adj = (int64_t)(((mcycle & 0xFFFFFFFFull) | (uint64_t)v << 32) - cycle); break;
+    case 0xB02: minstret = (minstret & ~0xFFFFFFFFull) | v; break;
+    case 0xB82: minstret = (minstret & 0xFFFFFFFFull) | (uint64_t)v << 32; break;
+    case 0xB0A: misalign_splits = (misalign_splits & ~0xFFFFFFFFull) | v; break;
+    case 0xB8A: misalign_splits = (misalign_splits & 0xFFFFFFFFull) | (uint64_t)v << 32; break;
+    case 0xB0C: wfi_cycles = (wfi_cycles & ~0xFFFFFFFFull) | v; break;
+    case 0xB8C: wfi_cycles = (wfi_cycles & 0xFFFFFFFFull) | (uint64_t)v << 32; break;
+    case 0x7C0:
+        mzcfg = (mzcfg & (MZCFG_BANK | MZCFG_PBANK)) | (v & (MZCFG_MISALIGN_TRAP | MZCFG_SHADOW));
+        break;
+    case 0x7C1: mzicaddr = v & ~3u; break;
+    default: break;         // mzicctl (0x7C2): no I-cache here, reads 0 (idle)
+    }
+}
+
+// ----------------------------------------------------------------
+// Peripherals
+// ----------------------------------------------------------------
+
+uint64_t Iss::timer_now() const {
+    // Counter mode (CTRL bit 2) counts external events; there are none here
+    if (!(timer_ctrl & 1) || (timer_ctrl & 4)) return timer_val;
+    uint64_t dt = cycle - timer_at;
+    return (timer_ctrl & 2) ? timer_val + dt : timer_val - dt;
+}
+
+void Iss::timer_sync() {
+    timer_val = timer_now();
+    timer_at = cycle;
+}
+
+bool Iss::timer_irq() const {
+    return (timer_ctrl & 8) && timer_now() >= timer_cmp;
+}
+
+uint64_t Iss::timer_next_irq() const {
+    if (!(timer_ctrl & 8)) return ~0ull;
+    uint64_t t = timer_now();
+    if (t >= timer_cmp) return cycle;
+    if (!(timer_ctrl & 1) || (timer_ctrl & 4)) return ~0ull;
+    // Counting up reaches the compare value; counting down wraps past zero
+    return cycle + ((timer_ctrl & 2) ? timer_cmp - t : t + 1);
+}
+
+// Start of the scanline (h_count 0) on which raster source src fires:
+// 0 = line compare, 1 = vblank. Returns the first such cycle after t.
+uint64_t Iss::vga_event_after(int src, uint64_t t) const {
+    uint64_t line = src ? VGA_V_END : VGA_V_START + vga_line_cmp;
+    if (line * VGA_LINE_CLKS >= VGA_FRAME_CLKS) return ~0ull;
+    uint64_t e = t - t % VGA_FRAME_CLKS + line * VGA_LINE_CLKS;
+    return e > t ? e : e + VGA_FRAME_CLKS;
+}
+
+void Iss::vga_sync() {
+    for (int s = 0; s < 2; s++)
+        if (vga_event_after(s, vga_synced) <= cycle) vga_irq_status |= 1u << s;
+    vga_synced = cycle;
+}
+
+uint32_t Iss::mmio_read(uint32_t addr) {
+    uint32_t reg = addr & 0xFFC;
+    switch (addr & ~0xFFFu) {
+    case UART_BASE:
+        switch ((reg >> 2) & 7) {
+        case 0: return uart_tx;
+        case 1: uart_rx_valid = false; return uart_rx;
+        case 2:
+            uart_poll();
+            return (uart_rx_valid << 2) | 1;        // TX always empty
+        case 3: return uart_ctrl;
+        case 4: return uart_baud_div;
+        default: return 0;
+        }
+    case GPIO_BASE: {
+        uint64_t pins = (gpio_out & gpio_dir) | (gpio_in & ~gpio_dir);
+        switch ((reg >> 2) & 3) {
+        case 0: return (uint32_t)pins;
+        case 1: return (uint32_t)(pins >> 32);
+        case 2: return (uint32_t)gpio_dir;
+        default: return (uint32_t)(gpio_dir >> 32);
+        }
+    }
+    case TIMER_BASE:
+        switch ((reg >> 2) & 7) {
+        case 0: return (uint32_t)timer_now();
+        case 1: return (uint32_t)(timer_now() >> 32);
+        case 2: return timer_ctrl;
+        case 3: return (uint32_t)timer_cmp;
+        case 4: return (uint32_t)(timer_cmp >> 32);
+        default: return 0;
+        }
+    case HARTCTL_BASE:
+        // Single-hart model: HART_RUN only ever reads hart 0
+        switch ((reg >> 2) & 3) {
+        case 0: return 1;
+        case 1: return 1;
+        case 2: return hart_boot;
+        default: return 0;
+        }
+    case DMA_BASE:
+        switch ((reg >> 2) & 7) {
+        case 0: return dma_src;
+        case 1: return dma_dst;
+        case 2: return dma_len;
+        case 3: return (dma_ctrl & ~1u) | dma_busy;
+        case 4: return dma_next;
+        case 5: return (dma_err << 2) | (dma_done << 1) | dma_busy;
+        default: return 0;
+        }
+    case VGA_BASE:
+        switch ((reg >> 2) & 0x1F) {
+        case 0: return fb_addr;
+        case 2: {
+            uint32_t line = (uint32_t)((cycle % VGA_FRAME_CLKS) / VGA_LINE_CLKS);
+            return !(line >= VGA_V_START && line < VGA_V_END);
+        }
+        case 3: return vga_mode;
+        case 4: return vga_pal_index;
+        case 6: return vga_pal_offset;
+        case 8: return txt_ctrl;
+        case 9: return txt_pos;
+        case 11: return txt_attr;
+        case 13: return txt_origin;
+        case 14: return vga_scroll_x;
+        case 15: return vga_scroll_y;
+        case 16: return vga_line_cmp;
+        case 17: return vga_irq_en;
+        case 18: vga_sync(); return vga_irq_status;
+        case 19: return (uint32_t)((cycle % VGA_FRAME_CLKS) / VGA_LINE_CLKS - VGA_V_START) & 0x3FF;
+        default: return 0;
+        }
+    default:
+        return 0;
+    }
+}
+
+void Iss::mmio_write(uint32_t addr, uint32_t v, uint32_t mask) {
+    uint32_t reg = addr & 0xFFC;
+    switch (addr & ~0xFFFu) {
+    case UART_BASE:
+        switch ((reg >> 2) & 7) {
+        case 0:
+            uart_tx = v;
+            if ((uart_ctrl & 1) && uart_out) {
+                fputc(uart_tx, uart_out);
+                if (uart_tx == '\n') fflush(uart_out);
+            }
+            break;
+        case 3: uart_ctrl = v & 3; break;
+        case 4: uart_baud_div = v; break;
+        }
+        break;
+    case GPIO_BASE: {
+        uint64_t m = mask, w = v;
+        int hi = (reg >> 2) & 1;
+        uint64_t &r = (reg >> 3) & 1 ? gpio_dir : gpio_out;
+        r = (r & ~(m << (32 * hi))) | ((w & m) << (32 * hi));
+        break;
+    }
+    case TIMER_BASE:
+        timer_sync();
+        switch ((reg >> 2) & 7) {
+        case 0: timer_val = (timer_val & ~0xFFFFFFFFull) | v; break;
+        case 1: timer_val = (timer_val & 0xFFFFFFFFull) | (uint64_t)v << 32; break;
+        case 2: timer_ctrl = v; break;
+        case 3: timer_cmp = (timer_cmp & ~0xFFFFFFFFull) | v; break;
+        case 4: timer_cmp = (timer_cmp & 0xFFFFFFFFull) | (uint64_t)v << 32; break;
+        }
+        irq_check_at = 0;
+        break;
+    case VGA_BASE:
+        switch ((reg >> 2) & 0x1F) {
+        case 0: fb_addr = v & 0xFFFF; break;
+        case 1: {
+            uint32_t last = vga_mode == 2 ? FB_BYTES - 1 : FB_WIDTH * FB_HEIGHT - 1;
+            if (fb_addr < (uint32_t)FB_BYTES) fb[fb_addr] = v;
+            fb_addr = fb_addr < last ? fb_addr + 1 : 0;
+            break;
+        }
+        case 3: vga_mode = (v & 3) == 3 ? 0 : v & 3; break;
+        case 4: vga_pal_index = v; break;
+        case 5: vga_pal[vga_pal_index++] = v & 0xFFF; break;
+        case 6: vga_pal_offset = v; break;
+        case 7:
+            if (fb_addr < (uint32_t)FB_BYTES)
+                fb[fb_addr] = v & 0x10 ? (fb[fb_addr] & 0x0F) | (v & 0xF) << 4
+                                       : (fb[fb_addr] & 0xF0) | (v & 0xF);
+            break;
+        case 8: txt_ctrl = v & 7; break;
+        case 9: txt_pos = (v & 0x7FF) < TXT_COLS * TXT_ROWS ? v & 0x7FF : 0; break;
+        case 10:
+        case 12:
+            txt_ram[txt_pos] = ((reg >> 2) & 0x1F) == 10 ? (txt_attr << 8) | (v & 0xFF) : v & 0xFFFF;
+            txt_pos = txt_pos < TXT_COLS * TXT_ROWS - 1 ? txt_pos + 1 : 0;
+            break;
+        case 11: txt_attr = v & 0xFF; break;
+        case 13: txt_origin = (v & 0x1F) < TXT_ROWS ? v & 0x1F : 0; break;
+        case 14: vga_scroll_x = v & 0x1FF; break;
+        case 15: vga_scroll_y = v & 0xFF; break;
+        case 16: vga_sync(); vga_line_cmp = v & 0x1FF; irq_check_at = 0; break;
+        case 17: vga_irq_en = v & 3; irq_check_at = 0; break;
+        case 18: vga_sync(); vga_irq_status &= ~v; irq_check_at = 0; break;
+        }
+        break;
+    case HARTCTL_BASE:
+        if (((reg >> 2) & 3) == 2) hart_boot = v;
+        break;
+    case DMA_BASE:
+        // SRC..NEXT are read-only while busy; CTRL without START aborts
+        switch ((reg >> 2) & 7) {
+        case 0: if (!dma_busy) dma_src = v; break;
+        case 1: if (!dma_busy) dma_dst = v; break;
+        case 2: if (!dma_busy) dma_len = v; break;
+        case 3:
+            if (dma_busy) {
+                if (!(v & 1)) dma_busy = false;
+            } else {
+                dma_ctrl = v;
+                if (v & 1) {
+                    dma_done = dma_err = false;
+                    dma_busy = true;
+                    dma_run();
+                }
+            }
+            break;
+        case 4: if (!dma_busy) dma_next = v; break;
+        case 5:
+            if (v & 2) dma_done = false;
+            if (v & 4) dma_err = false;
+            break;
+        }
+        irq_check_at = 0;
+        break;
+    }
+}
+
+void Iss::uart_poll() {
+    if (!uart_rx_valid && uart_in_fd >= 0 && cycle >= uart_poll_at) {
+        // Poll about once per byte time at 115200 baud
+        if (uart_out) fflush(uart_out);
+        uart_poll_at = cycle + UART_POLL_CLKS;
+        uint8_t c;
+        if (read(uart_in_fd, &c, 1) == 1) {
+            uart_rx = c;
+            uart_rx_valid = true;
+        }
+    }
+}
+
+// Word access as the DMA master sees the interconnect: false is DECERR
+bool Iss::bus_read(uint32_t addr, uint32_t &v) {
+    addr &= ~3u;
+    if (addr < RAM_WIN) {
+        v = rd32(ram + (addr & (RAM_SIZE - 1)));
+        return true;
+    }
+    if (addr > BUSMON_BASE + 0xFFF) return false;
+    v = mmio_read(addr);
+    return true;
+}
+
+bool Iss::bus_write(uint32_t addr, uint32_t v, uint32_t mask) {
+    addr &= ~3u;
+    if (addr == resv_addr) resv_valid = false;
+    if (addr < RAM_WIN) {
+        uint8_t *p = ram + (addr & (RAM_SIZE - 1));
+        for (int k = 0; k < 4; k++)
+            if ((mask >> (8 * k)) & 0xFF) p[k] = v >> (8 * k);
+        dcache[(addr & (RAM_SIZE - 1)) >> 2].op = OP_DECODE;
+        return true;
+    }
+    if (addr > BUSMON_BASE + 0xFFF) return false;
+    mmio_write(addr, v, mask);
+    return true;
+}
+
+// Misaligned access as the LSU performs it: the aligned word holding
+// addr, then the next one if the access crosses into it
+void Iss::load_split(uint32_t addr, int bytes, uint8_t *q) {
+    uint32_t sh = 8 * (addr & 3);
+    uint32_t lo = 0, hi = 0;
+    bus_read(addr, lo);
+    if ((addr & 3) + bytes > 4) {
+        bus_read(addr + 4, hi);
+        misalign_splits++;
+    }
+    uint64_t w = ((uint64_t)hi << 32 | lo) >> sh;
+    for (int k = 0; k < 4; k++) q[k] = (uint8_t)(w >> (8 * k));
+}
+
+void Iss::store_split(uint32_t addr, int bytes, uint32_t v) {
+    uint32_t sh = 8 * (addr & 3);
+    uint64_t w = (uint64_t)v << sh;
+    uint64_t m = ((1ull << (8 * bytes)) - 1) << sh;
+    bus_write(addr, (uint32_t)w, (uint32_t)m);
+    if ((addr & 3) + bytes > 4) {
+        bus_write(addr + 4, (uint32_t)(w >> 32), (uint32_t)(m >> 32));
+        misalign_splits++;
+    }
+}
+
+void Iss::dma_run() {
+    for (uint32_t n = 0; dma_busy && n < DMA_RUN_MAX; n++) {
+        if (dma_len == 0) {
+            if (!(dma_ctrl & 0x80)) {
+                dma_done = true;
+                dma_busy = false;
+                break;
+            }
+            uint32_t d[5];
+            for (int k = 0; k < 5; k++) {
+                if (!bus_read(dma_next + 4 * k, d[k])) {
+                    dma_err = true;
+                    dma_busy = false;
+                    return;
+                }
+            }
+            dma_src = d[0]; dma_dst = d[1]; dma_len = d[2]; dma_ctrl = d[3]; dma_next = d[4];
+            continue;
+        }
+
+        // REQ 1: UART RX valid; REQ 2 (TX empty) is always ready here
+        if (((dma_ctrl >> 5) & 3) == 1) {
+            uart_poll();
+            if (!uart_rx_valid) return;
+        }
+
+        bool byte = dma_ctrl & 0x10;
+        uint32_t v;
+        if (!bus_read(dma_src, v)) { dma_err = true; dma_busy = false; return; }
+        uint32_t mask = 0xFFFFFFFFu;
+        if (byte) {
+            v = ((v >> (8 * (dma_src & 3))) & 0xFF) * 0x01010101u;
+            mask = 0xFFu << (8 * (dma_dst & 3));
+        }
+        if (!bus_write(dma_dst, v, mask)) { dma_err = true; dma_busy = false; return; }
+
+        uint32_t step = byte ? 1 : 4;
+        if (!(dma_ctrl & 4)) dma_src += step;
+        if (!(dma_ctrl & 8)) dma_dst += step;
+        dma_len--;
+    }
+}
+
+// ----------------------------------------------------------------
+// Execute
+// ----------------------------------------------------------------
+
+uint64_t Iss::run(uint64_t max_insns) {
+    return exec<false>(max_insns ? max_insns : ~0ull, nullptr);
+}
+
+bool Iss::step(Retire &r) {
+    return exec<true>(1, &r) != 0;
+}
+
+template <bool STEP>
+uint64_t Iss::exec(uint64_t n, Retire *r) {
+    const uint32_t ram_mask = RAM_SIZE - 1;
+    uint64_t i;
+
+    for (i = 0; i < n && !halt; i++) {
+        if (!external_irq && cycle >= irq_check_at)
+            check_irq();
+
+        const uint32_t ipc = pc;
+        Decoded &d = dcache[(ipc & ram_mask) >> 2];
+        if (d.op == OP_DECODE)
+            decode(rd32(ram + (ipc & ram_mask & ~3u)), d);
+
+        const uint32_t insn = STEP ? rd32(ram + (ipc & ram_mask & ~3u)) : 0;
+        uint32_t npc = ipc + 4;
+        uint32_t a = x[d.rs1], b = x[d.rs2];
+        uint32_t addr, v;
+        bool sync = false;
+
+// Memory helpers; misaligned accesses are split like the core's LSU,
+// or trap (cause 4 / 6) with mzcfg.MISALIGN_TRAP set
+#define LOAD(bytes, expr)                                               \
+        addr = a + d.imm;                                               \
+        if (addr & (bytes - 1)) {                                       \
+            if (mzcfg & MZCFG_MISALIGN_TRAP) { trap(4, addr, ipc); goto trapped; } \
+            uint8_t q[4];                                               \
+            load_split(addr, bytes, q);                                 \
+            const uint8_t *p = q;                                       \
+            v = expr;                                                   \
+            sync = addr + bytes - 1 >= RAM_WIN;                         \
+        } else if (addr < RAM_WIN) {                                    \
+            const uint8_t *p = ram + (addr & ram_mask);                 \
+            v = expr;                                                   \
+        } else {                                                        \
+            uint32_t w = mmio_read(addr) >> (8 * (addr & 3));           \
+            const uint8_t q[4] = {(uint8_t)w, (uint8_t)(w >> 8),        \
+                                  (uint8_t)(w >> 16), (uint8_t)(w >> 24)}; \
+            const uint8_t *p = q;                                       \
+            v = expr;                                                   \
+            sync = true;                                                \
+        }                                                               \
+        x[d.rd] = v;
+#define STORE(bytes)                                                    \
+        addr = a + d.imm;                                               \
+        if (addr & (bytes - 1)) {                                       \
+            if (mzcfg & MZCFG_MISALIGN_TRAP) { trap(6, addr, ipc); goto trapped; } \
+            store_split(addr, bytes, b);                                \
+        } else if (addr < RAM_WIN) {                                    \
+            uint8_t *p = ram + (addr & ram_mask);                       \
+            for (int k = 0; k < bytes; k++) p[k] = b >> (8 * k);        \
+            if ((addr & ~3u) == resv_addr) resv_valid = false;          \
+            dcache[(addr & ram_mask) >> 2].op = OP_DECODE;              \
+        } else {                                                        \
+            uint32_t sh = 8 * (addr & 3);                               \
+            uint32_t m = (bytes == 4 ? 0xFFFFFFFFu : (1u << (8 * bytes)) - 1) << sh; \
+            mmio_write(addr, b << sh, m);                               \
+            if ((addr & ~3u) == resv_addr) resv_valid = false;          \
+        }
+#define BRANCH(cond)                                                    \
+        if (cond) {                                                     \
+            npc = ipc + d.imm;                                          \
+            if (npc & 3) { trap(0, npc, ipc); goto trapped; }           \
+        }
+
+        switch (d.op) {
+        case OP_NOP: break;
+        case OP_LUI:   x[d.rd] = d.imm; break;
+        case OP_AUIPC: x[d.rd] = ipc + d.imm; break;
+        case OP_JAL:
+            npc = ipc + d.imm;
+            if (npc & 3) { trap(0, npc, ipc); goto trapped; }
+            x[d.rd] = ipc + 4;
+            if (npc == ipc && !external_irq) {
+                // "j ." idles until the next interrupt, or ends the program
+                if (irq_check_at == ~0ull) halt = true;
+                else if (irq_check_at > cycle + 1) {
+                    minstret += irq_check_at - cycle - 1;
+                    cycle = irq_check_at - 1;
+                }
+            }
+            break;
+        case OP_JALR:
+            npc = (a + d.imm) & ~1u;
+            if (npc & 3) { trap(0, npc, ipc); goto trapped; }
+            x[d.rd] = ipc + 4;
+            break;
+
+        case OP_BEQ:  BRANCH(a == b); break;
+        case OP_BNE:  BRANCH(a != b); break;
+        case OP_BLT:  BRANCH((int32_t)a < (int32_t)b); break;
+        case OP_BGE:  BRANCH((int32_t)a >= (int32_t)b); break;
+        case OP_BLTU: BRANCH(a < b); break;
+        case OP_BGEU: BRANCH(a >= b); break;
+
+        case OP_LB:  { LOAD(1, (uint32_t)(int8_t)p[0]); break; }
+        case OP_LH:  { LOAD(2, (uint32_t)(int16_t)(p[0] | p[1] << 8)); break; }
+        case OP_LW:  { LOAD(4, rd32(p)); break; }
+        case OP_LBU: { LOAD(1, p[0]); break; }
+        case OP_LHU: { LOAD(2, (uint32_t)(p[0] | p[1] << 8)); break; }
+        case OP_SB:  { STORE(1); break; }
+        case OP_SH:  { STORE(2); break; }
+        case OP_SW:  { STORE(4); break; }
+
+        // LR/SC/AMO: word aligned only, never split. The reservation is
+        // the word of the last LR or AMO read; any write to it drops it.
+        case OP_LR:
+            addr = a;
+            if (addr & 3) { trap(4, addr, ipc); goto trapped; }
+            bus_read(addr, v);
+            x[d.rd] = v;
+            resv_valid = true;
+            resv_addr = addr;
+            sync = addr >= RAM_WIN;
+            break;
+        case OP_SC:
+            addr = a;
+            if (addr & 3) { trap(6, addr, ipc); goto trapped; }
+            v = !(resv_valid && resv_addr == addr);
+            resv_valid = false;
+            if (!v) bus_write(addr, b, ~0u);
+            x[d.rd] = v;
+            break;
+        case OP_AMO: {
+            addr = a;
+            if (addr & 3) { trap(6, addr, ipc); goto trapped; }
+            uint32_t old = 0;
+            bus_read(addr, old);
+            switch (d.imm) {
+            case 0x00: v = old + b; break;                                  // AMOADD
+            case 0x01: v = b; break;                                        // AMOSWAP
+            case 0x04: v = old ^ b; break;                                  // AMOXOR
+            case 0x08: v = old | b; break;                                  // AMOOR
+            case 0x0C: v = old & b; break;                                  // AMOAND
+            case 0x10: v = (int32_t)old < (int32_t)b ? old : b; break;      // AMOMIN
+            case 0x14: v = (int32_t)old > (int32_t)b ? old : b; break;      // AMOMAX
+            case 0x18: v = old < b ? old : b; break;                        // AMOMINU
+            default:   v = old > b ? old : b; break;                        // AMOMAXU
+            }
+            bus_write(addr, v, ~0u);
+            resv_valid = false;             // The AMO's own read replaced it
+            x[d.rd] = old;
+            sync = addr >= RAM_WIN;
+            break;
+        }
+
+        case OP_ADDI:  x[d.rd] = a + d.imm; break;
+        case OP_SLTI:  x[d.rd] = (int32_t)a < (int32_t)d.imm; break;
+        case OP_SLTIU: x[d.rd] = a < d.imm; break;
+        case OP_XORI:  x[d.rd] = a ^ d.imm; break;
+        case OP_ORI:   x[d.rd] = a | d.imm; break;
+        case OP_ANDI:  x[d.rd] = a & d.imm; break;
+        case OP_SLLI:  x[d.rd] = a << (d.imm & 31); break;
+        case OP_SRLI:  x[d.rd] = a >> (d.imm & 31); break;
+        case OP_SRAI:  x[d.rd] = (uint32_t)((int32_t)a >> (d.imm & 31)); break;
+        case OP_RORI:  v = d.imm & 31; x[d.rd] = v ? (a >> v) | (a << (32 - v)) : a; break;
+
+        case OP_CLZ:   x[d.rd] = a ? __builtin_clz(a) : 32; break;
+        case OP_CTZ:   x[d.rd] = a ? __builtin_ctz(a) : 32; break;
+        case OP_CPOP:  x[d.rd] = __builtin_popcount(a); break;
+        case OP_SEXTB: x[d.rd] = (uint32_t)(int8_t)a; break;
+        case OP_SEXTH: x[d.rd] = (uint32_t)(int16_t)a; break;
+        case OP_ORCB:
+            v = 0;
+            for (int k = 0; k < 32; k += 8)
+                if ((a >> k) & 0xFF) v |= 0xFFu << k;
+            x[d.rd] = v;
+            break;
+        case OP_REV8:  x[d.rd] = __builtin_bswap32(a); break;
+
+        case OP_ADD:  x[d.rd] = a + b; break;
+        case OP_SUB:  x[d.rd] = a - b; break;
+        case OP_SLL:  x[d.rd] = a << (b & 31); break;
+        case OP_SLT:  x[d.rd] = (int32_t)a < (int32_t)b; break;
+        case OP_SLTU: x[d.rd] = a < b; break;
+        case OP_XOR:  x[d.rd] = a ^ b; break;
+        case OP_SRL:  x[d.rd] = a >> (b & 31); break;
+        case OP_SRA:  x[d.rd] = (uint32_t)((int32_t)a >> (b & 31)); break;
+        case OP_OR:   x[d.rd] = a | b; break;
+        case OP_AND:  x[d.rd] = a & b; break;
+
+        case OP_MUL:    x[d.rd] = a * b; break;
+        case OP_MULH:   x[d.rd] = (uint32_t)(((int64_t)(int32_t)a * (int32_t)b) >> 32); break;
+        case OP_MULHSU: x[d.rd] = (uint32_t)(((int64_t)(int32_t)a * (int64_t)b) >> 32); break;
+        case OP_MULHU:  x[d.rd] = (uint32_t)(((uint64_t)a * b) >> 32); break;
+        case OP_DIV:
+            x[d.rd] = !b ? ~0u : (a == 0x80000000u && b == ~0u) ? a :
+                      (uint32_t)((int32_t)a / (int32_t)b);
+            break;
+        case OP_DIVU: x[d.rd] = b ? a / b : ~0u; break;
+        case OP_REM:
+            x[d.rd] = !b ? a : (a == 0x80000000u && b == ~0u) ? 0 :
+                      (uint32_t)((int32_t)a % (int32_t)b);
+            break;
+        case OP_REMU: x[d.rd] = b ? a % b : a; break;
+
+        case OP_SH1ADD: x[d.rd] = (a << 1) + b; break;
+        case OP_SH2ADD: x[d.rd] = (a << 2) + b; break;
+        case OP_SH3ADD: x[d.rd] = (a << 3) + b; break;
+        case OP_ANDN:   x[d.rd] = a & ~b; break;
+        case OP_ORN:    x[d.rd] = a | ~b; break;
+        case OP_XNOR:   x[d.rd] = ~(a ^ b); break;
+        case OP_MIN:    x[d.rd] = (int32_t)a < (int32_t)b ? a : b; break;
+        case OP_MINU:   x[d.rd] = a < b ? a : b; break;
+        case OP_MAX:    x[d.rd] = (int32_t)a < (int32_t)b ? b : a; break;
+        case OP_MAXU:   x[d.rd] = a < b ? b : a; break;
+        case OP_ZEXTH:  x[d.rd] = a & 0xFFFF; break;
+        case OP_ROL:    v = b & 31; x[d.rd] = v ? (a << v) | (a >> (32 - v)) : a; break;
+        case OP_ROR:    v = b & 31; x[d.rd] = v ? (a >> v) | (a << (32 - v)) : a; break;
+
+        case OP_SIMD:    x[d.rd] = simd(d.imm, a, b); break;
+        case OP_PSHUFBI: x[d.rd] = simd(7, a, d.imm); break;
+
+        case OP_CSR: {
+            uint32_t csr = d.imm & 0xFFF, f3 = d.imm >> 12;
+            uint32_t src = (f3 & 4) ? d.rs1 : a;
+            uint32_t old = csr_read(csr);
+            if ((f3 & 3) == 1 || d.rs1 != 0) {
+                switch (f3 & 3) {
+                case 2:  v = old | src; break;
+                case 3:  v = old & ~src; break;
+                default: v = src; break;
+                }
+                csr_write(csr, v);
+            }
+            x[d.rd] = old;
+            sync = (csr >> 8) == 0xB || (csr >> 8) == 0xC || csr == 0x344 || csr == 0x7C2;
+            break;
+        }
+
+        case OP_ECALL:   trap(11, 0, ipc); goto trapped;
+        case OP_EBREAK:  trap(3, ipc, ipc); goto trapped;
+        case OP_MRET:
+            npc = mepc;
+            mstatus_mie = mstatus_mpie;
+            mstatus_mpie = true;
+            set_bank(mzcfg & MZCFG_PBANK);
+            irq_check_at = 0;
+            break;
+        case OP_WFI:
+            // Sleeps until an enabled interrupt is pending, whatever MIE
+            // is; ends the run if none can arrive
+            if (!external_irq) {
+                uint64_t next = irq_check_at;
+                if (irq_wake(next)) break;
+                if (next == ~0ull) halt = true;
+                else if (next > cycle + 1) {
+                    wfi_cycles += next - cycle - 1;
+                    cycle = next - 1;
+                }
+            }
+            break;
+        default:         trap(2, d.imm, ipc); goto trapped;
+        }
+
+#undef LOAD
+#undef STORE
+#undef BRANCH
+
+        x[0] = 0;
+        pc = npc;
+        cycle++;
+        minstret++;
+        if (STEP) {
+            r->pc = ipc;
+            r->insn = insn;
+            r->rd = d.rd;
+            r->rd_we = d.rd != 0;
+            r->rd_data = x[d.rd];
+            r->sync = sync;
+            return 1;
+        }
+        continue;
+
+    trapped:
+        x[0] = 0;
+        cycle++;
+        if (STEP) return 0;
+    }
+    return i;
+}
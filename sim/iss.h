@@ -0,0 +1,220 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ================================================================
+// Z-Core Instruction-Set Simulator
+//
+// Functional model of the Z-Core SoC: RV32IMA + Zicsr plus the
+// Zba/Zbb and packed-SIMD instructions the core implements, 16 KB
+// RAM (aliased over the 64 MB memory window) and the axil_uart,
+// axil_gpio, axil_timer (driving mtip) and axil_vga slaves. Only
+// hart 0 is modelled: axil_hartctl reports a single hart.
+//
+// Decoding follows the RTL rather than the spec where they differ
+// (0x00000000 is a NOP, unknown CSRs read as 0), so the model can be
+// run in lockstep with the Verilator harness.
+//
+// Timing is one cycle per instruction: mcycle, the timer and the
+// VGA blanking status all advance with the instruction count. WFI
+// skips ahead to the next enabled interrupt (ignoring mstatus.MIE,
+// like the core) and counts the skipped cycles in wfi_cycles, read
+// as mhpmcounter12. A WFI that nothing can wake halts the run. In
+// lockstep (external_irq) it is a NOP and the RTL decides when the
+// interrupt comes.
+// ================================================================
+
+#ifndef Z_CORE_ISS_H
+#define Z_CORE_ISS_H
+
+#include <cstdint>
+#include <cstdio>
+
+class Iss {
+public:
+    static const uint32_t RAM_SIZE  = 16 * 1024;
+    static const uint32_t RAM_WIN   = 0x04000000;   // M0 window (64 MB)
+    static const uint32_t UART_BASE = 0x04000000;
+    static const uint32_t GPIO_BASE = 0x04001000;
+    static const uint32_t TIMER_BASE = 0x04002000;
+    static const uint32_t VGA_BASE  = 0x04003000;
+    static const uint32_t DMA_BASE  = 0x04004000;
+    static const uint32_t HARTCTL_BASE = 0x04005000;
+    static const uint32_t BUSMON_BASE = 0x04006000; // Not modelled, reads 0
+
+    static const int FB_WIDTH  = 160;               // Modes 0/1, 8 bpp
+    static const int FB_HEIGHT = 120;
+    static const int FB_BYTES  = 2 * FB_WIDTH * FB_HEIGHT;  // Mode 2: 320x240, 4 bpp
+    static const int TXT_COLS  = 40;                // Text layer, 8x8 cells at 320x240
+    static const int TXT_ROWS  = 30;
+
+    // One retired instruction, in the same terms as the RTL commit
+    // trace. sync is set when rd_data depends on state the model
+    // does not share with the RTL (MMIO loads, counter, mip and
+    // mzicctl CSRs).
+    struct Retire {
+        uint32_t pc;
+        uint32_t insn;
+        uint32_t rd_data;
+        uint8_t  rd;
+        bool     rd_we;
+        bool     sync;
+    };
+
+    Iss();
+
+    // Load an ELF (PT_LOAD segments, pc = entry), a $readmemh image
+    // (software/elf2hex.py, pc = 0) or a raw binary at address 0.
+    bool load(const char *path);
+
+    // Run up to max_insns instructions (0 = until halted).
+    // Returns the number executed.
+    uint64_t run(uint64_t max_insns);
+
+    // Execute one instruction. Returns false if it trapped, in which
+    // case nothing retired and pc is at the trap handler.
+    bool step(Retire &r);
+
+    // Enter the trap handler as for an interrupt taken before pc
+    void take_interrupt(uint32_t cause);
+
+    // Overwrite a register (lockstep: adopt the RTL value of a sync load)
+    void set_reg(int rd, uint32_t v) { if (rd) x[rd] = v; }
+
+    uint32_t reg(int i) const { return x[i]; }
+    uint32_t get_pc() const { return pc; }
+    uint64_t instret() const { return minstret; }
+    uint64_t cycles() const { return cycle; }
+    bool     halted() const { return halt; }
+
+    void set_gpio_in(uint64_t v) { gpio_in = v; }
+    bool write_frame(const char *path) const;   // Framebuffer as PPM
+
+    FILE *uart_out = stdout;                    // nullptr: discard TX
+    int   uart_in_fd = -1;                      // Polled for RX bytes
+
+    // Lockstep: interrupts are only taken through take_interrupt()
+    bool  external_irq = false;
+
+private:
+    struct Decoded {
+        uint8_t  op;
+        uint8_t  rd;
+        uint8_t  rs1;
+        uint8_t  rs2;
+        uint32_t imm;
+    };
+
+    template <bool STEP> uint64_t exec(uint64_t n, Retire *r);
+    void decode(uint32_t insn, Decoded &d);
+    void trap(uint32_t cause, uint32_t tval, uint32_t epc);
+    void set_bank(bool shadow);                 // Swap in mzcfg.BANK registers
+    void check_irq();
+    uint32_t irq_wake(uint64_t &next);          // Enabled pending mcause, or 0 and when to look again
+
+    uint32_t csr_read(uint32_t addr);
+    void     csr_write(uint32_t addr, uint32_t v);
+
+    uint32_t mmio_read(uint32_t addr);
+    void     mmio_write(uint32_t addr, uint32_t v, uint32_t mask);
+    bool     bus_read(uint32_t addr, uint32_t &v);
+    bool     bus_write(uint32_t addr, uint32_t v, uint32_t mask);
+    void     load_split(uint32_t addr, int bytes, uint8_t *q);
+    void     store_split(uint32_t addr, int bytes, uint32_t v);
+    void     uart_poll();
+
+    void     dma_run();
+    bool     dma_irq() const { return (dma_ctrl & 2) && (dma_done || dma_err); }
+
+    uint64_t timer_now() const;
+    void     timer_sync();
+    bool     timer_irq() const;
+    uint64_t timer_next_irq() const;
+
+    uint64_t vga_event_after(int src, uint64_t t) const;
+    void     vga_sync();
+    bool     vga_irq() { vga_sync(); return vga_irq_en & vga_irq_status; }
+
+    bool load_elf(const uint8_t *data, size_t size);
+    bool load_hex(FILE *f);
+
+    // Architectural state
+    uint32_t x[32];
+    uint32_t x_shadow[32];                      // Other bank of BANKED_REGS
+    uint32_t pc;
+    uint8_t  ram[RAM_SIZE];
+    Decoded  dcache[RAM_SIZE / 4];
+
+    bool     mstatus_mie = false, mstatus_mpie = false;
+    uint32_t mie = 0, mtvec = 0, mscratch = 0, mepc = 0, mcause = 0, mtval = 0;
+    uint64_t cycle = 0, minstret = 0;
+    int64_t  mcycle_adj = 0;                    // mcycle = cycle + mcycle_adj
+    uint32_t mzcfg = 0;                         // Z-Core config CSR (0x7C0)
+    uint32_t mzicaddr = 0;                      // I-cache preload address (0x7C1)
+    uint64_t misalign_splits = 0;               // mhpmcounter10
+    uint64_t wfi_cycles = 0;                    // mhpmcounter12
+    bool     resv_valid = false;                // LR/SC reservation (word)
+    uint32_t resv_addr = 0;
+
+    // Interrupts are re-evaluated once cycle reaches irq_check_at;
+    // anything that can change mtip or the enables pulls it in
+    uint64_t irq_check_at = 0;
+    bool     halt = false;
+
+    // axil_uart
+    uint16_t uart_baud_div = 326;
+    uint8_t  uart_ctrl = 3;
+    uint8_t  uart_tx = 0;
+    uint8_t  uart_rx = 0;
+    bool     uart_rx_valid = false;
+    uint64_t uart_poll_at = 0;
+
+    // axil_gpio
+    uint64_t gpio_out = 0, gpio_dir = 0, gpio_in = 0;
+
+    // axil_timer: 64-bit count as of timer_at
+    uint32_t timer_ctrl = 0;
+    uint64_t timer_val = 0, timer_at = 0;
+    uint64_t timer_cmp = ~0ull;
+
+    // axil_vga
+    uint8_t  fb[FB_BYTES];
+    uint32_t fb_addr = 0;
+    uint16_t vga_pal[256];
+    uint8_t  vga_mode = 0, vga_pal_index = 0, vga_pal_offset = 0;
+    uint16_t txt_ram[TXT_COLS * TXT_ROWS];
+    uint32_t txt_ctrl = 0, txt_pos = 0, txt_attr = 0x0F, txt_origin = 0;
+    uint32_t vga_scroll_x = 0, vga_scroll_y = 0, vga_line_cmp = 0;
+    uint32_t vga_irq_en = 0, vga_irq_status = 0;
+    uint64_t vga_synced = 0;                    // Raster events latched up to here
+
+    // axil_hartctl
+    uint32_t hart_boot = 0;
+
+    // axil_dma: transfers complete at START, except while waiting on
+    // a UART request line
+    uint32_t dma_src = 0, dma_dst = 0, dma_len = 0, dma_ctrl = 0, dma_next = 0;
+    bool     dma_busy = false, dma_done = false, dma_err = false;
+};
+
+#endif
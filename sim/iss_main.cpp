@@ -0,0 +1,146 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ================================================================
+// Z-Core Instruction-Set Simulator (standalone)
+//
+// Runs a program built by software/Makefile on the functional SoC
+// model in iss.cpp. UART TX goes to stdout, stdin feeds UART RX.
+//
+//   zsim <prog.elf|prog.hex|prog.bin> [--max N] [--trace out.ztr]
+//        [--frame out.ppm] [--gpio HEX]
+//
+// The run ends on Ctrl-C, after --max instructions, or when the
+// program spins on "j ." with no interrupt that could wake it (the
+// end of start.S). --trace writes the same .ztr format as the
+// Verilator harness, with one cycle per instruction and no stalls,
+// for trace_report.py and icache_layout.py.
+// ================================================================
+
+#include "iss.h"
+
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+static const int RECORD_SIZE = 24;
+static const uint64_t CHUNK = 1 << 20;
+
+static volatile sig_atomic_t stop = 0;
+
+static void on_sigint(int) { stop = 1; }
+
+static void put32(uint8_t *p, uint32_t v) {
+    p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+int main(int argc, char **argv) {
+    const char *image      = nullptr;
+    const char *trace_path = nullptr;
+    const char *frame_path = nullptr;
+    uint64_t    max_insns  = 0;
+    uint64_t    gpio_in    = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--max") && i + 1 < argc)
+            max_insns = strtoull(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--trace") && i + 1 < argc)
+            trace_path = argv[++i];
+        else if (!strcmp(argv[i], "--frame") && i + 1 < argc)
+            frame_path = argv[++i];
+        else if (!strcmp(argv[i], "--gpio") && i + 1 < argc)
+            gpio_in = strtoull(argv[++i], nullptr, 16);
+        else if (argv[i][0] != '-' && !image)
+            image = argv[i];
+        else {
+            fprintf(stderr, "usage: %s <prog.elf|.hex|.bin> [--max N] [--trace out.ztr] "
+                            "[--frame out.ppm] [--gpio HEX]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (!image) {
+        fprintf(stderr, "usage: %s <prog.elf|.hex|.bin> [options]\n", argv[0]);
+        return 2;
+    }
+
+    static Iss iss;
+    if (!iss.load(image)) return 1;
+    iss.set_gpio_in(gpio_in);
+
+    fcntl(STDIN_FILENO, F_SETFL, fcntl(STDIN_FILENO, F_GETFL) | O_NONBLOCK);
+    iss.uart_in_fd = STDIN_FILENO;
+    signal(SIGINT, on_sigint);
+
+    FILE *trace = nullptr;
+    if (trace_path) {
+        trace = fopen(trace_path, "wb");
+        if (!trace) { perror(trace_path); return 1; }
+        uint8_t hdr[12];
+        memcpy(hdr, "ZTRC", 4);
+        put32(hdr + 4, 1);
+        put32(hdr + 8, RECORD_SIZE);
+        fwrite(hdr, 1, sizeof(hdr), trace);
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    uint64_t executed = 0;
+
+    while (!stop && !iss.halted() && (!max_insns || executed < max_insns)) {
+        uint64_t n = CHUNK;
+        if (max_insns && max_insns - executed < n) n = max_insns - executed;
+
+        if (!trace) {
+            executed += iss.run(n);
+            continue;
+        }
+        for (uint64_t k = 0; k < n; k++, executed++) {
+            Iss::Retire r;
+            uint64_t cycle = iss.cycles();
+            if (!iss.step(r)) continue;
+            uint8_t rec[RECORD_SIZE] = {0};
+            put32(rec + 0,  (uint32_t)cycle);
+            put32(rec + 4,  r.pc);
+            put32(rec + 8,  r.insn);
+            put32(rec + 12, r.rd_data);
+            rec[16] = (r.insn >> 7 & 0x1F) | (r.rd_we << 5);
+            fwrite(rec, 1, RECORD_SIZE, trace);
+        }
+    }
+
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    fflush(stdout);
+    fprintf(stderr, "\n[zsim] %s at pc 0x%08x\n",
+            iss.halted() ? "halted" : "stopped", iss.get_pc());
+    fprintf(stderr, "[zsim] retired %llu instructions in %.2f s (%.1f MIPS)\n",
+            (unsigned long long)iss.instret(), secs,
+            secs > 0 ? executed / secs / 1e6 : 0.0);
+
+    if (trace) fclose(trace);
+    if (frame_path && iss.write_frame(frame_path))
+        fprintf(stderr, "[zsim] wrote %s\n", frame_path);
+    return 0;
+}
@@ -0,0 +1,650 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ================================================================
+// Z-Core Verilator Harness
+//
+// Runs z_core_top with a program image loaded at address 0, prints
+// UART output to stdout and optionally writes a commit trace.
+//
+//   Vz_core_top +image=<prog.hex> [--cycles N] [--trace out.ztr]
+//               [--baud-div N] [--lockstep] [--busmon]
+//               [--pty] [--pty-link PATH] [--gpio script] [--leds]
+//               [--frames DIR] [--video out.rgb] [--frame-every N]
+//               [--fps]
+//
+// --cycles 0 runs until Ctrl-C. --baud-div must match the divisor
+// the program sets (27 for the bootloader's 115200 baud).
+//
+// --pty bridges the UART to a pseudo-terminal instead of stdout and
+// stdin, so serial tools (upload.py, picocom) can open it as a port.
+// --gpio drives gpio_pins from a script of "<time> <hex pins>"
+// lines, the time in cycles or with a us/ms suffix. --leds logs
+// LEDR[7:0] changes.
+//
+// --frames/--video rebuild 640x480 frames from VGA_R/G/B/HS/VS and
+// write them as PPM files or one raw RGB24 stream (ffmpeg -f rawvideo
+// -pix_fmt rgb24 -s 640x480 -r 60). --fps reports how many of the
+// 60 Hz frames changed, which is the program's frame rate.
+//
+// --lockstep runs the instruction-set simulator (iss.cpp) on the
+// same image and compares every retired PC, instruction and register
+// write against it, stopping at the first divergence. Values the ISS
+// cannot know (MMIO loads, mcycle/minstret/mhpm and mip reads) are
+// copied from the RTL, and interrupts are taken where the RTL takes
+// them (trace_irq).
+//
+// --busmon prints the bus monitor counters (axil_bus_mon) for each
+// interconnect port at exit, read through the busmon_idx side-band
+// port so the dump does not add bus traffic.
+//
+// Trace file (.ztr), little-endian:
+//   Header  : "ZTRC", u32 version (1), u32 record size (24)
+//   Record  : u32 cycle, u32 pc, u32 insn, u32 rd_data,
+//             u8  flags   [4:0] rd, [5] rd written, [6] lane 1
+//             u8  stall[6] cycles lost since the previous record,
+//                          per cause (MEM, BUS, DIV, LOAD_USE,
+//                          FETCH, FLUSH), saturating at 255
+//             u8  reserved
+// ================================================================
+
+#include "Vz_core_top.h"
+#include "verilated.h"
+#include "iss.h"
+
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <termios.h>
+#include <unistd.h>
+
+static const int N_STALL = 6;
+static const int RECORD_SIZE = 24;
+static const double CLK_HZ = 50e6;
+
+// axil_bus_mon layout: word index of port m's block and its counters
+static const int BUSMON_BLOCK = 32;
+enum { BM_RD_COUNT, BM_WR_COUNT, BM_RD_BUSY, BM_WR_BUSY, BM_RD_WAIT,
+       BM_WR_WAIT, BM_RD_MAX, BM_WR_MAX, BM_RD_HIST, BM_WR_HIST = BM_RD_HIST + 8 };
+
+static volatile sig_atomic_t stop = 0;
+
+static void on_sigint(int) { stop = 1; }
+
+static void put32(uint8_t *p, uint32_t v) {
+    p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+}
+
+// ----------------------------------------------------------------
+// UART TX monitor (8N1, bit period = 16 * BAUD_DIV clocks)
+// ----------------------------------------------------------------
+struct UartMonitor {
+    uint32_t bit_clks;
+    uint32_t count = 0;
+    int      bit = -1;    // -1: idle, 0: start, 1..8: data, 9: stop
+    uint8_t  shift = 0;
+
+    explicit UartMonitor(uint32_t baud_div) : bit_clks(16 * baud_div) {}
+
+    // Returns the received byte at its stop bit, else -1
+    int tick(int tx) {
+        if (bit < 0) {
+            if (!tx) { bit = 0; count = bit_clks / 2; }  // Sample mid-bit
+            return -1;
+        }
+        if (--count) return -1;
+        count = bit_clks;
+        if (bit == 0) {
+            if (tx) bit = -1;                   // Glitch, not a start bit
+            else    bit = 1;
+        } else if (bit <= 8) {
+            shift = (shift >> 1) | (tx ? 0x80 : 0);
+            bit++;
+        } else {
+            bit = -1;
+            return shift;
+        }
+        return -1;
+    }
+};
+
+// ----------------------------------------------------------------
+// UART RX driver (8N1, same bit period as the monitor)
+// ----------------------------------------------------------------
+struct UartDriver {
+    uint32_t bit_clks;
+    uint32_t count = 0;
+    int      bit = -1;    // -1: idle, 0: start, 1..8: data, 9: stop
+    uint16_t frame = 0;
+
+    explicit UartDriver(uint32_t baud_div) : bit_clks(16 * baud_div) {}
+
+    bool idle() const { return bit < 0; }
+
+    void send(uint8_t b) {
+        frame = 0x200 | (b << 1);           // Stop, data LSB first, start
+        bit = 0;
+        count = bit_clks;
+    }
+
+    // Level for uart_rx this cycle
+    int tick() {
+        if (bit < 0) return 1;
+        int v = (frame >> bit) & 1;
+        if (!--count) {
+            count = bit_clks;
+            if (++bit == 10) bit = -1;
+        }
+        return v;
+    }
+};
+
+// ----------------------------------------------------------------
+// UART pty bridge: the harness holds the master, serial tools open
+// the slave as their port. Bytes are taken from the master one at a
+// time as the RX line is free, so the host is paced like a real port.
+// ----------------------------------------------------------------
+struct UartPty {
+    int fd = -1;
+    int slave = -1;
+
+    bool open(const char *link) {
+        fd = posix_openpt(O_RDWR | O_NOCTTY);
+        if (fd < 0 || grantpt(fd) || unlockpt(fd)) {
+            perror("pty");
+            return false;
+        }
+        const char *name = ptsname(fd);
+
+        // Keep the slave open so the master does not read EIO each
+        // time a client closes it. Raw, as a serial port would be.
+        slave = ::open(name, O_RDWR | O_NOCTTY);
+        struct termios t;
+        if (slave >= 0 && !tcgetattr(slave, &t)) {
+            cfmakeraw(&t);
+            tcsetattr(slave, TCSANOW, &t);
+        }
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+        if (link) {
+            unlink(link);
+            if (symlink(name, link)) perror(link);
+        }
+        fprintf(stderr, "[uart] pty %s%s%s\n", name, link ? " -> " : "", link ? link : "");
+        return true;
+    }
+
+    int getc() {
+        uint8_t b;
+        return read(fd, &b, 1) == 1 ? b : -1;
+    }
+
+    void putc(uint8_t b) {
+        // Dropped when the slave's buffer is full (nobody reading)
+        if (write(fd, &b, 1) != 1) return;
+    }
+};
+
+// ----------------------------------------------------------------
+// VGA capture: 640x480 frames rebuilt from the VGA pins
+// ----------------------------------------------------------------
+// axil_vga updates HS/VS on the 25 MHz pixel enable and puts pixel
+// h_count on the RGB pins three clocks after h_count, so counting
+// clocks from the HS falling edge, pixel h is stable at 2 * h + 2.
+// VS falls on the same clock as the HS of line 0.
+struct VgaCapture {
+    static const int W = 640, H = 480;
+    static const int H_START = 96 + 48;     // Sync + back porch
+    static const int V_START = 2 + 33;
+
+    std::vector<uint8_t> frame, prev;
+    const char *dir = nullptr;              // frame_NNNNN.ppm
+    FILE       *video = nullptr;            // Raw RGB24
+    uint32_t    every = 1;                  // Write one frame in N
+
+    int      hs = 1, vs = 1;
+    uint32_t clk = 0;
+    int      line = -1;
+    bool     started = false;               // Seen a VS edge
+    uint64_t frames = 0, changed = 0;
+    uint64_t first_cycle = 0, last_cycle = 0;
+
+    VgaCapture() : frame(W * H * 3), prev(W * H * 3) {}
+
+    void tick(uint64_t cycle, int hs_in, int vs_in, int r, int g, int b) {
+        if (vs && !vs_in) {
+            if (started) end_frame(cycle);
+            else first_cycle = cycle;
+            started = true;
+            line = -1;
+        }
+        if (hs && !hs_in) {
+            line++;
+            clk = 0;
+        } else {
+            clk++;
+        }
+        hs = hs_in;
+        vs = vs_in;
+        if (!started || (clk & 1) || clk < 2) return;
+
+        int x = (int)(clk / 2) - 1 - H_START;
+        int y = line - V_START;
+        if (x < 0 || x >= W || y < 0 || y >= H) return;
+        uint8_t *p = &frame[(y * W + x) * 3];
+        p[0] = r * 17;                      // 4-bit DAC to 8 bits
+        p[1] = g * 17;
+        p[2] = b * 17;
+    }
+
+    void end_frame(uint64_t cycle) {
+        if (frames && frame != prev) changed++;
+        if (frames % every == 0) {
+            if (dir) {
+                char path[512];
+                snprintf(path, sizeof(path), "%s/frame_%05llu.ppm", dir, (unsigned long long)frames);
+                FILE *f = fopen(path, "wb");
+                if (f) {
+                    fprintf(f, "P6\n%d %d\n255\n", W, H);
+                    fwrite(frame.data(), 1, frame.size(), f);
+                    fclose(f);
+                }
+            }
+            if (video) fwrite(frame.data(), 1, frame.size(), video);
+        }
+        frames++;
+        last_cycle = cycle;
+        frame.swap(prev);
+    }
+
+    void report() const {
+        if (frames < 2) {
+            fprintf(stderr, "[vga] %llu frames\n", (unsigned long long)frames);
+            return;
+        }
+        double secs = (last_cycle - first_cycle) / CLK_HZ;
+        fprintf(stderr, "[vga] %llu frames in %.3f s simulated, %llu changed (%.1f fps)\n",
+                (unsigned long long)frames, secs, (unsigned long long)changed, changed / secs);
+    }
+};
+
+// ----------------------------------------------------------------
+// GPIO script: "<time> <hex pins>" per line, '#' comments. The time
+// is in cycles, or in us/ms with a suffix. Switches are GPIO[15:8].
+// ----------------------------------------------------------------
+struct GpioScript {
+    struct Step { uint64_t cycle; uint32_t pins; };
+    std::vector<Step> steps;
+    size_t next = 0;
+
+    bool load(const char *path) {
+        FILE *f = fopen(path, "r");
+        if (!f) { perror(path); return false; }
+        char buf[256];
+        for (int n = 1; fgets(buf, sizeof(buf), f); n++) {
+            char *p = buf + strspn(buf, " \t");
+            if (*p == '#' || *p == '\n' || *p == '\r' || !*p) continue;
+
+            char *end;
+            double t = strtod(p, &end);
+            if (!strncmp(end, "ms", 2))      { t *= CLK_HZ / 1e3; end += 2; }
+            else if (!strncmp(end, "us", 2)) { t *= CLK_HZ / 1e6; end += 2; }
+
+            char *vend;
+            uint32_t pins = strtoul(end, &vend, 16);
+            uint64_t cycle = (uint64_t)t;
+            if (end == p || vend == end || (!steps.empty() && cycle < steps.back().cycle)) {
+                fprintf(stderr, "%s:%d: expected \"<time> <hex pins>\" in time order\n", path, n);
+                fclose(f);
+                return false;
+            }
+            steps.push_back({cycle, pins});
+        }
+        fclose(f);
+        return true;
+    }
+
+    bool due(uint64_t cycle) const { return next < steps.size() && steps[next].cycle <= cycle; }
+    uint32_t pop() { return steps[next++].pins; }
+};
+
+// ----------------------------------------------------------------
+// Bus monitor dump
+// ----------------------------------------------------------------
+static uint32_t busmon_read(Vz_core_top *top, int idx) {
+    top->busmon_idx = idx;
+    top->eval();
+    return top->busmon_data;
+}
+
+static void busmon_dump(Vz_core_top *top) {
+    static const char *names[] = {"RAM", "UART", "GPIO", "Timer", "VGA", "DMA", "Harts"};
+    uint32_t info = busmon_read(top, 1);
+    int ports = info & 0xFF, bins = (info >> 8) & 0xFF;
+
+    if (ports == 0) return;
+    fprintf(stderr, "[busmon] %u cycles\n", busmon_read(top, 2));
+    fprintf(stderr, "[busmon] %-6s %2s %9s %10s %10s %7s %5s  latency 1/2/3-4/5-8/9-16/17-32/33-64/>64\n",
+            "port", "", "count", "busy", "wait", "avg", "max");
+    for (int m = 0; m < ports; m++) {
+        int base = (m + 1) * BUSMON_BLOCK;
+        for (int wr = 0; wr < 2; wr++) {
+            uint32_t n    = busmon_read(top, base + BM_RD_COUNT + wr);
+            uint32_t busy = busmon_read(top, base + BM_RD_BUSY + wr);
+            if (!n && !busy) continue;
+            fprintf(stderr, "[busmon] %-6s %2s %9u %10u %10u %7.2f %5u ",
+                    m < 7 ? names[m] : "?", wr ? "W" : "R", n, busy,
+                    busmon_read(top, base + BM_RD_WAIT + wr),
+                    n ? (double)busy / n : 0.0,
+                    busmon_read(top, base + BM_RD_MAX + wr));
+            for (int b = 0; b < bins; b++)
+                fprintf(stderr, " %u", busmon_read(top, base + (wr ? BM_WR_HIST : BM_RD_HIST) + b));
+            fprintf(stderr, "\n");
+        }
+    }
+}
+
+// ----------------------------------------------------------------
+// ISS lockstep checker
+// ----------------------------------------------------------------
+struct Lockstep {
+    Iss      iss;
+    bool     irq_pending = false;
+    uint32_t irq_epc = 0;
+    uint32_t irq_cause = 0;
+    uint64_t matched = 0;
+
+    bool load(const char *path) {
+        iss.external_irq = true;
+        iss.uart_out = nullptr;
+        return iss.load(path);
+    }
+
+    void interrupt(uint32_t epc, uint32_t cause) {
+        irq_pending = true;
+        irq_epc = epc;
+        irq_cause = cause;
+    }
+
+    // Returns false on divergence
+    bool check(uint64_t cycle, uint32_t pc, uint32_t insn, int rd, bool rd_we, uint32_t rd_data) {
+        Iss::Retire r = {};
+        bool retired = false;
+
+        // Instructions that trap retire nothing; step through them
+        for (int tries = 0; tries < 4 && !retired; tries++) {
+            if (irq_pending && iss.get_pc() == irq_epc) {
+                iss.take_interrupt(irq_cause);
+                irq_pending = false;
+            }
+            retired = iss.step(r);
+        }
+
+        if (retired && r.sync && r.rd_we && rd_we && r.rd == rd) {
+            iss.set_reg(rd, rd_data);
+            r.rd_data = rd_data;
+        }
+
+        if (retired && r.pc == pc && r.insn == insn && r.rd_we == rd_we &&
+            (!rd_we || (r.rd == rd && r.rd_data == rd_data))) {
+            matched++;
+            return true;
+        }
+
+        fprintf(stderr, "\n[lockstep] divergence at cycle %llu after %llu instructions\n",
+                (unsigned long long)cycle, (unsigned long long)matched);
+        fprintf(stderr, "[lockstep]   RTL: pc %08x insn %08x", pc, insn);
+        if (rd_we) fprintf(stderr, " x%d <- %08x", rd, rd_data);
+        fprintf(stderr, "\n[lockstep]   ISS: ");
+        if (!retired) {
+            fprintf(stderr, "trapping at pc %08x\n", iss.get_pc());
+        } else {
+            fprintf(stderr, "pc %08x insn %08x", r.pc, r.insn);
+            if (r.rd_we) fprintf(stderr, " x%d <- %08x", r.rd, r.rd_data);
+            fprintf(stderr, "\n");
+        }
+        return false;
+    }
+};
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+
+    uint64_t    max_cycles = 2000000;
+    const char *trace_path = nullptr;
+    uint32_t    baud_div   = 326;   // axil_uart DEFAULT_BAUD_DIV
+    bool        lockstep   = false;
+    bool        busmon     = false;
+    bool        use_pty    = false;
+    const char *pty_link   = nullptr;
+    const char *gpio_path  = nullptr;
+    bool        log_leds   = false;
+    const char *frames_dir = nullptr;
+    const char *video_path = nullptr;
+    uint32_t    frame_every = 1;
+    bool        fps        = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--cycles") && i + 1 < argc)
+            max_cycles = strtoull(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--trace") && i + 1 < argc)
+            trace_path = argv[++i];
+        else if (!strcmp(argv[i], "--baud-div") && i + 1 < argc)
+            baud_div = strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--lockstep"))
+            lockstep = true;
+        else if (!strcmp(argv[i], "--busmon"))
+            busmon = true;
+        else if (!strcmp(argv[i], "--pty"))
+            use_pty = true;
+        else if (!strcmp(argv[i], "--pty-link") && i + 1 < argc)
+            use_pty = true, pty_link = argv[++i];
+        else if (!strcmp(argv[i], "--gpio") && i + 1 < argc)
+            gpio_path = argv[++i];
+        else if (!strcmp(argv[i], "--leds"))
+            log_leds = true;
+        else if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+            frames_dir = argv[++i];
+        else if (!strcmp(argv[i], "--video") && i + 1 < argc)
+            video_path = argv[++i];
+        else if (!strcmp(argv[i], "--frame-every") && i + 1 < argc)
+            frame_every = strtoul(argv[++i], nullptr, 0);
+        else if (!strcmp(argv[i], "--fps"))
+            fps = true;
+    }
+
+    Lockstep *ref = nullptr;
+    if (lockstep) {
+        const char *arg = Verilated::commandArgsPlusMatch("image=");
+        ref = new Lockstep;
+        if (!*arg || !ref->load(arg + strlen("+image="))) {
+            fprintf(stderr, "--lockstep needs a loadable +image=\n");
+            return 1;
+        }
+    }
+    int status = 0;
+
+    FILE *trace = nullptr;
+    if (trace_path) {
+        trace = fopen(trace_path, "wb");
+        if (!trace) { perror(trace_path); return 1; }
+        uint8_t hdr[12];
+        memcpy(hdr, "ZTRC", 4);
+        put32(hdr + 4, 1);
+        put32(hdr + 8, RECORD_SIZE);
+        fwrite(hdr, 1, sizeof(hdr), trace);
+    }
+
+    UartPty pty;
+    if (use_pty && !pty.open(pty_link)) return 1;
+
+    GpioScript gpio;
+    if (gpio_path && !gpio.load(gpio_path)) return 1;
+
+    VgaCapture *vga = nullptr;
+    if (frames_dir || video_path || fps) {
+        vga = new VgaCapture;
+        vga->every = frame_every ? frame_every : 1;
+        if (frames_dir) {
+            mkdir(frames_dir, 0777);
+            vga->dir = frames_dir;
+        }
+        if (video_path) {
+            vga->video = fopen(video_path, "wb");
+            if (!vga->video) { perror(video_path); return 1; }
+        }
+    }
+
+    Vz_core_top *top = new Vz_core_top;
+    UartMonitor uart(baud_div);
+    UartDriver uart_in(baud_div);
+
+    top->KEY = 0;                   // KEY[0] = rstn (active low)
+    top->uart_rx = 1;
+    top->timer_ext_event_i = 0;
+    top->busmon_idx = 0;
+    top->gpio_pins = 0;
+    uint32_t leds = 0;
+
+    signal(SIGINT, on_sigint);
+    auto t0 = std::chrono::steady_clock::now();
+    uint64_t cycle = 0;
+
+    uint32_t stall_acc[N_STALL] = {0};
+    uint64_t stall_total[N_STALL] = {0};
+    uint64_t retired = 0;
+
+    for (; (!max_cycles || cycle < max_cycles) && !stop && !Verilated::gotFinish() && !status; cycle++) {
+        if (cycle == 10) top->KEY = 3;
+
+        while (gpio.due(cycle))
+            top->gpio_pins = gpio.pop();
+
+        // Poll the pty between bytes only; a read per cycle would
+        // dominate the run time
+        if (pty.fd >= 0 && uart_in.idle() && !(cycle & 0xFF)) {
+            int c = pty.getc();
+            if (c >= 0) uart_in.send(c);
+        }
+        top->uart_rx = uart_in.tick();
+
+        top->MAX10_CLK1_50 = 0;
+        top->eval();
+        top->MAX10_CLK1_50 = 1;
+        top->eval();
+
+        int c = uart.tick(top->uart_tx);
+        if (c >= 0) {
+            if (pty.fd >= 0) {
+                pty.putc(c);
+            } else {
+                putchar(c);
+                fflush(stdout);
+            }
+        }
+
+        if (vga)
+            vga->tick(cycle, top->VGA_HS, top->VGA_VS, top->VGA_R, top->VGA_G, top->VGA_B);
+
+        if (log_leds && (top->LEDR & 0xFF) != leds) {
+            leds = top->LEDR & 0xFF;
+            fprintf(stderr, "[gpio] %10llu  leds %02x\n", (unsigned long long)cycle, leds);
+        }
+
+        if (cycle < 10) continue;
+
+        for (int c = 0; c < N_STALL; c++) {
+            if (top->stall_cause & (1u << c)) {
+                stall_acc[c]++;
+                stall_total[c]++;
+            }
+        }
+
+        if (ref && top->trace_irq)
+            ref->interrupt(top->trace_irq_epc, top->trace_irq_cause);
+
+        for (int lane = 0; lane < 2; lane++) {
+            if (!(top->trace_valid & (1u << lane))) continue;
+            retired++;
+
+            if (ref && status == 0 &&
+                !ref->check(cycle,
+                            (uint32_t)(top->trace_pc      >> (32 * lane)),
+                            (uint32_t)(top->trace_insn    >> (32 * lane)),
+                            (top->trace_rd >> (5 * lane)) & 0x1F,
+                            (top->trace_rd_we >> lane) & 1,
+                            (uint32_t)(top->trace_rd_data >> (32 * lane))))
+                status = 1;
+
+            if (!trace) continue;
+
+            uint8_t rec[RECORD_SIZE] = {0};
+            put32(rec + 0,  (uint32_t)cycle);
+            put32(rec + 4,  (uint32_t)(top->trace_pc      >> (32 * lane)));
+            put32(rec + 8,  (uint32_t)(top->trace_insn    >> (32 * lane)));
+            put32(rec + 12, (uint32_t)(top->trace_rd_data >> (32 * lane)));
+            rec[16] = ((top->trace_rd >> (5 * lane)) & 0x1F) |
+                      (((top->trace_rd_we >> lane) & 1) << 5) |
+                      (lane << 6);
+            for (int c = 0; c < N_STALL; c++) {
+                rec[17 + c] = stall_acc[c] > 255 ? 255 : stall_acc[c];
+                stall_acc[c] = 0;
+            }
+            fwrite(rec, 1, RECORD_SIZE, trace);
+        }
+    }
+
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    static const char *names[N_STALL] = {"MEM", "BUS", "DIV", "LOAD_USE", "FETCH", "FLUSH"};
+    fprintf(stderr, "\n[sim] %llu cycles in %.2f s (%.2f MHz)\n",
+            (unsigned long long)cycle, secs, secs > 0 ? cycle / secs / 1e6 : 0.0);
+    fprintf(stderr, "[sim] retired %llu instructions\n", (unsigned long long)retired);
+    for (int c = 0; c < N_STALL; c++)
+        fprintf(stderr, "[sim] stall %-8s %llu\n", names[c], (unsigned long long)stall_total[c]);
+
+    if (busmon)
+        busmon_dump(top);
+
+    if (vga) {
+        vga->report();
+        if (vga->video) fclose(vga->video);
+        delete vga;
+    }
+
+    if (ref && !status)
+        fprintf(stderr, "[sim] lockstep: %llu instructions match the ISS\n",
+                (unsigned long long)ref->matched);
+
+    if (trace) fclose(trace);
+    top->final();
+    delete top;
+    delete ref;
+    return status;
+}
@@ -0,0 +1,113 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ================================================================
+// Zba/Zbb Bit-Manipulation Test - Z-Core
+// Instructions are emitted with .insn so this builds with or
+// without ZBB=1 (the assembler does not need to know Zba/Zbb)
+// ================================================================
+
+#include "libs/uart.h"
+
+#define GPIO_OUT (*((volatile unsigned int *)0x04001000))
+#define GPIO_DIR (*((volatile unsigned int *)0x04001008))
+
+// R-type: opcode 0x33, funct3, funct7
+#define BM_R(f3, f7, a, b) ({ unsigned int _r; \
+  asm volatile(".insn r 0x33, " #f3 ", " #f7 ", %0, %1, %2" : "=r"(_r) : "r"(a), "r"(b)); _r; })
+
+// R-type with rs2 = x0 (unary ops such as zext.h)
+#define BM_R0(f3, f7, a) ({ unsigned int _r; \
+  asm volatile(".insn r 0x33, " #f3 ", " #f7 ", %0, %1, x0" : "=r"(_r) : "r"(a)); _r; })
+
+// I-type: opcode 0x13, funct3, imm[11:0] = {funct7, rs2/shamt}
+#define BM_I(f3, imm, a) ({ unsigned int _r; \
+  asm volatile(".insn i 0x13, " #f3 ", %0, %1, " #imm : "=r"(_r) : "r"(a)); _r; })
+
+int p = 0, f = 0;
+
+void __attribute__((noinline)) check(const char *name, unsigned int r, unsigned int exp) {
+  uart_puts(name); uart_putc('=');
+  uart_puthex(r);
+  uart_puts(" exp:"); uart_puthex(exp);
+
+  if (r == exp) { uart_puts(" OK\r\n"); p++; }
+  else { uart_puts(" FAIL\r\n"); f++; }
+}
+
+int main(void) {
+  GPIO_DIR = 0xFF;
+  GPIO_OUT = 0x01;
+
+  volatile unsigned int a = 0x00F0A501;
+  volatile unsigned int b = 0x0000000C;
+  volatile unsigned int n = 0xFFFFFF80;  // -128
+
+  uart_puts("\r\n=== Z-Core Zba/Zbb Test ===\r\n\r\n");
+
+  uart_puts("-- Zba --\r\n");
+  check("sh1add", BM_R(2, 0x10, b, a), 0x00F0A519);
+  check("sh2add", BM_R(4, 0x10, b, a), 0x00F0A531);
+  check("sh3add", BM_R(6, 0x10, b, a), 0x00F0A561);
+
+  uart_puts("\r\n-- Zbb logic --\r\n");
+  check("andn", BM_R(7, 0x20, a, b), 0x00F0A501);
+  check("orn",  BM_R(6, 0x20, a, b), 0xFFFFFFF3);
+  check("xnor", BM_R(4, 0x20, a, b), 0xFF0F5AF2);
+
+  uart_puts("\r\n-- Zbb count --\r\n");
+  check("clz",  BM_I(1, 0x600, a), 8);
+  check("ctz",  BM_I(1, 0x601, n), 7);
+  check("cpop", BM_I(1, 0x602, a), 9);
+  check("clz0", BM_I(1, 0x600, 0), 32);
+
+  uart_puts("\r\n-- Zbb min/max --\r\n");
+  check("min",  BM_R(4, 0x05, n, b), 0xFFFFFF80);
+  check("minu", BM_R(5, 0x05, n, b), 0x0000000C);
+  check("max",  BM_R(6, 0x05, n, b), 0x0000000C);
+  check("maxu", BM_R(7, 0x05, n, b), 0xFFFFFF80);
+
+  uart_puts("\r\n-- Zbb extend --\r\n");
+  check("sext.b", BM_I(1, 0x604, n), 0xFFFFFF80);
+  check("sext.h", BM_I(1, 0x605, a), 0xFFFFA501);
+  check("zext.h", BM_R0(4, 0x04, n), 0x0000FF80);
+
+  uart_puts("\r\n-- Zbb rotate/bytes --\r\n");
+  check("rol",   BM_R(1, 0x30, a, b), 0x0A50100F);
+  check("ror",   BM_R(5, 0x30, a, b), 0x50100F0A);
+  check("rori",  BM_I(5, 0x608, a), 0x0100F0A5);
+  check("orc.b", BM_I(5, 0x287, a), 0x00FFFFFF);
+  check("rev8",  BM_I(5, 0x698, a), 0x01A5F000);
+
+  uart_puts("\r\n=================\r\n");
+  uart_puts("PASS:"); uart_puthex((unsigned int)p);
+  uart_puts(" FAIL:"); uart_puthex((unsigned int)f);
+  uart_puts("\r\n");
+
+  GPIO_OUT = (f == 0) ? 0xAA : 0x55;
+  uart_puts(f == 0 ? "ALL PASSED\r\n" : "SOME FAILED\r\n");
+
+  while (1);
+  return 0;
+}
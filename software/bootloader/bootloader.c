@@ -3,6 +3,17 @@
 #define APP_BASE       0x00001000
 #define APP_MAX_SIZE   (12 * 1024)  /* 12 KB */
 
+/* Size word bit 31: an LZ4 block stream follows instead of raw bytes.
+ * The low bits are the decompressed size. */
+#define SIZE_LZ4       0x80000000u
+
+/* Size word bit 30: delta upload. The bootloader reports a hash of each
+ * DELTA_BLOCK of the current app region (RAM survives a KEY[0] reset)
+ * and receives only the blocks that changed. */
+#define SIZE_DELTA     0x40000000u
+#define DELTA_BLOCK    256
+#define DELTA_END      0xFF
+
 #define SYNC_REQ       0x5A
 #define SYNC_ACK       0xA5
 #define ACK            0x06
@@ -11,6 +22,21 @@
 /* 50 MHz / (16 * 115200) ≈ 27 */
 #define BAUD_DIV_115200 27
 
+#define UART_RX_READY  0x04         /* UART_STAT bit 2 */
+
+/* Header of the resident app, just below it. RAM survives a KEY[0]
+ * reset, so after one the bootloader checks the image against it and
+ * starts the app again unless the host syncs within BOOT_WINDOW. */
+typedef struct {
+    unsigned int magic;
+    unsigned int size;
+    unsigned int crc;               /* CRC-32 of the size bytes at APP_BASE */
+} app_header_t;
+
+#define APP_HDR        ((volatile app_header_t *)(APP_BASE - 16))
+#define APP_MAGIC      0x5050415Au  /* "ZAPP" in memory */
+#define BOOT_WINDOW    (50000000 / 1000 * 50)   /* 50 ms */
+
 static unsigned int recv_le32(void) {
     unsigned int v = 0;
     v |= ((unsigned int)(unsigned char)uart_getc_blocking());
@@ -20,13 +46,175 @@ static unsigned int recv_le32(void) {
     return v;
 }
 
+static inline unsigned char recv_byte(void) {
+    return (unsigned char)uart_getc_blocking();
+}
+
+/* LZ4 length field: 15 means extension bytes follow, 255 = continue */
+static unsigned int lz4_len(unsigned int n) {
+    if (n == 15) {
+        unsigned char b;
+        do {
+            b = recv_byte();
+            n += b;
+        } while (b == 255);
+    }
+    return n;
+}
+
+/*
+ * Decompress an LZ4 block from the UART straight into dest as it
+ * arrives. Matches copy from the already written output, so no input
+ * buffer is needed. upload.py caps matches so each copy finishes
+ * within one byte time (the UART holds a single RX byte).
+ * Returns 0 and the byte sum of the output, or -1 on a malformed stream.
+ */
+static int recv_lz4(unsigned char *dest, unsigned int size, unsigned int *sum) {
+    unsigned char *out = dest;
+    unsigned char *end = dest + size;
+    unsigned int s = 0;
+
+    while (1) {
+        unsigned char token = recv_byte();
+
+        unsigned int n = lz4_len(token >> 4);
+        if (n > (unsigned int)(end - out))
+            return -1;
+        while (n--) {
+            unsigned char b = recv_byte();
+            *out++ = b;
+            s += b;
+        }
+        if (out == end)
+            break;
+
+        unsigned int off = recv_byte();
+        off |= (unsigned int)recv_byte() << 8;
+        n = lz4_len(token & 15) + 4;
+        if (off == 0 || off > (unsigned int)(out - dest) || n > (unsigned int)(end - out))
+            return -1;
+
+        const unsigned char *src = out - off;
+        while (n--) {
+            unsigned char b = *src++;
+            *out++ = b;
+            s += b;
+        }
+    }
+
+    *sum = s;
+    return 0;
+}
+
+static void send_le32(unsigned int v) {
+    for (int i = 0; i < 4; i++) {
+        uart_putc((char)v);
+        v >>= 8;
+    }
+}
+
+/* FNV-1a over 32-bit words */
+static unsigned int block_hash(const unsigned int *p, unsigned int words) {
+    unsigned int h = 2166136261u;
+    while (words--) {
+        h ^= *p++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/*
+ * Delta upload: send one hash per block of the current contents, then
+ * receive (index, block data) pairs until DELTA_END. The last block may
+ * be short. Returns 0 and the byte sum of the whole image, or -1 on a
+ * bad block index.
+ */
+static int recv_delta(unsigned char *dest, unsigned int size, unsigned int *sum) {
+    unsigned int nblocks = (size + DELTA_BLOCK - 1) / DELTA_BLOCK;
+
+    for (unsigned int i = 0; i < nblocks; i++) {
+        unsigned int len = size - i * DELTA_BLOCK;
+        if (len > DELTA_BLOCK)
+            len = DELTA_BLOCK;
+        send_le32(block_hash((const unsigned int *)(dest + i * DELTA_BLOCK), len / 4));
+    }
+
+    unsigned int idx;
+    while ((idx = recv_byte()) != DELTA_END) {
+        if (idx >= nblocks)
+            return -1;
+        unsigned char *p = dest + idx * DELTA_BLOCK;
+        unsigned int len = size - idx * DELTA_BLOCK;
+        if (len > DELTA_BLOCK)
+            len = DELTA_BLOCK;
+        while (len--)
+            *p++ = recv_byte();
+    }
+
+    /* Whole-image verify covers unchanged blocks too */
+    unsigned int s = 0;
+    for (unsigned int i = 0; i < size; i++)
+        s += dest[i];
+    *sum = s;
+    return 0;
+}
+
+/* CRC-32 (IEEE), four bits at a time from a 64-byte table */
+static const unsigned int crc_nibble[16] = {
+    0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+    0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+    0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+    0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+static unsigned int crc32(const unsigned char *p, unsigned int n) {
+    unsigned int c = 0xFFFFFFFF;
+    while (n--) {
+        c ^= *p++;
+        c = (c >> 4) ^ crc_nibble[c & 15];
+        c = (c >> 4) ^ crc_nibble[c & 15];
+    }
+    return ~c;
+}
+
+/* About 5 ms for a full 12 KB image */
+static int resident_valid(void) {
+    unsigned int size = APP_HDR->size;
+    return APP_HDR->magic == APP_MAGIC && size != 0 && size <= APP_MAX_SIZE &&
+           crc32((const unsigned char *)APP_BASE, size) == APP_HDR->crc;
+}
+
+static inline unsigned int read_cycle(void) {
+    unsigned int v;
+    asm volatile("csrr %0, mcycle" : "=r"(v));
+    return v;
+}
+
+/* Returns 1 if SYNC_REQ arrives within the given cycles */
+static int wait_sync(unsigned int cycles) {
+    unsigned int t0 = read_cycle();
+    while (read_cycle() - t0 < cycles)
+        if ((UART_STAT & UART_RX_READY) && recv_byte() == SYNC_REQ)
+            return 1;
+    return 0;
+}
+
+static void run_app(void) {
+    /* Wait for UART TX to finish */
+    while (!(UART_STAT & UART_STAT_TX_EMPTY))
+        ;
+
+    void (*app)(void) = (void (*)(void))APP_BASE;
+    app();
+}
+
 static void print_banner(void) {
     uart_puts("\r\n"
         "========================================\r\n"
-        "       Z-Core RISC-V Bootloader v1.0\r\n"
+        "       Z-Core RISC-V Bootloader v1.2\r\n"
         "========================================\r\n"
         " CPU\r\n"
-        "   ISA      : RV32IM + Zicsr\r\n"
+        "   ISA      : RV32IMA + Zicsr\r\n"
         "   Clock    : 50 MHz\r\n"
         "   Pipeline : 5-stage\r\n"
         " Memory\r\n"
@@ -35,9 +223,11 @@ static void print_banner(void) {
         "   App      : 0x1000-0x3FFF (12 KB)\r\n"
         " Peripherals\r\n"
         "   UART     : 0x04000000  115200 8N1\r\n"
+        "   Upload   : raw / LZ4 / delta\r\n"
+        "   Resume   : resident app after reset\r\n"
         "   GPIO     : 0x04001000\r\n"
         "   Timer    : 0x04002000\r\n"
-        "   VGA      : 0x04003000  160x120\r\n"
+        "   VGA      : 0x04003000  160x120/320x240\r\n"
         "========================================\r\n"
         "Waiting for upload...\r\n");
 }
@@ -45,17 +235,43 @@ static void print_banner(void) {
 void main(void) {
     uart_set_baud(BAUD_DIV_115200);
 
-    print_banner();
+    /* ---- Warm boot: rerun the resident app unless the host syncs ---- */
+    int synced = 0;
+    if (resident_valid()) {
+        synced = wait_sync(BOOT_WINDOW);
+        if (!synced) {
+            uart_puts("Z-Core: resident app\r\n");
+            run_app();
+        }
+    }
 
     /* ---- Sync handshake ---- */
-    while ((unsigned char)uart_getc_blocking() != SYNC_REQ)
-        ;
+    if (!synced) {
+        print_banner();
+        while ((unsigned char)uart_getc_blocking() != SYNC_REQ)
+            ;
+    }
     uart_putc((char)SYNC_ACK);
 
-    /* ---- Receive payload size (4 bytes, little-endian) ---- */
-    unsigned int size = recv_le32();
+    /* The image is about to change */
+    APP_HDR->magic = 0;
 
-    if (size == 0 || size > APP_MAX_SIZE) {
+    /* ---- Receive payload size (4 bytes, little-endian) ----
+     * upload.py repeats SYNC_REQ until it sees the ACK; skip any still
+     * in flight. upload.py pads every image to a multiple of 4 and any
+     * other size is rejected below, so a valid size word never starts
+     * with SYNC_REQ (0x5A). */
+    unsigned int size;
+    while ((size = recv_byte()) == SYNC_REQ)
+        ;
+    size |= (unsigned int)recv_byte() << 8;
+    size |= (unsigned int)recv_byte() << 16;
+    size |= (unsigned int)recv_byte() << 24;
+    unsigned int lz4 = size & SIZE_LZ4;
+    unsigned int delta = size & SIZE_DELTA;
+    size &= ~(SIZE_LZ4 | SIZE_DELTA);
+
+    if (size == 0 || size > APP_MAX_SIZE || (lz4 && delta) || (size & 3)) {
         uart_putc((char)NAK);
         uart_puts("ERR: bad size ");
         uart_putint((int)size);
@@ -65,21 +281,43 @@ void main(void) {
     }
 
     uart_putc((char)ACK);
-    uart_puts("RX ");
-    uart_putint((int)size);
-    uart_puts(" bytes\r\n");
 
     /* ---- Receive data ---- */
     unsigned char *dest = (unsigned char *)APP_BASE;
     unsigned int checksum = 0;
 
-    for (unsigned int i = 0; i < size; i++) {
-        unsigned char b = (unsigned char)uart_getc_blocking();
-        dest[i] = b;
-        checksum += b;
+    if (delta) {
+        /* Binary block hashes follow the ACK directly */
+        if (recv_delta(dest, size, &checksum)) {
+            uart_putc((char)NAK);
+            uart_puts("ERR: bad block\r\n");
+            while (1)
+                ;
+        }
+        /* Summing took a while: tell the host it may send the checksum */
+        uart_putc((char)ACK);
+    } else if (lz4) {
+        uart_puts("RX ");
+        uart_putint((int)size);
+        uart_puts(" bytes (LZ4)\r\n");
+        if (recv_lz4(dest, size, &checksum)) {
+            uart_putc((char)NAK);
+            uart_puts("ERR: bad LZ4 stream\r\n");
+            while (1)
+                ;
+        }
+    } else {
+        uart_puts("RX ");
+        uart_putint((int)size);
+        uart_puts(" bytes\r\n");
+        for (unsigned int i = 0; i < size; i++) {
+            unsigned char b = (unsigned char)uart_getc_blocking();
+            dest[i] = b;
+            checksum += b;
+        }
     }
 
-    /* ---- Verify checksum ---- */
+    /* ---- Verify checksum (over the decompressed image) ---- */
     unsigned int expected = recv_le32();
 
     if (checksum != expected) {
@@ -94,15 +332,15 @@ void main(void) {
     }
 
     uart_putc((char)ACK);
+
+    /* ---- Record the image for warm boots ---- */
+    APP_HDR->size = size;
+    APP_HDR->crc = crc32(dest, size);
+    APP_HDR->magic = APP_MAGIC;
+
     uart_puts("OK! Jumping to ");
     uart_puthex(APP_BASE);
     uart_puts("\r\n");
 
-    /* Wait for UART TX to finish */
-    while (!(UART_STAT & UART_STAT_TX_EMPTY))
-        ;
-
-    /* Jump to loaded application */
-    void (*app)(void) = (void (*)(void))APP_BASE;
-    app();
+    run_app();
 }
@@ -0,0 +1,100 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ================================================================
+// Bus Traffic Report - Z-Core
+// Runs a few workloads under the bus monitor and prints, per
+// slave, the transactions, busy/wait cycles and the latency
+// histogram: a CPU copy in RAM, a framebuffer fill by the core and
+// the same fill by the DMA engine. Build with APP=1.
+// ================================================================
+
+#include "libs/uart.h"
+#include "libs/fmt.h"
+#include "libs/string.h"
+#include "libs/vga.h"
+#include "libs/dma.h"
+#include "libs/busmon.h"
+
+#define N 2048
+
+static unsigned char src[N] __attribute__((aligned(4)));
+static unsigned char dst[N] __attribute__((aligned(4)));
+
+static const char *const port_names[] = {
+  "RAM  ", "UART ", "GPIO ", "Timer", "VGA  ", "DMA  ", "Harts"
+};
+
+static void report(const char *title) {
+  busmon_stop();
+  uart_printf("\r\n-- %s: %u cycles --\r\n", title, BUSMON_CYCLES);
+  uart_puts("port   dir    count     busy     wait   max | 1 2 3-4 5-8 9-16 17-32 33-64 >64\r\n");
+
+  for (unsigned int m = 0; m < busmon_ports() && m < 7; m++) {
+    for (unsigned int wr = 0; wr < 2; wr++) {
+      unsigned int n = busmon_read(m, BUSMON_RD_COUNT + wr);
+      if (n == 0)
+        continue;
+      uart_printf("%s  %s %8u %8u %8u %5u |", port_names[m], wr ? "W " : "R ", n,
+                  busmon_read(m, BUSMON_RD_BUSY + wr),
+                  busmon_read(m, BUSMON_RD_WAIT + wr),
+                  busmon_read(m, BUSMON_RD_MAX + wr));
+      for (unsigned int b = 0; b < BUSMON_BINS; b++)
+        uart_printf(" %u", busmon_read(m, (wr ? BUSMON_WR_HIST : BUSMON_RD_HIST) + b));
+      uart_puts("\r\n");
+    }
+  }
+}
+
+int main(void) {
+  uart_puts("\r\n=== Z-Core Bus Traffic ===\r\n");
+
+  if (busmon_ports() == 0) {
+    uart_puts("no bus monitor\r\n");
+    while (1);
+  }
+
+  for (int i = 0; i < N; i++)
+    src[i] = (unsigned char)(i * 13 + 1);
+
+  busmon_reset();
+  memcpy(dst, src, N);
+  report("memcpy 2 KB");
+
+  busmon_reset();
+  vga_fill(0x1C);
+  report("vga_fill (core)");
+
+  static const unsigned char color = 0xE0;
+  busmon_reset();
+  VGA_FB_ADDR = 0;
+  dma_start((unsigned int)&color, VGA_BASE + 0x04, VGA_WIDTH * VGA_HEIGHT,
+            DMA_BYTE | DMA_SRC_FIXED | DMA_DST_FIXED);
+  dma_wait();
+  report("framebuffer (DMA)");
+
+  uart_puts("\r\nDone.\r\n");
+  while (1);
+  return 0;
+}
@@ -0,0 +1,87 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ================================================================
+// Text Console Demo - Z-Core
+// Scrolling log on the VGA text layer over a color-bar background,
+// with a status line redrawn every frame. Reports the cost of a
+// character over UART. Build with APP=1.
+// ================================================================
+
+#include "libs/uart.h"
+#include "libs/fmt.h"
+#include "libs/vga.h"
+#include "libs/console.h"
+
+static inline unsigned int read_cycle(void) {
+  unsigned int v;
+  asm volatile("csrr %0, mcycle" : "=r"(v));
+  return v;
+}
+
+static void draw_bars(void) {
+  static const unsigned char bars[8] = {
+    VGA_WHITE, VGA_YELLOW, VGA_CYAN, VGA_GREEN,
+    VGA_MAGENTA, VGA_RED, VGA_BLUE, VGA_DARK_GRAY
+  };
+  for (int i = 0; i < 8; i++)
+    vga_fill_rect(i * (VGA_WIDTH / 8), 0, VGA_WIDTH / 8, VGA_HEIGHT, bars[i]);
+}
+
+int main(void) {
+  uart_puts("\r\n=== Z-Core Text Console ===\r\n");
+
+  vga_set_mode(VGA_MODE_RGB332);
+  draw_bars();
+
+  console_init(VGA_TXT_INK(TXT_WHITE));
+
+  // Cost of one 40-character line (wraps to the next line)
+  console_goto(0, 2);
+  unsigned int t0 = read_cycle();
+  console_puts("The quick brown fox jumps over the lazy.");
+  unsigned int t_line = read_cycle() - t0;
+  uart_printf("40 chars: %u cycles (%u per char)\r\n", t_line, t_line / 40);
+
+  console_set_attr(VGA_TXT_COLOR(TXT_YELLOW, TXT_BLUE));
+  console_printf("40 chars took %u cycles\n", t_line);
+  console_set_attr(VGA_TXT_INK(TXT_WHITE));
+
+  unsigned int frame = 0;
+  while (1) {
+    vga_wait_vsync();
+    frame++;
+
+    // Log line every 8 frames; the console scrolls once it is full
+    if ((frame & 7) == 0) {
+      console_set_attr(VGA_TXT_INK((frame >> 3) % 15 + 1));
+      console_printf("frame %5u  t=%08x\n", frame, read_cycle());
+    }
+
+    char hud[VGA_TXT_COLS + 1];
+    fmt_snprintf(hud, sizeof(hud), " Z-Core console   frame %6u        ", frame);
+    console_write_at(0, 0, VGA_TXT_COLOR(TXT_BLACK, TXT_LIGHT_GRAY), hud);
+  }
+  return 0;
+}
@@ -0,0 +1,165 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ================================================================
+// DMA Engine Test - Z-Core
+// Word and byte copies, a descriptor list, a bus error, the
+// completion interrupt, UART TX and a VGA fill through the
+// framebuffer data port. Build with APP=1.
+// ================================================================
+
+#include "libs/uart.h"
+#include "libs/string.h"
+#include "libs/vga.h"
+#include "libs/dma.h"
+
+#define GPIO_OUT (*((volatile unsigned int *)0x04001000))
+#define GPIO_DIR (*((volatile unsigned int *)0x04001008))
+
+#define N 1024
+
+static unsigned char src[N + 8] __attribute__((aligned(4)));
+static unsigned char dst[N + 8] __attribute__((aligned(4)));
+
+static unsigned char row[VGA_WIDTH];
+static dma_desc_t rows[VGA_HEIGHT];
+
+static volatile unsigned int irqs;
+
+int p = 0, f = 0;
+
+static inline unsigned int read_cycle(void) {
+  unsigned int v;
+  asm volatile("csrr %0, mcycle" : "=r"(v));
+  return v;
+}
+
+static void __attribute__((interrupt("machine"), aligned(4))) dma_isr(void) {
+  dma_ack();
+  irqs++;
+}
+
+static void __attribute__((noinline)) check(const char *name, int ok) {
+  uart_puts(name);
+  if (ok) { uart_puts(" OK\r\n"); p++; }
+  else { uart_puts(" FAIL\r\n"); f++; }
+}
+
+static void fill_src(void) {
+  for (int i = 0; i < N + 8; i++)
+    src[i] = (unsigned char)(i * 7 + 3);
+  memset(dst, 0, sizeof(dst));
+}
+
+int main(void) {
+  GPIO_DIR = 0xFF;
+  GPIO_OUT = 0x01;
+
+  uart_puts("\r\n=== Z-Core DMA Test ===\r\n\r\n");
+
+  // ---- Word copy, with the core counting while it runs ----
+  fill_src();
+  unsigned int t0 = read_cycle();
+  dma_memcpy(dst, src, N);
+  unsigned int spins = 0;
+  while (dma_busy())
+    spins++;
+  unsigned int t_dma = read_cycle() - t0;
+  check("word copy", dma_wait() == 0 && memcmp(dst, src, N) == 0 && dst[N] == 0);
+
+  t0 = read_cycle();
+  memcpy(dst, src, N);
+  unsigned int t_cpu = read_cycle() - t0;
+
+  uart_puts("  1 KB: DMA "); uart_putint((int)t_dma);
+  uart_puts(" cycles (core looped "); uart_putint((int)spins);
+  uart_puts(" times), memcpy "); uart_putint((int)t_cpu);
+  uart_puts(" cycles\r\n");
+
+  // ---- Unaligned byte copy ----
+  fill_src();
+  dma_memcpy(dst + 3, src + 1, 101);
+  check("byte copy", dma_wait() == 0 && memcmp(dst + 3, src + 1, 101) == 0 &&
+        dst[2] == 0 && dst[104] == 0);
+
+  // ---- Descriptor list: two halves in reverse order ----
+  fill_src();
+  static dma_desc_t d[2];
+  d[0] = (dma_desc_t){(unsigned int)(src + N / 2), (unsigned int)(dst + N / 2), N / 8, DMA_CHAIN, &d[1]};
+  d[1] = (dma_desc_t){(unsigned int)src, (unsigned int)dst, N / 8, 0, 0};
+  dma_start_chain(&d[0]);
+  check("chain", dma_wait() == 0 && memcmp(dst, src, N) == 0);
+
+  // ---- Unmapped source: DECERR from the interconnect ----
+  dma_start(0x08000000, (unsigned int)dst, 1, 0);
+  check("bus error", dma_wait() == -1);
+
+  // ---- Completion interrupt (meip, mcause 11) ----
+  asm volatile("csrw mtvec, %0" :: "r"(dma_isr));
+  asm volatile("csrs mie, %0" :: "r"(1 << 11));     // MEIE
+  asm volatile("csrs mstatus, %0" :: "r"(1 << 3));  // MIE
+  dma_irq_enable(1);
+  dma_memcpy(dst, src, 64);
+  while (dma_busy())
+    ;
+  for (volatile int i = 0; i < 16; i++)
+    ;
+  check("interrupt", irqs == 1 && !(DMA_STATUS & DMA_STAT_DONE));
+  dma_irq_enable(0);
+  asm volatile("csrc mie, %0" :: "r"(1 << 11));
+
+  // ---- UART TX paced by the transmitter ----
+  static const char msg[] = "  (sent by DMA)\r\n";
+  dma_uart_write(msg, sizeof(msg) - 1);
+  check("uart tx", dma_wait() == 0);
+
+  // ---- VGA: one row source, one descriptor per line ----
+  for (int x = 0; x < VGA_WIDTH; x++)
+    row[x] = (unsigned char)(x * 256 / VGA_WIDTH);
+  for (int y = 0; y < VGA_HEIGHT; y++) {
+    rows[y].src = (unsigned int)row;
+    rows[y].dst = VGA_BASE + 0x04;
+    rows[y].len = VGA_WIDTH;
+    rows[y].ctrl = DMA_BYTE | DMA_DST_FIXED | (y < VGA_HEIGHT - 1 ? DMA_CHAIN : 0);
+    rows[y].next = &rows[y + 1];
+  }
+  VGA_FB_ADDR = 0;
+  t0 = read_cycle();
+  dma_start_chain(&rows[0]);
+  int ok = dma_wait() == 0;
+  unsigned int t_vga = read_cycle() - t0;
+  check("vga fill", ok);
+  uart_puts("  frame: "); uart_putint((int)t_vga); uart_puts(" cycles\r\n");
+
+  uart_puts("\r\n=================\r\n");
+  uart_puts("PASS:"); uart_puthex((unsigned int)p);
+  uart_puts(" FAIL:"); uart_puthex((unsigned int)f);
+  uart_puts("\r\n");
+
+  GPIO_OUT = (f == 0) ? 0xAA : 0x55;
+  uart_puts(f == 0 ? "ALL PASSED\r\n" : "SOME FAILED\r\n");
+
+  while (1);
+  return 0;
+}
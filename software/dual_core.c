@@ -0,0 +1,186 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ================================================================
+// Dual-Core Test - Z-Core RV32A atomics and a second hart
+// Checks the AMOs and LR/SC, then splits a bouncing-ball demo:
+// hart 0 runs the game logic and pushes draw commands through a
+// lock-free queue, hart 1 renders them. With one hart (NUM_HARTS=1
+// or the ISS) hart 0 drains the queue itself after every frame.
+// Build with APP=1 and the SoC built with NUM_HARTS=2.
+// ================================================================
+
+#include "libs/uart.h"
+#include "libs/vga.h"
+#include "libs/smp.h"
+
+#define GPIO_OUT (*((volatile unsigned int *)0x04001000))
+#define GPIO_DIR (*((volatile unsigned int *)0x04001008))
+
+#define NBALLS   8
+#define FRAMES   600
+#define QSIZE    64
+
+// Draw command: x | y << 8 | color << 16; CMD_FRAME ends a frame
+#define CMD(x, y, c) ((unsigned int)(x) | ((unsigned int)(y) << 8) | ((unsigned int)(c) << 16))
+#define CMD_FRAME    0xFFFFFFFFu
+
+static unsigned int qbuf[QSIZE];
+static spsc_queue_t queue;
+
+static volatile unsigned int frames_drawn;
+static volatile unsigned int amo_count, lock_count, done;
+static spinlock_t lock;
+
+static struct { int x, y, dx, dy; unsigned char c; } balls[NBALLS];
+
+int p = 0, f = 0;
+
+void __attribute__((noinline)) check(const char *name, unsigned int r, unsigned int exp) {
+  uart_puts(name); uart_putc('=');
+  uart_puthex(r);
+  uart_puts(" exp:"); uart_puthex(exp);
+
+  if (r == exp) { uart_puts(" OK\r\n"); p++; }
+  else { uart_puts(" FAIL\r\n"); f++; }
+}
+
+static inline unsigned int read_cycle(void) {
+  unsigned int v;
+  asm volatile("csrr %0, mcycle" : "=r"(v));
+  return v;
+}
+
+// Consumer side: returns 1 after a CMD_FRAME, 0 when the queue ran dry
+static int render_drain(void) {
+  unsigned int cmd;
+  while (spsc_pop(&queue, &cmd)) {
+    if (cmd == CMD_FRAME) {
+      atomic_add(&frames_drawn, 1);
+      return 1;
+    }
+    vga_fill_rect(cmd & 0xFF, (cmd >> 8) & 0xFF, 2, 2, (unsigned char)(cmd >> 16));
+  }
+  return 0;
+}
+
+static void renderer(unsigned int hart) {
+  (void)hart;
+  while (1)
+    render_drain();
+}
+
+static void worker(unsigned int hart) {
+  for (int i = 0; i < 1000; i++) {
+    atomic_add(&amo_count, 1);
+    spin_lock(&lock);
+    lock_count++;
+    spin_unlock(&lock);
+  }
+  atomic_or(&done, 1u << hart);
+}
+
+static void push(unsigned int cmd, int solo) {
+  while (!spsc_push(&queue, cmd)) {
+    if (solo)
+      render_drain();
+  }
+}
+
+int main(void) {
+  GPIO_DIR = 0xFF;
+  GPIO_OUT = 0x01;
+
+  unsigned int harts = hart_count();
+  uart_puts("\r\n=== Z-Core Dual-Core Test ===\r\n");
+  uart_puts("harts: "); uart_putint((int)harts); uart_puts("  mhartid: ");
+  uart_putint((int)hart_id()); uart_puts("\r\n\r\n");
+
+  uart_puts("-- Atomics --\r\n");
+  volatile unsigned int w = 5;
+  check("amoadd",  atomic_add(&w, 3), 5);
+  check("amoswap", atomic_swap(&w, 0xF0), 8);
+  check("amoor",   atomic_or(&w, 0x0F), 0xF0);
+  check("amoand",  atomic_and(&w, 0x3C), 0xFF);
+  check("cas hit", atomic_cas(&w, 0x3C, 7), 0x3C);
+  check("cas miss", atomic_cas(&w, 0x3C, 9), 7);
+  check("value",   w, 7);
+
+  // Both harts hammer shared counters: no update may be lost
+  uart_puts("\r\n-- Shared counters --\r\n");
+  int dual = harts > 1;
+  if (dual)
+    hart_start(1, worker);
+  worker(0);
+  while (done != (dual ? 3u : 1u))
+    ;
+  check("amo",  amo_count,  dual ? 2000 : 1000);
+  check("lock", lock_count, dual ? 2000 : 1000);
+
+  // Game logic here, rendering on hart 1
+  uart_puts("\r\n-- Render split --\r\n");
+  spsc_init(&queue, qbuf, QSIZE);
+  vga_fill(VGA_BLACK);
+  for (int i = 0; i < NBALLS; i++) {
+    balls[i].x = 10 + 17 * i;
+    balls[i].y = 5 + 13 * i;
+    balls[i].dx = (i & 1) ? 1 : -1;
+    balls[i].dy = (i & 2) ? 1 : -1;
+    balls[i].c = (unsigned char)(0x25 + 0x1B * i) | 0x03;
+  }
+  frames_drawn = 0;
+  if (dual)
+    hart_start(1, renderer);
+
+  unsigned int t0 = read_cycle();
+  for (int n = 0; n < FRAMES; n++) {
+    for (int i = 0; i < NBALLS; i++) {
+      push(CMD(balls[i].x, balls[i].y, VGA_BLACK), !dual);
+      balls[i].x += balls[i].dx;
+      balls[i].y += balls[i].dy;
+      if (balls[i].x <= 0 || balls[i].x >= VGA_WIDTH - 2)
+        balls[i].dx = -balls[i].dx;
+      if (balls[i].y <= 0 || balls[i].y >= VGA_HEIGHT - 2)
+        balls[i].dy = -balls[i].dy;
+      push(CMD(balls[i].x, balls[i].y, balls[i].c), !dual);
+    }
+    push(CMD_FRAME, !dual);
+    if (!dual)
+      render_drain();
+    GPIO_OUT = n >> 4;
+  }
+  while (frames_drawn != FRAMES)
+    ;
+  unsigned int cycles = read_cycle() - t0;
+  if (dual)
+    hart_stop(1);
+
+  check("frames", frames_drawn, FRAMES);
+  uart_puts("cycles/frame: "); uart_putint((int)(cycles / FRAMES)); uart_puts("\r\n");
+
+  uart_puts("\r\nPassed: "); uart_putint(p);
+  uart_puts("  Failed: "); uart_putint(f); uart_puts("\r\n");
+  GPIO_OUT = f ? 0xAA : 0xFF;
+  return 0;
+}
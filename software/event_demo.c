@@ -0,0 +1,142 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ================================================================
+// Event-Driven Runtime Demo - Z-Core
+// LEDs, switches, UART input and a VGA animation driven by the tick
+// scheduler and the vblank interrupt instead of busy-wait loops. The
+// core sleeps in WFI in between; the load is reported once a second
+// from the WFI sleep counter. Build with APP=1.
+// ================================================================
+
+#include "libs/uart.h"
+#include "libs/fmt.h"
+#include "libs/vga.h"
+#include "libs/sched.h"
+
+#define GPIO_DATA (*((volatile unsigned int *)0x04001000))
+#define GPIO_DIR  (*((volatile unsigned int *)0x04001008))
+
+#define UART_RX_VALID 0x4
+
+#define TICK_HZ   1000
+#define EV_VBLANK EV_USER(0)
+
+#define BOX  8
+
+static unsigned int leds;
+
+static inline unsigned int read_cycle(void) {
+  unsigned int v;
+  asm volatile("csrr %0, mcycle" : "=r"(v));
+  return v;
+}
+
+static void show_leds(void) {
+  GPIO_DATA = leds & 0xFF;
+}
+
+static void blink(void *arg) {
+  (void)arg;
+  leds ^= 0x01;
+  show_leds();
+}
+
+// Switches 1..7 mirror to LEDs 1..7
+static void poll_switches(void *arg) {
+  (void)arg;
+  unsigned int sw = (GPIO_DATA >> 8) & 0xFE;
+  if (sw != (leds & 0xFE)) {
+    leds = (leds & 0x01) | sw;
+    show_leds();
+  }
+}
+
+// The UART has no interrupt: check for input from a task instead of
+// spinning on it
+static void poll_uart(void *arg) {
+  (void)arg;
+  if (UART_STAT & UART_RX_VALID) {
+    char c = uart_getc();
+    uart_printf("key '%c'\r\n", c >= ' ' && c < 127 ? c : '?');
+  }
+}
+
+static unsigned int last_cycle, last_sleep;
+
+static void report_load(void *arg) {
+  (void)arg;
+  unsigned int cyc = read_cycle();
+  unsigned int slp = sched_sleep_cycles();
+  unsigned int elapsed = cyc - last_cycle;
+  unsigned int busy = elapsed - (slp - last_sleep);
+  // 32-bit division: the link has no libgcc for __udivdi3
+  uart_printf("load %u%%  ticks %u\r\n", busy / (elapsed / 100), sched_ticks());
+  last_cycle = cyc;
+  last_sleep = slp;
+}
+
+// Runs in the trap handler: acknowledge and hand the frame to main.
+// meip is shared with the DMA engine; only vblank is enabled here.
+static void on_external(void) {
+  unsigned int st = VGA_IRQ_STATUS;
+  VGA_IRQ_STATUS = st;
+  if (st & VGA_IRQ_VBLANK)
+    event_post(EV_VBLANK);
+}
+
+int main(void) {
+  uart_puts("\r\n=== Z-Core Event Runtime Demo ===\r\n");
+
+  GPIO_DIR = 0xFF;
+  vga_set_mode(VGA_MODE_RGB332);
+  vga_fill(VGA_BLACK);
+
+  sched_init(TICK_HZ);
+  sched_every(TICK_HZ / 4, blink, 0);
+  sched_every(TICK_HZ / 50, poll_switches, 0);
+  sched_every(TICK_HZ / 100, poll_uart, 0);
+  sched_every(TICK_HZ, report_load, 0);
+  last_cycle = read_cycle();
+  last_sleep = sched_sleep_cycles();
+
+  sched_on_external(on_external);
+  VGA_IRQ_STATUS = VGA_IRQ_VBLANK;
+  VGA_IRQ_EN = VGA_IRQ_VBLANK;
+
+  // Bounce a box, one step per frame
+  int x = 0, y = 0, dx = 1, dy = 1;
+  while (1) {
+    wait_for_event(EV_VBLANK);
+    vga_fill_rect(x, y, BOX, BOX, VGA_BLACK);
+    if (x + dx < 0 || x + dx > VGA_WIDTH - BOX)
+      dx = -dx;
+    if (y + dy < 0 || y + dy > VGA_HEIGHT - BOX)
+      dy = -dy;
+    x += dx;
+    y += dy;
+    vga_fill_rect(x, y, BOX, BOX, VGA_YELLOW);
+  }
+  return 0;
+}
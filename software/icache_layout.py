@@ -0,0 +1,243 @@
+#!/usr/bin/env python3
+"""
+Z-Core I-Cache Layout Tool
+
+Reorders functions so the hot ones do not collide in the direct-mapped
+instruction cache (CACHE_DEPTH words, one word per line, index =
+PC[9:2] for the default 256 entries). Reads a PC profile and the ELF it
+was captured on, and writes a linker script that lists the hot
+.text.<function> sections first, in an order chosen to minimize
+conflicts. Requires objects built with -ffunction-sections
+(make LAYOUT=1).
+
+Usage:
+    ./icache_layout.py <program.elf> <profile> --base linker_app.ld -o out.ld
+
+The profile is either a .ztr commit trace from the Verilator harness
+(sim/), which also allows an exact miss simulation of the new layout,
+or a PC histogram: one "<hex pc> <count>" pair per line, '#' comments.
+
+The ELF must be the one the profile was captured on: run the tool
+before relinking with the generated script.
+"""
+
+import os
+import sys
+import bisect
+import argparse
+from collections import defaultdict
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from trace_report import read_symbols, read_trace  # noqa: E402
+
+# Padding candidates tried in front of each hot function
+MAX_PAD_CANDIDATES = 16
+
+
+def read_histogram(path):
+    counts = defaultdict(int)
+    with open(path) as f:
+        for line in f:
+            line = line.split('#', 1)[0].split()
+            if len(line) >= 2:
+                counts[int(line[0], 16) & ~3] += int(line[1])
+    return counts, None
+
+
+def read_profile(path):
+    """Return (pc -> count, pc sequence or None)."""
+    with open(path, 'rb') as f:
+        magic = f.read(4)
+    if magic != b'ZTRC':
+        return read_histogram(path)
+
+    counts = defaultdict(int)
+    seq = []
+    for _, pc, _, _, _ in read_trace(path):
+        counts[pc] += 1
+        seq.append(pc)
+    return counts, seq
+
+
+class Func:
+    def __init__(self, addr, size, name):
+        self.addr = addr
+        self.size = size
+        self.name = name
+        self.words = [0] * (size // 4)
+        self.weight = 0
+
+
+def load_functions(elf, counts):
+    funcs = []
+    seen = set()
+    for addr, size, name in read_symbols(elf):
+        # Aliases share an address; keep the first name
+        if size == 0 or addr in seen:
+            continue
+        seen.add(addr)
+        funcs.append(Func(addr, (size + 3) & ~3, name))
+
+    funcs.sort(key=lambda f: f.addr)
+    for f in funcs:
+        for i in range(len(f.words)):
+            c = counts.get(f.addr + 4 * i, 0)
+            f.words[i] = c
+            f.weight += c
+    return funcs
+
+
+def conflict_cost(occ, f, addr, depth):
+    """Estimated conflict misses of placing f at addr: words sharing an
+    index with already-placed code miss at most min(count) times each."""
+    base = addr >> 2
+    cost = 0
+    for i, w in enumerate(f.words):
+        if w:
+            o = occ[(base + i) % depth]
+            cost += w if w < o else o
+    return cost
+
+
+def place(funcs, start, depth):
+    """Greedy placement: hot functions by weight, each at the cursor or
+    behind one cold function used as padding, whichever conflicts least."""
+    hot = sorted((f for f in funcs if f.weight), key=lambda f: -f.weight)
+    cold = [f for f in funcs if not f.weight]
+    occ = [0] * depth
+    order = []
+    cursor = start
+
+    for f in hot:
+        best = (conflict_cost(occ, f, cursor, depth), 0, None)
+        if best[0]:
+            tried = set()
+            for c in cold:
+                if c.size in tried or c.size >= depth * 4:
+                    continue
+                tried.add(c.size)
+                cost = conflict_cost(occ, f, cursor + c.size, depth)
+                if cost < best[0]:
+                    best = (cost, c.size, c)
+                if len(tried) >= MAX_PAD_CANDIDATES:
+                    break
+
+        if best[2] is not None:
+            order.append(best[2])
+            cold.remove(best[2])
+            cursor += best[2].size
+
+        base = cursor >> 2
+        for i, w in enumerate(f.words):
+            occ[(base + i) % depth] += w
+        order.append(f)
+        cursor += f.size
+
+    # Cold functions keep their original relative order after the hot ones
+    return order + cold
+
+
+def layout_cost(funcs, addr_of, depth):
+    """Sum over cache indexes of (total weight - heaviest word)."""
+    per_index = defaultdict(list)
+    for f in funcs:
+        base = addr_of[f] >> 2
+        for i, w in enumerate(f.words):
+            if w:
+                per_index[(base + i) % depth].append(w)
+    return sum(sum(ws) - max(ws) for ws in per_index.values())
+
+
+def simulate(seq, remap, depth):
+    """Exact miss count of a direct-mapped, one-word-per-line cache."""
+    tags = [None] * depth
+    misses = 0
+    for pc in seq:
+        pc = remap(pc)
+        idx = (pc >> 2) % depth
+        tag = pc >> 2
+        if tags[idx] != tag:
+            tags[idx] = tag
+            misses += 1
+    return misses
+
+
+def write_script(base_path, out_path, order):
+    with open(base_path) as f:
+        lines = f.readlines()
+
+    out = []
+    inserted = False
+    for line in lines:
+        out.append(line)
+        if not inserted and '*(.text.start)' in line:
+            indent = line[:len(line) - len(line.lstrip())]
+            out.append(f"{indent}/* icache_layout.py: hot functions first */\n")
+            for f in order:
+                # GCC may add a prefix (.text.startup.main, .text.unlikely.*)
+                out.append(f"{indent}*(.text.{f.name} .text.*.{f.name})\n")
+            inserted = True
+
+    if not inserted:
+        raise ValueError(f"{base_path}: no *(.text.start) line to anchor the layout")
+
+    with open(out_path, 'w') as f:
+        f.writelines(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Z-Core I-cache conflict layout tool")
+    parser.add_argument("elf", help="ELF the profile was captured on")
+    parser.add_argument("profile", help=".ztr trace or PC histogram")
+    parser.add_argument("--base", required=True, help="linker script to extend")
+    parser.add_argument("-o", "--output", required=True, help="linker script to write")
+    parser.add_argument("--depth", type=int, default=256, help="I-cache CACHE_DEPTH in words")
+    args = parser.parse_args()
+
+    counts, seq = read_profile(args.profile)
+    funcs = load_functions(args.elf, counts)
+    if not funcs:
+        print("No function symbols found", file=sys.stderr)
+        return 1
+
+    total = sum(counts.values())
+    hot = [f for f in funcs if f.weight]
+    start = funcs[0].addr
+    # Code before the first function (start.S) stays where it is
+    order = place(funcs, start, args.depth)
+
+    old_addr = {f: f.addr for f in funcs}
+    new_addr = {}
+    cursor = start
+    for f in order:
+        new_addr[f] = cursor
+        cursor += f.size
+
+    print(f"Profile: {total} samples, {len(hot)} of {len(funcs)} functions hot, "
+          f"{sum(f.size for f in hot)} hot bytes ({args.depth * 4} B cache)")
+    print(f"Estimated conflict weight: {layout_cost(funcs, old_addr, args.depth)} -> "
+          f"{layout_cost(funcs, new_addr, args.depth)}")
+
+    if seq is not None:
+        addrs = [f.addr for f in funcs]
+        shift = {f.addr: new_addr[f] - f.addr for f in funcs}
+        ends = {f.addr: f.addr + f.size for f in funcs}
+
+        def remap(pc):
+            i = bisect.bisect_right(addrs, pc) - 1
+            if i >= 0 and pc < ends[addrs[i]]:
+                return pc + shift[addrs[i]]
+            return pc
+
+        before = simulate(seq, lambda pc: pc, args.depth)
+        after = simulate(seq, remap, args.depth)
+        print(f"Simulated I-cache misses: {before} -> {after} "
+              f"({len(seq)} fetches)")
+
+    write_script(args.base, args.output, order)
+    print(f"Wrote {args.output} ({len(order)} sections ordered)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
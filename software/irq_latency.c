@@ -0,0 +1,114 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ================================================================
+// Interrupt Latency Demo - Z-Core
+// Timer interrupt entry with a conventional handler, which spills
+// the caller-saved registers before calling into C, and with the
+// shadow register bank, which calls straight in. Each case takes one
+// interrupt alone and then a burst of back-to-back ones, which
+// tail-chain from one MRET into the next handler. Build with APP=1.
+// ================================================================
+
+#include "libs/uart.h"
+#include "libs/fmt.h"
+#include "libs/irq.h"
+#include "libs/timer.h"
+
+#define BURST 16
+
+static volatile unsigned int left;
+static volatile unsigned int first, last;
+
+// The handler proper; both vectors end up here. The timer stays
+// pending until the last interrupt of a burst parks the compare.
+void on_tick(void) {
+  unsigned int now = TIMER_LO;
+  if (!first)
+    first = now;
+  last = now;
+  if (--left == 0)
+    timer_disarm();
+}
+
+// Conventional entry: the call forces GCC to save every
+// caller-saved register first
+static void __attribute__((interrupt("machine"), aligned(4))) tick_isr(void) {
+  on_tick();
+}
+
+// Shadow-bank entry: call on_tick; mret
+IRQ_VECTOR(tick_vec, on_tick);
+
+// Arm the compare a little ahead and wait for n interrupts.
+// Returns the cycles from the compare match to the first handler.
+static unsigned int run(unsigned int n, unsigned int *per_irq) {
+  left = n;
+  first = last = 0;
+
+  timer_disarm();
+  unsigned int cmp = TIMER_LO + 200;
+  TIMECMP_LO = cmp;
+  TIMECMP_HI = TIMER_HI;
+
+  while (left)
+    ;
+  *per_irq = n > 1 ? (last - first) / (n - 1) : 0;
+  return first - cmp;
+}
+
+static void measure(const char *name) {
+  unsigned int per, lat;
+  lat = run(1, &per);
+  uart_printf("%s entry %u cycles", name, lat);
+  run(BURST, &per);
+  uart_printf(", back-to-back %u cycles/irq\r\n", per);
+}
+
+int main(void) {
+  uart_puts("\r\n=== Z-Core Interrupt Latency ===\r\n");
+
+  TIMER_CTRL = 0;
+  TIMER_LO = 0;
+  TIMER_HI = 0;
+  timer_disarm();
+  TIMER_CTRL = TIMER_EN | TIMER_UP | TIMER_IE;
+  asm volatile("csrs mie, %0" :: "r"(1 << 7));      // MTIE
+  asm volatile("csrs mstatus, %0" :: "r"(1 << 3));  // MIE
+
+  irq_set_vector(tick_isr);
+  measure("spill  ");
+
+  if (irq_shadow_enable()) {
+    irq_set_vector(tick_vec);
+    measure("shadow ");
+    irq_shadow_disable();
+  } else {
+    uart_puts("shadow  not built (SHADOW_REGS = 0)\r\n");
+  }
+
+  asm volatile("csrc mstatus, %0" :: "r"(1 << 3));
+  uart_puts("Done.\r\n");
+  return 0;
+}
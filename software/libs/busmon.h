@@ -0,0 +1,95 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef BUSMON_H
+#define BUSMON_H
+
+// ================================================================
+// Bus Performance Monitor Driver for Z-Core
+//
+// axil_bus_mon taps the interconnect ports of RAM, UART, GPIO,
+// Timer, VGA, DMA and hart control. Per port it counts reads and
+// writes, busy cycles (request until response), wait cycles
+// (request not yet accepted by the slave), the worst latency and
+// a histogram of latencies in eight power-of-two bins.
+//
+// Instruction fetches that miss the I-cache show up as RAM reads.
+// Reads of the monitor itself are not counted.
+// ================================================================
+
+#define BUSMON_BASE    0x04006000
+#define BUSMON_CTRL    (*((volatile unsigned int *)(BUSMON_BASE + 0x000)))
+#define BUSMON_INFO    (*((volatile unsigned int *)(BUSMON_BASE + 0x004)))
+#define BUSMON_CYCLES  (*((volatile unsigned int *)(BUSMON_BASE + 0x008)))
+
+// CTRL bits
+#define BUSMON_ENABLE  0x1
+#define BUSMON_CLEAR   0x2   // write 1: zero every counter
+
+// Ports (interconnect master index)
+#define BUSMON_RAM     0
+#define BUSMON_UART    1
+#define BUSMON_GPIO    2
+#define BUSMON_TIMER   3
+#define BUSMON_VGA     4
+#define BUSMON_DMA     5
+#define BUSMON_HARTS   6
+
+// Counters within a port's block (word offsets)
+#define BUSMON_RD_COUNT  0
+#define BUSMON_WR_COUNT  1
+#define BUSMON_RD_BUSY   2
+#define BUSMON_WR_BUSY   3
+#define BUSMON_RD_WAIT   4
+#define BUSMON_WR_WAIT   5
+#define BUSMON_RD_MAX    6
+#define BUSMON_WR_MAX    7
+#define BUSMON_RD_HIST   8   // 8 bins: 1, 2, 3-4, 5-8, 9-16, 17-32, 33-64, >64
+#define BUSMON_WR_HIST   16
+
+#define BUSMON_BINS      8
+
+static inline unsigned int busmon_ports(void) {
+  return BUSMON_INFO & 0xFF;
+}
+
+static inline unsigned int busmon_read(unsigned int port, unsigned int counter) {
+  return *((volatile unsigned int *)(BUSMON_BASE + 0x80 * (port + 1) + 4 * counter));
+}
+
+// Zero the counters and start counting
+static inline void busmon_reset(void) {
+  BUSMON_CTRL = BUSMON_ENABLE | BUSMON_CLEAR;
+}
+
+// Freeze / resume the counters (the values stay readable)
+static inline void busmon_stop(void) {
+  BUSMON_CTRL = 0;
+}
+
+static inline void busmon_start(void) {
+  BUSMON_CTRL = BUSMON_ENABLE;
+}
+
+#endif // BUSMON_H
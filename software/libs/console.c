@@ -0,0 +1,145 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "console.h"
+#include "fmt.h"
+
+static int cur_col, cur_row;    // Screen cell of the cursor
+static int origin;              // Text RAM row on the top line
+static unsigned int cur_attr;
+
+// Screen cell -> text RAM index
+static unsigned int cell_index(int col, int row) {
+  int r = row + origin;
+  if (r >= VGA_TXT_ROWS)
+    r -= VGA_TXT_ROWS;
+  return (unsigned int)(r * VGA_TXT_COLS + col);
+}
+
+static void clear_line(int row) {
+  unsigned int blank = (cur_attr << 8) | ' ';
+  VGA_TXT_POS = cell_index(0, row);
+  for (int i = 0; i < VGA_TXT_COLS; i++)
+    VGA_TXT_CELL = blank;
+}
+
+static void sync_cursor(void) {
+  VGA_TXT_POS = cell_index(cur_col, cur_row);
+}
+
+static void newline(void) {
+  cur_col = 0;
+  if (cur_row < VGA_TXT_ROWS - 1) {
+    cur_row++;
+  } else {
+    // The old top line becomes the new bottom line
+    origin = origin < VGA_TXT_ROWS - 1 ? origin + 1 : 0;
+    VGA_TXT_ORIGIN = (unsigned int)origin;
+    clear_line(cur_row);
+  }
+  sync_cursor();
+}
+
+void console_init(unsigned int attr) {
+  cur_attr = attr;
+  VGA_TXT_ATTR = attr;
+  console_clear();
+  console_show(1, 1);
+}
+
+void console_clear(void) {
+  origin = 0;
+  VGA_TXT_ORIGIN = 0;
+  unsigned int blank = (cur_attr << 8) | ' ';
+  VGA_TXT_POS = 0;
+  for (int i = 0; i < VGA_TXT_COLS * VGA_TXT_ROWS; i++)
+    VGA_TXT_CELL = blank;
+  cur_col = cur_row = 0;
+  sync_cursor();
+}
+
+void console_set_attr(unsigned int attr) {
+  cur_attr = attr;
+  VGA_TXT_ATTR = attr;
+}
+
+void console_goto(int col, int row) {
+  if (col < 0 || col >= VGA_TXT_COLS || row < 0 || row >= VGA_TXT_ROWS)
+    return;
+  cur_col = col;
+  cur_row = row;
+  sync_cursor();
+}
+
+void console_putc(char c) {
+  switch (c) {
+  case '\n':
+    newline();
+    break;
+  case '\r':
+    cur_col = 0;
+    sync_cursor();
+    break;
+  case '\b':
+    if (cur_col > 0) {
+      cur_col--;
+      sync_cursor();
+    }
+    break;
+  case '\t':
+    do
+      console_putc(' ');
+    while (cur_col & 3);
+    break;
+  default:
+    // TXT_POS is already at the cursor and advances by itself
+    VGA_TXT_PUTC = (unsigned char)c;
+    if (++cur_col == VGA_TXT_COLS)
+      newline();
+    break;
+  }
+}
+
+void console_puts(const char *s) {
+  while (*s)
+    console_putc(*s++);
+}
+
+void console_printf(const char *fmt, ...) {
+  char buf[2 * VGA_TXT_COLS + 1];
+  va_list ap;
+  va_start(ap, fmt);
+  fmt_vsnprintf(buf, sizeof(buf), fmt, ap);
+  va_end(ap);
+  console_puts(buf);
+}
+
+void console_write_at(int col, int row, unsigned int attr, const char *s) {
+  if (col < 0 || row < 0 || row >= VGA_TXT_ROWS)
+    return;
+  VGA_TXT_POS = cell_index(col, row);
+  while (*s && col++ < VGA_TXT_COLS)
+    VGA_TXT_CELL = (attr << 8) | (unsigned char)*s++;
+  sync_cursor();
+}
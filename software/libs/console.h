@@ -0,0 +1,84 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include "vga.h"
+
+// ================================================================
+// VGA Text Console for Z-Core
+//
+// Prints to the axil_vga text layer: 40x30 characters drawn by the
+// hardware over the framebuffer, so a character costs one bus write
+// (VGA_TXT_PUTC) instead of redrawing glyph pixels. Scrolling moves
+// the layer's origin row and clears one line (40 writes).
+//
+// The layer scrolls as a whole: text placed with console_write_at
+// moves up with the console. Programs that mix a HUD with a
+// scrolling log should redraw the HUD after printing.
+// ================================================================
+
+// Text colors (VGA_TXT_COLOR / VGA_TXT_INK)
+#define TXT_BLACK         0
+#define TXT_BLUE          1
+#define TXT_GREEN         2
+#define TXT_CYAN          3
+#define TXT_RED           4
+#define TXT_MAGENTA       5
+#define TXT_BROWN         6
+#define TXT_LIGHT_GRAY    7
+#define TXT_DARK_GRAY     8
+#define TXT_LIGHT_BLUE    9
+#define TXT_LIGHT_GREEN   10
+#define TXT_LIGHT_CYAN    11
+#define TXT_LIGHT_RED     12
+#define TXT_LIGHT_MAGENTA 13
+#define TXT_YELLOW        14
+#define TXT_WHITE         15
+
+// Clear the screen with attr, home the cursor and turn the layer on
+void console_init(unsigned int attr);
+
+void console_clear(void);
+void console_set_attr(unsigned int attr);
+
+// Move the cursor to a screen cell (0..39, 0..29)
+void console_goto(int col, int row);
+
+// Handles '\n', '\r', '\b' and '\t'; wraps and scrolls
+void console_putc(char c);
+void console_puts(const char *s);
+
+// fmt.h formatting, up to one 80-character line per call
+void console_printf(const char *fmt, ...);
+
+// Write s at a screen cell without moving the cursor (HUDs)
+void console_write_at(int col, int row, unsigned int attr, const char *s);
+
+static inline void console_show(int on, int cursor) {
+  VGA_TXT_CTRL = (on ? VGA_TXT_ON : 0) | (cursor ? VGA_TXT_CURSOR | VGA_TXT_BLINK : 0);
+}
+
+#endif // CONSOLE_H
@@ -0,0 +1,82 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "dma.h"
+#include "vga.h"
+#include "uart.h"
+
+static unsigned int irq_flag;
+
+void dma_irq_enable(int on) {
+  irq_flag = on ? DMA_IE : 0;
+}
+
+void dma_start(unsigned int src, unsigned int dst, unsigned int len, unsigned int ctrl) {
+  DMA_SRC = src;
+  DMA_DST = dst;
+  DMA_LEN = len;
+  DMA_CTRL = ctrl | irq_flag | DMA_START;
+}
+
+void dma_start_chain(const dma_desc_t *first) {
+  // An empty transfer that chains straight into the list
+  DMA_NEXT = (unsigned int)first;
+  dma_start(0, 0, 0, DMA_CHAIN);
+}
+
+void dma_memcpy(void *dst, const void *src, unsigned int n) {
+  unsigned int s = (unsigned int)src, d = (unsigned int)dst;
+
+  if (((s | d | n) & 3) == 0)
+    dma_start(s, d, n >> 2, 0);
+  else
+    dma_start(s, d, n, DMA_BYTE);
+}
+
+void dma_to_vga(unsigned int offset, const unsigned char *src, unsigned int n) {
+  VGA_FB_ADDR = offset;
+  dma_start((unsigned int)src, VGA_BASE + 0x04, n, DMA_BYTE | DMA_DST_FIXED);
+}
+
+void dma_uart_write(const void *src, unsigned int n) {
+  dma_start((unsigned int)src, UART_BASE + 0x00, n,
+            DMA_BYTE | DMA_DST_FIXED | DMA_REQ_UART_TX);
+}
+
+void dma_uart_read(void *dst, unsigned int n) {
+  dma_start(UART_BASE + 0x04, (unsigned int)dst, n,
+            DMA_BYTE | DMA_SRC_FIXED | DMA_REQ_UART_RX);
+}
+
+unsigned int dma_ack(void) {
+  unsigned int s = DMA_STATUS;
+  DMA_STATUS = DMA_STAT_DONE | DMA_STAT_ERR;
+  return s;
+}
+
+int dma_wait(void) {
+  while (dma_busy())
+    ;
+  return (dma_ack() & DMA_STAT_ERR) ? -1 : 0;
+}
@@ -0,0 +1,111 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef DMA_H
+#define DMA_H
+
+// ================================================================
+// DMA Engine Driver for Z-Core
+//
+// axil_dma moves data over the AXI-Lite interconnect as a second
+// bus master while the core keeps executing. Each element is one
+// bus read and one bus write; SRC and DST either increment or stay
+// fixed (peripheral data registers). Peripheral transfers can be
+// paced by the UART request lines.
+//
+// Descriptor lists: with DMA_CHAIN set, the engine loads the next
+// descriptor from NEXT when LEN reaches zero. The list ends at the
+// first descriptor without DMA_CHAIN; that one's DMA_IE decides
+// whether completion raises the interrupt (meip, mcause 11).
+//
+// Do not touch VGA_FB_ADDR while a transfer into VGA_FB_DATA runs.
+// ================================================================
+
+#define DMA_BASE       0x04004000
+#define DMA_SRC        (*((volatile unsigned int *)(DMA_BASE + 0x00)))
+#define DMA_DST        (*((volatile unsigned int *)(DMA_BASE + 0x04)))
+#define DMA_LEN        (*((volatile unsigned int *)(DMA_BASE + 0x08)))
+#define DMA_CTRL       (*((volatile unsigned int *)(DMA_BASE + 0x0C)))
+#define DMA_NEXT       (*((volatile unsigned int *)(DMA_BASE + 0x10)))
+#define DMA_STATUS     (*((volatile unsigned int *)(DMA_BASE + 0x14)))
+
+// CTRL bits
+#define DMA_START       0x01
+#define DMA_IE          0x02
+#define DMA_SRC_FIXED   0x04
+#define DMA_DST_FIXED   0x08
+#define DMA_BYTE        0x10   // byte elements (default: words)
+#define DMA_REQ_UART_RX (1 << 5)
+#define DMA_REQ_UART_TX (2 << 5)
+#define DMA_CHAIN       0x80
+
+// STATUS bits (DONE and ERR are write-1-to-clear)
+#define DMA_STAT_BUSY  0x1
+#define DMA_STAT_DONE  0x2
+#define DMA_STAT_ERR   0x4
+
+// In-memory descriptor (word aligned); ctrl takes the CTRL bits
+typedef struct dma_desc {
+  unsigned int src;
+  unsigned int dst;
+  unsigned int len;             // elements
+  unsigned int ctrl;
+  const struct dma_desc *next;  // used when ctrl has DMA_CHAIN
+} dma_desc_t;
+
+// Add DMA_IE to every transfer started through this driver
+void dma_irq_enable(int on);
+
+// Start a single transfer of len elements; returns immediately
+void dma_start(unsigned int src, unsigned int dst, unsigned int len, unsigned int ctrl);
+
+// Start a descriptor list
+void dma_start_chain(const dma_desc_t *first);
+
+// Copy n bytes in RAM (word elements when src, dst and n allow)
+void dma_memcpy(void *dst, const void *src, unsigned int n);
+
+// Stream n pixels into the framebuffer starting at pixel offset
+void dma_to_vga(unsigned int offset, const unsigned char *src, unsigned int n);
+
+// Send / receive n bytes over the UART, paced by TX empty / RX valid
+void dma_uart_write(const void *src, unsigned int n);
+void dma_uart_read(void *dst, unsigned int n);
+
+static inline int dma_busy(void) {
+  return DMA_STATUS & DMA_STAT_BUSY;
+}
+
+// Stop after the current element
+static inline void dma_abort(void) {
+  DMA_CTRL = 0;
+}
+
+// Clear DONE and ERR (drops the interrupt); returns the old STATUS
+unsigned int dma_ack(void);
+
+// Spin until idle; returns 0, or -1 if a bus access failed
+int dma_wait(void);
+
+#endif // DMA_H
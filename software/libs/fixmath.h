@@ -0,0 +1,59 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef FIXMATH_H
+#define FIXMATH_H
+
+#include <stdint.h>
+
+// ================================================================
+// Q16.16 fixed-point math for Z-Core (no FPU)
+//
+// Angles are in 1/1024 turn units (0..1023 = 0..360 degrees) so the
+// quadrant is two bits of the angle and wrap-around is a mask.
+// Trig uses a 256-entry quarter-wave table (512 bytes).
+// ================================================================
+
+typedef int32_t fix16_t;
+
+#define FIX16_ONE        0x00010000
+#define FIX16_HALF       0x00008000
+#define FIX16_ANGLE_TURN 1024
+
+#define FIX16_FROM_INT(x) ((fix16_t)((uint32_t)(x) << 16))
+#define FIX16_TO_INT(x)   ((int32_t)(x) >> 16)
+
+static inline fix16_t fix16_mul(fix16_t a, fix16_t b) {
+  return (fix16_t)(((int64_t)a * b) >> 16);
+}
+
+// sin/cos of an angle in 1/1024 turn units, result in [-1.0, 1.0]
+fix16_t fix16_sin(uint32_t angle);
+fix16_t fix16_cos(uint32_t angle);
+
+// floor(sqrt(x)) of an integer, and sqrt of a non-negative Q16.16
+uint32_t isqrt32(uint32_t x);
+fix16_t  fix16_sqrt(fix16_t x);
+
+#endif // FIXMATH_H
@@ -0,0 +1,185 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "fmt.h"
+#include "uart.h"
+
+int fmt_u32(char *buf, uint32_t val) {
+  char tmp[10];
+  int n = 0;
+
+  do {
+    uint32_t q = fmt_div10(val);
+    tmp[n++] = '0' + (char)(val - q * 10);
+    val = q;
+  } while (val);
+
+  for (int i = 0; i < n; i++)
+    buf[i] = tmp[n - 1 - i];
+  return n;
+}
+
+int fmt_i32(char *buf, int32_t val) {
+  if (val < 0) {
+    // Negate as unsigned so INT32_MIN formats correctly
+    buf[0] = '-';
+    return 1 + fmt_u32(buf + 1, 0u - (uint32_t)val);
+  }
+  return fmt_u32(buf, (uint32_t)val);
+}
+
+int fmt_hex(char *buf, uint32_t val, int digits) {
+  static const char hex[] = "0123456789ABCDEF";
+
+  if (digits <= 0) {
+    // Minimum digits needed (at least one)
+    digits = 1;
+    while (digits < 8 && (val >> (digits * 4)))
+      digits++;
+  }
+  for (int i = digits - 1; i >= 0; i--) {
+    buf[i] = hex[val & 0xF];
+    val >>= 4;
+  }
+  return digits;
+}
+
+// ----------------------------------------------------------------
+// printf core: emits through a callback so the same parser serves
+// both the buffer and the UART variants
+// ----------------------------------------------------------------
+typedef void (*emit_fn)(void *ctx, char c);
+
+static int fmt_core(emit_fn emit, void *ctx, const char *fmt, va_list ap) {
+  int total = 0;
+
+  for (; *fmt; fmt++) {
+    if (*fmt != '%') {
+      emit(ctx, *fmt);
+      total++;
+      continue;
+    }
+
+    char pad = ' ';
+    int width = 0;
+    fmt++;
+    if (*fmt == '0') {
+      pad = '0';
+      fmt++;
+    }
+    while (*fmt >= '0' && *fmt <= '9')
+      width = width * 10 + (*fmt++ - '0');
+
+    char num[12];
+    const char *s = num;
+    int len;
+
+    switch (*fmt) {
+    case 'd':
+      len = fmt_i32(num, va_arg(ap, int32_t));
+      break;
+    case 'u':
+      len = fmt_u32(num, va_arg(ap, uint32_t));
+      break;
+    case 'x':
+    case 'X':
+      len = fmt_hex(num, va_arg(ap, uint32_t), 0);
+      if (*fmt == 'x')
+        for (int i = 0; i < len; i++)
+          if (num[i] >= 'A')
+            num[i] += 'a' - 'A';
+      break;
+    case 'c':
+      num[0] = (char)va_arg(ap, int);
+      len = 1;
+      break;
+    case 's':
+      s = va_arg(ap, const char *);
+      for (len = 0; s[len]; len++)
+        ;
+      pad = ' ';
+      break;
+    case '\0':
+      return total;
+    default:
+      // '%%' and unknown conversions print the character itself
+      num[0] = *fmt;
+      len = 1;
+      break;
+    }
+
+    // Zero padding goes after the sign
+    if (pad == '0' && *s == '-' && len < width) {
+      emit(ctx, *s++);
+      len--;
+      width--;
+      total++;
+    }
+    for (; width > len; width--, total++)
+      emit(ctx, pad);
+    for (int i = 0; i < len; i++, total++)
+      emit(ctx, s[i]);
+  }
+  return total;
+}
+
+struct buf_ctx {
+  char *buf;
+  int size;
+  int pos;
+};
+
+static void emit_buf(void *ctx, char c) {
+  struct buf_ctx *b = ctx;
+  if (b->pos < b->size - 1)
+    b->buf[b->pos++] = c;
+}
+
+static void emit_uart(void *ctx, char c) {
+  (void)ctx;
+  uart_putc(c);
+}
+
+int fmt_vsnprintf(char *buf, int size, const char *fmt, va_list ap) {
+  struct buf_ctx b = {buf, size, 0};
+  int n = fmt_core(emit_buf, &b, fmt, ap);
+  if (size > 0)
+    buf[b.pos] = '\0';
+  return n;
+}
+
+int fmt_snprintf(char *buf, int size, const char *fmt, ...) {
+  va_list ap;
+  va_start(ap, fmt);
+  int n = fmt_vsnprintf(buf, size, fmt, ap);
+  va_end(ap);
+  return n;
+}
+
+void uart_printf(const char *fmt, ...) {
+  va_list ap;
+  va_start(ap, fmt);
+  fmt_core(emit_uart, 0, fmt, ap);
+  va_end(ap);
+}
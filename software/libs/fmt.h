@@ -0,0 +1,59 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef FMT_H
+#define FMT_H
+
+#include <stdarg.h>
+#include <stdint.h>
+
+// ================================================================
+// Integer formatting without the divider
+//
+// Decimal conversion divides by 10 with a reciprocal multiply
+// (one MULHU + shift) instead of DIVU/REMU, which stall the
+// pipeline for 32+ cycles per digit on Z-Core.
+// ================================================================
+
+// x / 10, exact for every 32-bit x
+static inline uint32_t fmt_div10(uint32_t x) {
+  return (uint32_t)(((uint64_t)x * 0xCCCCCCCDu) >> 35);
+}
+
+// Format into buf (no terminator added); return the character count.
+// buf must hold at least 11 characters for fmt_i32, 10 for fmt_u32.
+int fmt_u32(char *buf, uint32_t val);
+int fmt_i32(char *buf, int32_t val);
+int fmt_hex(char *buf, uint32_t val, int digits);
+
+// Minimal printf: %d %u %x %X %c %s %%, with optional '0' flag and
+// width (e.g. %08x, %5d). Output is always NUL-terminated; returns
+// the length that would have been written without truncation.
+int fmt_vsnprintf(char *buf, int size, const char *fmt, va_list ap);
+int fmt_snprintf(char *buf, int size, const char *fmt, ...);
+
+// Same formatting, straight to the UART
+void uart_printf(const char *fmt, ...);
+
+#endif // FMT_H
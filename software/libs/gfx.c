@@ -0,0 +1,313 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "gfx.h"
+
+typedef struct {
+  short x0, y0, x1, y1;   // x1/y1 exclusive
+} rect_t;
+
+static gfx_sprite_t *sprites[GFX_MAX_SPRITES];
+static int n_sprites;
+
+static rect_t dirty[GFX_MAX_DIRTY];
+static int n_dirty;
+
+static rect_t clip = {0, 0, VGA_WIDTH, VGA_HEIGHT};
+static unsigned char bg_color;
+static gfx_bg_fn bg_fn;
+static int mode;
+
+static gfx_stats_t stats;
+static unsigned int last_present;
+
+static unsigned char line[VGA_WIDTH];
+
+static inline unsigned int read_cycle(void) {
+  unsigned int v;
+  asm volatile("csrr %0, mcycle" : "=r"(v));
+  return v;
+}
+
+// ----------------------------------------------------------------
+// Dirty list
+// ----------------------------------------------------------------
+
+static inline int overlaps(const rect_t *a, const rect_t *b) {
+  // Touching rectangles count too: merging them saves an FB_ADDR per row
+  return a->x0 <= b->x1 && b->x0 <= a->x1 && a->y0 <= b->y1 && b->y0 <= a->y1;
+}
+
+static inline void merge(rect_t *a, const rect_t *b) {
+  if (b->x0 < a->x0) a->x0 = b->x0;
+  if (b->y0 < a->y0) a->y0 = b->y0;
+  if (b->x1 > a->x1) a->x1 = b->x1;
+  if (b->y1 > a->y1) a->y1 = b->y1;
+}
+
+static void add_dirty(int x, int y, int w, int h) {
+  rect_t r = {(short)x, (short)y, (short)(x + w), (short)(y + h)};
+
+  if (r.x0 < clip.x0) r.x0 = clip.x0;
+  if (r.y0 < clip.y0) r.y0 = clip.y0;
+  if (r.x1 > clip.x1) r.x1 = clip.x1;
+  if (r.y1 > clip.y1) r.y1 = clip.y1;
+  if (r.x0 >= r.x1 || r.y0 >= r.y1)
+    return;
+
+  // Absorb every rectangle the new one touches; the union may now
+  // touch others, so rescan until nothing merges
+  int merged;
+  do {
+    merged = 0;
+    for (int i = 0; i < n_dirty; i++) {
+      if (overlaps(&r, &dirty[i])) {
+        merge(&r, &dirty[i]);
+        dirty[i] = dirty[--n_dirty];
+        merged = 1;
+        break;
+      }
+    }
+  } while (merged);
+
+  if (n_dirty == GFX_MAX_DIRTY) {
+    // List full: fold into the last entry
+    merge(&dirty[n_dirty - 1], &r);
+    return;
+  }
+  dirty[n_dirty++] = r;
+}
+
+// ----------------------------------------------------------------
+// Row composition
+// ----------------------------------------------------------------
+
+static void fill_bg(int y, int x, int w, unsigned char *dst) {
+  if (bg_fn) {
+    bg_fn(y, x, w, dst);
+    return;
+  }
+  for (int i = 0; i < w; i++)
+    dst[i] = bg_color;
+}
+
+// Overlay the part of img in row y, columns [x0, x1) onto dst[0..]
+static void blit_row(const gfx_image_t *img, int sx, int sy, unsigned char color,
+                     int y, int x0, int x1, unsigned char *dst) {
+  int r = y - sy;
+  if ((unsigned)r >= img->h)
+    return;
+  int c0 = (x0 > sx) ? x0 - sx : 0;
+  int c1 = (x1 < sx + img->w) ? x1 - sx : img->w;
+  unsigned char *d = dst + (sx + c0 - x0);
+
+  if (img->format == GFX_MONO) {
+    unsigned int bits = (unsigned int)img->data[r] << c0;
+    unsigned int msb = 1u << (img->w - 1);
+    for (int c = c0; c < c1; c++, d++, bits <<= 1)
+      if (bits & msb)
+        *d = color;
+  } else {
+    const unsigned char *s = img->data + r * img->w;
+    for (int c = c0; c < c1; c++, d++)
+      if (s[c])
+        *d = s[c];
+  }
+}
+
+static unsigned int draw_rect(const rect_t *r) {
+  int w = r->x1 - r->x0;
+
+  for (int y = r->y0; y < r->y1; y++) {
+    fill_bg(y, r->x0, w, line);
+    for (int i = 0; i < n_sprites; i++) {
+      gfx_sprite_t *s = sprites[i];
+      if (s->visible && s->x < r->x1 && s->x + s->img->w > r->x0)
+        blit_row(s->img, s->x, s->y, s->color, y, r->x0, r->x1, line);
+    }
+
+    VGA_FB_ADDR = (unsigned int)(y * VGA_WIDTH + r->x0);
+    for (int i = 0; i < w; i++)
+      VGA_FB_DATA = line[i];
+  }
+  return (unsigned int)(w * (r->y1 - r->y0));
+}
+
+// ----------------------------------------------------------------
+// Public API
+// ----------------------------------------------------------------
+
+void gfx_init(unsigned char bg) {
+  bg_color = bg;
+  bg_fn = 0;
+  n_sprites = 0;
+  n_dirty = 0;
+  add_dirty(clip.x0, clip.y0, clip.x1 - clip.x0, clip.y1 - clip.y0);
+  gfx_present();
+}
+
+void gfx_set_background(unsigned char bg, gfx_bg_fn fn) {
+  bg_color = bg;
+  bg_fn = fn;
+  gfx_invalidate(clip.x0, clip.y0, clip.x1 - clip.x0, clip.y1 - clip.y0);
+}
+
+void gfx_set_clip(int x, int y, int w, int h) {
+  clip.x0 = (short)(x < 0 ? 0 : x);
+  clip.y0 = (short)(y < 0 ? 0 : y);
+  clip.x1 = (short)(x + w > VGA_WIDTH ? VGA_WIDTH : x + w);
+  clip.y1 = (short)(y + h > VGA_HEIGHT ? VGA_HEIGHT : y + h);
+}
+
+void gfx_set_mode(int m) {
+  mode = m;
+}
+
+int gfx_add(gfx_sprite_t *s) {
+  if (n_sprites == GFX_MAX_SPRITES)
+    return -1;
+  // Nothing on screen yet: the first present only draws the new rect
+  s->p_img = s->img;
+  s->px = s->x;
+  s->py = s->y;
+  s->pcolor = s->color;
+  s->pvisible = 0;
+  sprites[n_sprites++] = s;
+  return 0;
+}
+
+void gfx_remove(gfx_sprite_t *s) {
+  for (int i = 0; i < n_sprites; i++) {
+    if (sprites[i] == s) {
+      if (s->pvisible)
+        add_dirty(s->px, s->py, s->p_img->w, s->p_img->h);
+      for (; i < n_sprites - 1; i++)
+        sprites[i] = sprites[i + 1];
+      n_sprites--;
+      return;
+    }
+  }
+}
+
+void gfx_invalidate(int x, int y, int w, int h) {
+  add_dirty(x, y, w, h);
+}
+
+unsigned int gfx_present(void) {
+  unsigned int t0 = read_cycle();
+  unsigned int pixels = 0;
+
+  if (mode == GFX_MODE_FULL) {
+    n_dirty = 0;
+    add_dirty(clip.x0, clip.y0, clip.x1 - clip.x0, clip.y1 - clip.y0);
+  }
+
+  // A changed sprite dirties both where it was and where it is
+  for (int i = 0; i < n_sprites; i++) {
+    gfx_sprite_t *s = sprites[i];
+    if (s->x == s->px && s->y == s->py && s->img == s->p_img &&
+        s->color == s->pcolor && s->visible == s->pvisible)
+      continue;
+    if (s->pvisible)
+      add_dirty(s->px, s->py, s->p_img->w, s->p_img->h);
+    if (s->visible)
+      add_dirty(s->x, s->y, s->img->w, s->img->h);
+    s->p_img = s->img;
+    s->px = s->x;
+    s->py = s->y;
+    s->pcolor = s->color;
+    s->pvisible = s->visible;
+  }
+
+  for (int i = 0; i < n_dirty; i++)
+    pixels += draw_rect(&dirty[i]);
+
+  stats.rects = (unsigned int)n_dirty;
+  stats.pixels = pixels;
+  n_dirty = 0;
+
+  unsigned int t1 = read_cycle();
+  stats.render_cycles = t1 - t0;
+  stats.frame_cycles = t1 - last_present;
+  last_present = t1;
+  return pixels;
+}
+
+const gfx_stats_t *gfx_stats(void) {
+  return &stats;
+}
+
+// ----------------------------------------------------------------
+// Immediate mode
+// ----------------------------------------------------------------
+
+void gfx_draw(const gfx_image_t *img, int x, int y, unsigned char color) {
+  for (int r = 0; r < img->h; r++) {
+    int yy = y + r;
+    if (yy < clip.y0 || yy >= clip.y1)
+      continue;
+
+    // Walk the row; each opaque run costs one FB_ADDR write
+    int run = 0;
+    for (int c = 0; c < img->w; c++) {
+      int xx = x + c;
+      unsigned char px;
+      int opaque;
+
+      if (img->format == GFX_MONO) {
+        opaque = (img->data[r] >> (img->w - 1 - c)) & 1;
+        px = color;
+      } else {
+        px = img->data[r * img->w + c];
+        opaque = px != 0;
+      }
+
+      if (!opaque || xx < clip.x0 || xx >= clip.x1) {
+        run = 0;
+        continue;
+      }
+      if (!run) {
+        VGA_FB_ADDR = (unsigned int)(yy * VGA_WIDTH + xx);
+        run = 1;
+      }
+      VGA_FB_DATA = px;
+    }
+  }
+}
+
+void gfx_erase(const gfx_image_t *img, int x, int y) {
+  int x0 = (x < clip.x0) ? clip.x0 : x;
+  int x1 = (x + img->w > clip.x1) ? clip.x1 : x + img->w;
+  if (x0 >= x1)
+    return;
+
+  for (int yy = y; yy < y + img->h; yy++) {
+    if (yy < clip.y0 || yy >= clip.y1)
+      continue;
+    fill_bg(yy, x0, x1 - x0, line);
+    VGA_FB_ADDR = (unsigned int)(yy * VGA_WIDTH + x0);
+    for (int i = 0; i < x1 - x0; i++)
+      VGA_FB_DATA = line[i];
+  }
+}
@@ -0,0 +1,113 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef GFX_H
+#define GFX_H
+
+#include "vga.h"
+
+// ================================================================
+// Dirty-Rectangle Sprite Renderer for Z-Core
+//
+// Sprites are retained objects: the program moves them by editing
+// their fields, and gfx_present() redraws only the rectangles that
+// changed since the last frame. Each dirty row is composed in RAM
+// (background, then sprites in z-order) and streamed with a single
+// FB_ADDR write followed by auto-incrementing FB_DATA writes, so
+// every pixel is written exactly once and nothing flickers.
+//
+// The framebuffer is write-only, so the background must be
+// reproducible: a solid color, optionally overridden per row by a
+// callback (e.g. a star field).
+// ================================================================
+
+#define GFX_MAX_SPRITES 32
+#define GFX_MAX_DIRTY   16
+
+// Image formats
+#define GFX_MONO   0   // one byte per row, MSB-first, w <= 8, ink = sprite color
+#define GFX_RGB332 1   // w*h pixels, color 0 is transparent
+
+typedef struct {
+  unsigned char w, h;
+  unsigned char format;
+  const unsigned char *data;
+} gfx_image_t;
+
+typedef struct {
+  // Public: edit freely between frames
+  const gfx_image_t *img;
+  short x, y;
+  unsigned char color;
+  unsigned char visible;
+
+  // Private: state as of the last gfx_present()
+  const gfx_image_t *p_img;
+  short px, py;
+  unsigned char pcolor;
+  unsigned char pvisible;
+} gfx_sprite_t;
+
+// Fills line[0..w-1] with the background of row y, columns x..x+w-1
+typedef void (*gfx_bg_fn)(int y, int x, int w, unsigned char *line);
+
+// Presentation modes
+#define GFX_MODE_DIRTY 0   // redraw changed rectangles only
+#define GFX_MODE_FULL  1   // redraw the whole clip area every frame
+
+typedef struct {
+  unsigned int frame_cycles;    // mcycle between the last two presents
+  unsigned int render_cycles;   // mcycle spent inside the last present
+  unsigned int pixels;          // pixels written by the last present
+  unsigned int rects;           // dirty rectangles drawn
+} gfx_stats_t;
+
+// Clears the clip area to bg and forgets all sprites
+void gfx_init(unsigned char bg);
+
+void gfx_set_background(unsigned char bg, gfx_bg_fn fn);
+void gfx_set_clip(int x, int y, int w, int h);
+void gfx_set_mode(int mode);
+
+// Sprites are drawn in the order they were added (later on top)
+int  gfx_add(gfx_sprite_t *s);
+void gfx_remove(gfx_sprite_t *s);
+
+// Mark a region for redraw (e.g. after changing the background)
+void gfx_invalidate(int x, int y, int w, int h);
+
+// Redraw everything that changed; returns the number of pixels written
+unsigned int gfx_present(void);
+
+const gfx_stats_t *gfx_stats(void);
+
+// ---- Immediate-mode primitives (outside the dirty tracking) ----
+
+// Draw img at (x, y), writing only its opaque pixels in runs
+void gfx_draw(const gfx_image_t *img, int x, int y, unsigned char color);
+
+// Restore the background under img's bounding box
+void gfx_erase(const gfx_image_t *img, int x, int y);
+
+#endif // GFX_H
@@ -0,0 +1,115 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef ICACHE_H
+#define ICACHE_H
+
+// ================================================================
+// I-Cache Control for Z-Core
+//
+// The instruction cache is direct-mapped: ICACHE_LINES one-word
+// lines indexed by PC[9:2]. Two custom CSRs control it:
+//
+//   mzicaddr (0x7C1)  preload start address
+//   mzicctl  (0x7C2)  write: command, read: {words left, BUSY}
+//
+// A preload reads words into the cache while the program keeps
+// running from cache hits; a miss waits until it is done. Locked
+// lines are never evicted: code that maps onto a locked line from
+// elsewhere runs uncached (one bus read per fetch), so keep what
+// you lock small.
+//
+// Mark interrupt handlers and hot loops with ICACHE_PIN and call
+// icache_pin_all() at boot. Only the marked functions are pinned,
+// not the library code they call.
+// ================================================================
+
+#define ICACHE_LINES    256
+
+// mzicctl command bits
+#define ICACHE_PRELOAD  0x1   // Load COUNT words from mzicaddr
+#define ICACHE_LOCK     0x2   // ... and lock them
+#define ICACHE_INVAL    0x4   // Invalidate every unlocked line
+#define ICACHE_UNLOCK   0x8   // Clear every lock (before INVAL)
+#define ICACHE_COUNT(n) ((unsigned int)(n) << 16)
+
+// mzicctl read
+#define ICACHE_BUSY     0x1
+
+#define ICACHE_PIN __attribute__((section(".text.pinned"), noinline, aligned(4)))
+
+extern char __pinned_start[], __pinned_end[];
+
+static inline unsigned int icache_status(void) {
+  unsigned int v;
+  asm volatile("csrr %0, 0x7C2" : "=r"(v));
+  return v;
+}
+
+static inline void icache_cmd(unsigned int cmd) {
+  asm volatile("csrw 0x7C2, %0" :: "r"(cmd) : "memory");
+}
+
+static inline void icache_wait(void) {
+  while (icache_status() & ICACHE_BUSY)
+    ;
+}
+
+// Load [start, end) into the cache, locking it if lock is set.
+// Returns at once; the words arrive while the caller runs on.
+static inline void icache_preload(const void *start, const void *end, int lock) {
+  unsigned int a = (unsigned int)start & ~3u;
+  if ((unsigned int)end <= a)
+    return;
+  unsigned int words = ((unsigned int)end - a + 3) >> 2;
+  if (words > ICACHE_LINES)
+    words = ICACHE_LINES;           // More would only evict itself
+  icache_wait();
+  asm volatile("csrw 0x7C1, %0" :: "r"(a));
+  icache_cmd(ICACHE_COUNT(words) | ICACHE_PRELOAD | (lock ? ICACHE_LOCK : 0));
+}
+
+// Preload and lock every ICACHE_PIN function
+static inline void icache_pin_all(void) {
+  icache_preload(__pinned_start, __pinned_end, 1);
+}
+
+// Drop unlocked lines (and the loop buffer); pinned code stays
+static inline void icache_invalidate(void) {
+  icache_wait();
+  icache_cmd(ICACHE_INVAL);
+}
+
+static inline void icache_unlock_all(void) {
+  icache_wait();
+  icache_cmd(ICACHE_UNLOCK);
+}
+
+// Empty the cache entirely, e.g. after writing new code to RAM
+static inline void icache_flush(void) {
+  icache_wait();
+  icache_cmd(ICACHE_UNLOCK | ICACHE_INVAL);
+}
+
+#endif // ICACHE_H
@@ -0,0 +1,92 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef IRQ_H
+#define IRQ_H
+
+// ================================================================
+// Fast Interrupt Entry for Z-Core
+//
+// With mzcfg.SHADOW set, taking an interrupt switches ra, t0-t6 and
+// a0-a7 to a second register bank, and MRET switches back. A handler
+// can then be a plain C function: everything it may clobber without
+// saving is banked, and whatever else it uses (s0-s11, on the shared
+// sp) the compiler saves anyway.
+//
+//   IRQ_VECTOR(timer_vec, on_timer);
+//   ...
+//   if (irq_shadow_enable())
+//     irq_set_vector(timer_vec);
+//
+// The vector is "call handler; mret", so the handler must not be
+// static. It goes in .text.pinned: icache_pin_all() keeps it (and any
+// ICACHE_PIN handler) in the I-cache.
+//
+// Handlers entered this way must not set mstatus.MIE: the bank to
+// restore is kept for one level only, like MPIE. Exceptions (ecall,
+// misalignment) stay on the current bank.
+//
+// An MRET that would be interrupted straight away is chained into
+// the next handler without returning first (no mepc refetch). This
+// needs no setup.
+// ================================================================
+
+// mzcfg (0x7C0)
+#define MZCFG_MISALIGN_TRAP 0x1
+#define MZCFG_SHADOW        0x2   // Interrupts use the shadow bank
+#define MZCFG_BANK          0x4   // Bank in use (read-only)
+#define MZCFG_PBANK         0x8   // Bank MRET returns to (read-only)
+
+#define IRQ_VECTOR(name, handler)                               \
+  void name(void);                                              \
+  asm(".pushsection .text.pinned,\"ax\",@progbits\n"            \
+      ".align 2\n"                                              \
+      ".global " #name "\n"                                     \
+      #name ":\n"                                               \
+      "  call " #handler "\n"                                   \
+      "  mret\n"                                                \
+      ".popsection")
+
+static inline unsigned int mzcfg_read(void) {
+  unsigned int v;
+  asm volatile("csrr %0, 0x7C0" : "=r"(v));
+  return v;
+}
+
+// Returns 0 if the core was built without SHADOW_REGS; handlers
+// then need __attribute__((interrupt("machine"))) instead
+static inline int irq_shadow_enable(void) {
+  asm volatile("csrs 0x7C0, %0" :: "r"(MZCFG_SHADOW));
+  return (mzcfg_read() & MZCFG_SHADOW) != 0;
+}
+
+static inline void irq_shadow_disable(void) {
+  asm volatile("csrc 0x7C0, %0" :: "r"(MZCFG_SHADOW));
+}
+
+static inline void irq_set_vector(void (*vec)(void)) {
+  asm volatile("csrw mtvec, %0" :: "r"(vec));
+}
+
+#endif // IRQ_H
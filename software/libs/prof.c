@@ -0,0 +1,138 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "prof.h"
+#include "uart.h"
+#include "timer.h"
+
+// Cycles to shift out one 8N1 byte
+#define BYTE_CYCLES (PROF_CPU_HZ / PROF_UART_BAUD * 10)
+
+static unsigned short ring[PROF_BUF_SIZE];
+static volatile unsigned int head, tail;
+static volatile unsigned int dropped, dropped_total;
+
+// Frame being transmitted
+static unsigned char frame[3 + 2 * PROF_FRAME_MAX + 1];
+static unsigned int frame_len, frame_pos;
+
+static unsigned long long period;
+static unsigned long long next_sample;
+
+// Pack the next frame from the ring buffer
+static inline void frame_build(void) {
+  unsigned int n = head - tail;
+  if (n > PROF_FRAME_MAX)
+    n = PROF_FRAME_MAX;
+
+  unsigned int d = dropped > 255 ? 255 : dropped;
+  dropped -= d;
+
+  unsigned char sum = (unsigned char)(n + d);
+  frame[0] = PROF_FRAME_SYNC;
+  frame[1] = (unsigned char)n;
+  frame[2] = (unsigned char)d;
+  unsigned int p = 3;
+  for (unsigned int i = 0; i < n; i++) {
+    unsigned short s = ring[tail++ & (PROF_BUF_SIZE - 1)];
+    frame[p++] = (unsigned char)s;
+    frame[p++] = (unsigned char)(s >> 8);
+    sum += (unsigned char)s + (unsigned char)(s >> 8);
+  }
+  frame[p++] = sum;
+  frame_len = p;
+  frame_pos = 0;
+}
+
+// Send one byte if the transmitter is idle; returns non-zero while
+// anything is left to send
+static inline int tx_step(void) {
+  if (frame_pos == frame_len) {
+    if (head == tail && !dropped)
+      return 0;
+    frame_build();
+  }
+  if (UART_STAT & 0x01)
+    UART_TX = frame[frame_pos++];
+  return 1;
+}
+
+static void __attribute__((interrupt("machine"), aligned(4))) prof_isr(void) {
+  unsigned long long now = timer_read();
+
+  if (now >= next_sample) {
+    unsigned int pc;
+    asm volatile("csrr %0, mepc" : "=r"(pc));
+    if (head - tail < PROF_BUF_SIZE)
+      ring[head++ & (PROF_BUF_SIZE - 1)] = (unsigned short)(pc >> 2);
+    else {
+      dropped++;
+      dropped_total++;
+    }
+    next_sample += period;
+    // Fell behind (interrupts were masked): skip the missed ticks
+    if (next_sample <= now)
+      next_sample = now + period;
+  }
+
+  // While bytes are pending, also wake up once per byte time
+  unsigned long long cmp = next_sample;
+  if (tx_step() && now + BYTE_CYCLES < cmp)
+    cmp = now + BYTE_CYCLES;
+  timer_set_cmp(cmp);
+}
+
+void prof_start(unsigned int sample_hz) {
+  head = tail = 0;
+  dropped = dropped_total = 0;
+  frame_len = frame_pos = 0;
+  period = PROF_CPU_HZ / sample_hz;
+
+  asm volatile("csrw mtvec, %0" :: "r"(prof_isr));
+
+  TIMER_CTRL = 0;
+  TIMER_LO = 0;
+  TIMER_HI = 0;
+  next_sample = period;
+  timer_set_cmp(next_sample);
+  TIMER_CTRL = TIMER_EN | TIMER_UP | TIMER_IE;
+
+  asm volatile("csrs mie, %0" :: "r"(1 << 7));      // MTIE
+  asm volatile("csrs mstatus, %0" :: "r"(1 << 3));  // MIE
+}
+
+void prof_stop(void) {
+  TIMER_CTRL = TIMER_EN | TIMER_UP;
+  asm volatile("csrc mie, %0" :: "r"(1 << 7));
+
+  while (tx_step())
+    ;
+  // Let the last byte leave the shift register
+  while (!(UART_STAT & 0x01))
+    ;
+}
+
+unsigned int prof_dropped(void) {
+  return dropped_total;
+}
@@ -0,0 +1,64 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef PROF_H
+#define PROF_H
+
+// ================================================================
+// Timer-Interrupt PC Sampling Profiler for Z-Core
+//
+// axil_timer compare interrupts sample mepc into a RAM ring buffer.
+// The same interrupt streams the samples over UART in binary frames,
+// one byte per interrupt whenever the transmitter is idle, so the
+// program never blocks on the UART:
+//
+//   0xFE | n | dropped | n x u16 (PC >> 2, little-endian) | checksum
+//
+// checksum = (n + dropped + sample bytes) & 0xFF. Text output is
+// 7-bit ASCII, so the host can separate frames from program output.
+// Decode with prof_report.py or upload.py --profile.
+//
+// The profiler owns mtvec and the timer while running. Avoid UART
+// text output while profiling: uart_putc does not check that the
+// transmitter is idle before writing.
+// ================================================================
+
+#define PROF_CPU_HZ     50000000u
+#define PROF_UART_BAUD  115200u
+#define PROF_DEFAULT_HZ 1000u
+
+#define PROF_BUF_SIZE   256   // samples (power of two)
+#define PROF_FRAME_MAX  32    // samples per frame
+#define PROF_FRAME_SYNC 0xFE
+
+// Start sampling at sample_hz (max. about 5 kHz at 115200 baud)
+void prof_start(unsigned int sample_hz);
+
+// Stop sampling and send every buffered sample (blocking)
+void prof_stop(void);
+
+// Samples lost because the ring buffer was full
+unsigned int prof_dropped(void);
+
+#endif // PROF_H
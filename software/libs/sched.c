@@ -0,0 +1,242 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "sched.h"
+#include "irq.h"
+#include "timer.h"
+
+#define MCAUSE_MTI  0x80000007u
+#define MCAUSE_MEI  0x8000000Bu
+
+typedef struct {
+  sched_fn_t   fn;              // 0: free slot
+  void        *arg;
+  unsigned int period;          // 0: one-shot
+  unsigned int due;             // Tick to run at
+} task_t;
+
+static task_t tasks[SCHED_MAX_TASKS];
+
+// Deferred calls: handlers advance head, the main program tail
+static struct {
+  sched_fn_t fn;
+  void      *arg;
+} defq[SCHED_DEFER_SIZE];
+static volatile unsigned int def_head, def_tail;
+
+static volatile unsigned int pending;
+static volatile unsigned int ticks;
+static unsigned long long period_cycles;
+static unsigned long long next_tick;
+static void (*ext_handler)(void);
+
+static inline void irq_off(void) {
+  asm volatile("csrci mstatus, 8" ::: "memory");
+}
+
+static inline void irq_on(void) {
+  asm volatile("csrsi mstatus, 8" ::: "memory");
+}
+
+// Disable interrupts; returns whether they were on
+static inline unsigned int irq_save(void) {
+  unsigned int m;
+  asm volatile("csrrci %0, mstatus, 8" : "=r"(m) :: "memory");
+  return m & 8;
+}
+
+static inline void irq_restore(unsigned int m) {
+  if (m)
+    irq_on();
+}
+
+// Trap handler. Plain C: entered through sched_vec with the shadow
+// bank, or through the spilling sched_isr without it.
+void sched_trap(void) {
+  unsigned int cause;
+  asm volatile("csrr %0, mcause" : "=r"(cause));
+
+  if (cause == MCAUSE_MTI) {
+    // Count the ticks missed while interrupts were off too
+    unsigned long long now = timer_read();
+    do {
+      next_tick += period_cycles;
+      ticks++;
+    } while (next_tick <= now);
+    timer_set_cmp(next_tick);
+    pending |= EV_TICK;
+  } else if (cause == MCAUSE_MEI) {
+    if (ext_handler)
+      ext_handler();
+  } else {
+    // Exceptions are not handled: stop here for the debugger
+    while (1)
+      ;
+  }
+}
+
+IRQ_VECTOR(sched_vec, sched_trap);
+
+static void __attribute__((interrupt("machine"), aligned(4))) sched_isr(void) {
+  sched_trap();
+}
+
+void sched_init(unsigned int tick_hz) {
+  period_cycles = SCHED_CPU_HZ / tick_hz;
+  ticks = 0;
+  pending = 0;
+  def_head = def_tail = 0;
+  for (int i = 0; i < SCHED_MAX_TASKS; i++)
+    tasks[i].fn = 0;
+
+  irq_set_vector(irq_shadow_enable() ? sched_vec : sched_isr);
+
+  TIMER_CTRL = 0;
+  TIMER_LO = 0;
+  TIMER_HI = 0;
+  next_tick = period_cycles;
+  timer_set_cmp(next_tick);
+  TIMER_CTRL = TIMER_EN | TIMER_UP | TIMER_IE;
+
+  asm volatile("csrs mie, %0" :: "r"(1 << 7));      // MTIE
+  irq_on();
+}
+
+unsigned int sched_ticks(void) {
+  return ticks;
+}
+
+static int task_add(unsigned int delay, unsigned int period, sched_fn_t fn, void *arg) {
+  for (int i = 0; i < SCHED_MAX_TASKS; i++) {
+    if (!tasks[i].fn) {
+      tasks[i].arg = arg;
+      tasks[i].period = period;
+      tasks[i].due = ticks + delay;
+      tasks[i].fn = fn;
+      return i;
+    }
+  }
+  return -1;
+}
+
+int sched_every(unsigned int period, sched_fn_t fn, void *arg) {
+  return task_add(period, period, fn, arg);
+}
+
+int sched_after(unsigned int delay, sched_fn_t fn, void *arg) {
+  return task_add(delay, 0, fn, arg);
+}
+
+void sched_cancel(int id) {
+  if (id >= 0 && id < SCHED_MAX_TASKS)
+    tasks[id].fn = 0;
+}
+
+void sched_on_external(void (*fn)(void)) {
+  ext_handler = fn;
+  if (fn)
+    asm volatile("csrs mie, %0" :: "r"(1 << 11));   // MEIE
+  else
+    asm volatile("csrc mie, %0" :: "r"(1 << 11));
+}
+
+void event_post(unsigned int ev) {
+  unsigned int m = irq_save();
+  pending |= ev;
+  irq_restore(m);
+}
+
+int defer(sched_fn_t fn, void *arg) {
+  unsigned int m = irq_save();
+  unsigned int h = def_head;
+  int ok = h - def_tail < SCHED_DEFER_SIZE;
+  if (ok) {
+    defq[h & (SCHED_DEFER_SIZE - 1)].fn = fn;
+    defq[h & (SCHED_DEFER_SIZE - 1)].arg = arg;
+    def_head = h + 1;
+    pending |= EV_DEFER;
+  }
+  irq_restore(m);
+  return ok;
+}
+
+static void run_deferred(void) {
+  unsigned int t = def_tail;
+  while (t != def_head) {
+    sched_fn_t fn = defq[t & (SCHED_DEFER_SIZE - 1)].fn;
+    void *arg = defq[t & (SCHED_DEFER_SIZE - 1)].arg;
+    def_tail = ++t;
+    fn(arg);
+  }
+}
+
+static void run_tasks(void) {
+  unsigned int now = ticks;
+  for (int i = 0; i < SCHED_MAX_TASKS; i++) {
+    task_t *t = &tasks[i];
+    sched_fn_t fn = t->fn;
+    if (!fn || (int)(now - t->due) < 0)
+      continue;
+    if (t->period) {
+      // Behind by several periods: run once and skip the rest
+      do
+        t->due += t->period;
+      while ((int)(now - t->due) >= 0);
+    } else {
+      t->fn = 0;
+    }
+    fn(t->arg);
+  }
+}
+
+unsigned int wait_for_event(unsigned int mask) {
+  const unsigned int want = mask | EV_TICK | EV_DEFER;
+
+  while (1) {
+    // Check and sleep with interrupts off, so an event posted in
+    // between still ends the WFI (it wakes on the pending interrupt);
+    // the interrupt is then taken once they are back on
+    irq_off();
+    unsigned int got = pending & want;
+    if (!got) {
+      wfi();
+      irq_on();
+      continue;
+    }
+    pending &= ~got;
+    irq_on();
+
+    if (got & EV_DEFER)
+      run_deferred();
+    if (got & EV_TICK)
+      run_tasks();
+    if (got & mask)
+      return got & mask;
+  }
+}
+
+void sched_run(void) {
+  while (1)
+    wait_for_event(0);
+}
@@ -0,0 +1,107 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef SCHED_H
+#define SCHED_H
+
+// ================================================================
+// Event-Driven Runtime for Z-Core
+//
+// A timer tick drives a cooperative task scheduler, interrupt
+// handlers hand work to the main program through events and deferred
+// callbacks, and the core sleeps in WFI whenever nothing is due, so
+// the program stops polling peripherals over the bus.
+//
+//   sched_init(1000);                       // 1 kHz tick
+//   sched_every(500, blink, 0);             // every 500 ticks
+//   sched_on_external(vga_irq);             // meip: VGA, DMA
+//   while (1) {
+//     wait_for_event(EV_USER(0));           // posted by vga_irq
+//     draw_frame();
+//   }
+//
+// Tasks and deferred callbacks run to completion in the main
+// program, from inside wait_for_event(); they must not wait
+// themselves. External handlers run in the trap handler with
+// interrupts off: keep them short and defer() the rest.
+//
+// The runtime owns mtvec and the timer (like the profiler). It uses
+// the shadow register bank when the core has one (see irq.h).
+// ================================================================
+
+#define SCHED_CPU_HZ      50000000u
+#define SCHED_MAX_TASKS   8
+#define SCHED_DEFER_SIZE  16     // Deferred calls queued at once (power of two)
+
+// Event bits: EV_USER(0..23) are the program's, the rest the runtime's
+#define EV_USER(n)  (1u << (n))
+#define EV_DEFER    (1u << 30)   // A deferred call was queued
+#define EV_TICK     (1u << 31)   // Timer tick
+
+typedef void (*sched_fn_t)(void *arg);
+
+// Start the tick at tick_hz and enable interrupts
+void sched_init(unsigned int tick_hz);
+
+// Ticks since sched_init
+unsigned int sched_ticks(void);
+
+// Run fn(arg) every period ticks / once after delay ticks.
+// Return a task id, or -1 if all SCHED_MAX_TASKS are in use.
+int sched_every(unsigned int period, sched_fn_t fn, void *arg);
+int sched_after(unsigned int delay, sched_fn_t fn, void *arg);
+void sched_cancel(int id);
+
+// Call fn from the trap handler on each external interrupt (meip)
+void sched_on_external(void (*fn)(void));
+
+// Set event bits; safe from handlers, tasks and the main program
+void event_post(unsigned int ev);
+
+// Queue fn(arg) to run in the main program. For handlers.
+// Returns 0 if the queue is full.
+int defer(sched_fn_t fn, void *arg);
+
+// Sleep until an event in mask is posted, running tasks and deferred
+// calls as they come due. Returns (and clears) the events of mask
+// that were set.
+unsigned int wait_for_event(unsigned int mask);
+
+// Run tasks and deferred calls forever
+void sched_run(void) __attribute__((noreturn));
+
+// Stall the core until an enabled interrupt is pending
+static inline void wfi(void) {
+  asm volatile("wfi" ::: "memory");
+}
+
+// Cycles spent asleep in WFI (mhpmcounter12); against mcycle this
+// gives the CPU load
+static inline unsigned int sched_sleep_cycles(void) {
+  unsigned int v;
+  asm volatile("csrr %0, 0xB0C" : "=r"(v));
+  return v;
+}
+
+#endif // SCHED_H
@@ -0,0 +1,123 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef SIMD_H
+#define SIMD_H
+
+/*
+ * Packed-SIMD intrinsics for Z-Core (4 x 8-bit lanes).
+ *
+ * Each 32-bit word holds four RRRGGGBB pixels, lowest address in
+ * bits [7:0]. Instructions live in the custom-0 (R-type) and
+ * custom-1 (I-type) opcode groups and are emitted with .insn, so no
+ * assembler support is needed.
+ *
+ *   custom-0, funct7 = 0000000 (byte lanes)
+ *     funct3 000 PADDUSB   001 PSUBUSB   010 PCMPEQB   011 PCMPLTUB
+ *            100 PMINUB    101 PMAXUB    110 PSELNZB   111 PSHUFB
+ *   custom-0, funct7 = 0000001 (3-3-2 color channels)
+ *     funct3 000 PAVG332   001 PBLD332   010 PADDS332  011 PSUBS332
+ *   custom-1, funct3 = 000
+ *     PSHUFBI (selectors in imm[7:0])
+ */
+
+typedef unsigned int px4_t;
+
+#define SIMD_R(f3, f7, a, b) ({ px4_t _r; \
+    asm volatile(".insn r 0x0B, " #f3 ", " #f7 ", %0, %1, %2" : "=r"(_r) : "r"(a), "r"(b)); _r; })
+
+#define SIMD_I(f3, imm, a) ({ px4_t _r; \
+    asm volatile(".insn i 0x2B, " #f3 ", %0, %1, %2" : "=r"(_r) : "r"(a), "i"(imm)); _r; })
+
+/* Replicate one pixel into all four lanes */
+static inline px4_t px4_splat(unsigned char c) {
+    return (px4_t)c * 0x01010101u;
+}
+
+/* ---- Byte-lane arithmetic ---- */
+
+static inline px4_t px4_addus(px4_t a, px4_t b) { return SIMD_R(0, 0, a, b); }
+static inline px4_t px4_subus(px4_t a, px4_t b) { return SIMD_R(1, 0, a, b); }
+static inline px4_t px4_min(px4_t a, px4_t b)   { return SIMD_R(4, 0, a, b); }
+static inline px4_t px4_max(px4_t a, px4_t b)   { return SIMD_R(5, 0, a, b); }
+
+/* ---- Compare and select ---- */
+
+/* 0xFF in each lane where a == b */
+static inline px4_t px4_cmpeq(px4_t a, px4_t b)  { return SIMD_R(2, 0, a, b); }
+
+/* 0xFF in each lane where a < b (unsigned) */
+static inline px4_t px4_cmpltu(px4_t a, px4_t b) { return SIMD_R(3, 0, a, b); }
+
+/* Lane of a where non-zero, else lane of b (color 0 is transparent) */
+static inline px4_t px4_overlay(px4_t a, px4_t b) { return SIMD_R(6, 0, a, b); }
+
+/* Lane of a where mask is 0xFF, else lane of b */
+static inline px4_t px4_select(px4_t mask, px4_t a, px4_t b) {
+    return (a & mask) | (b & ~mask);
+}
+
+/* ---- Shuffle ---- */
+
+/* Build a shuffle selector: destination lane i takes source byte si */
+#define PX4_SHUF(s0, s1, s2, s3) \
+    ((((s3) & 3) << 6) | (((s2) & 3) << 4) | (((s1) & 3) << 2) | ((s0) & 3))
+
+/* Shuffle with a run-time selector (low 8 bits of sel) */
+static inline px4_t px4_shuffle(px4_t a, px4_t sel) { return SIMD_R(7, 0, a, sel); }
+
+/* Shuffle with a compile-time selector */
+#define px4_shufflei(a, sel) SIMD_I(0, (sel), (a))
+
+/* Mirror four pixels horizontally */
+#define px4_reverse(a) px4_shufflei((a), PX4_SHUF(3, 2, 1, 0))
+
+/* ---- 3-3-2 color blending (per R/G/B channel) ---- */
+
+/* 1/2 a + 1/2 b */
+static inline px4_t px4_blend50(px4_t a, px4_t b) { return SIMD_R(0, 1, a, b); }
+
+/* 3/4 a + 1/4 b (swap operands for 1/4 a + 3/4 b) */
+static inline px4_t px4_blend75(px4_t a, px4_t b) { return SIMD_R(1, 1, a, b); }
+
+/* Saturating a + b per channel (additive light) */
+static inline px4_t px4_add332(px4_t a, px4_t b)  { return SIMD_R(2, 1, a, b); }
+
+/* Saturating a - b per channel (fade towards black) */
+static inline px4_t px4_sub332(px4_t a, px4_t b)  { return SIMD_R(3, 1, a, b); }
+
+/* ---- Sprite helpers ---- */
+
+/*
+ * Expand 4 bits of a 1-bpp sprite row into a px4_t of color/0 lanes.
+ * Bit 3 of 'bits' is the leftmost pixel (lane 0), matching the
+ * MSB-first row layout used by the sprites in space.c.
+ */
+static inline px4_t px4_from_mask(unsigned int bits, unsigned char color) {
+    px4_t m = ((bits & 8) ? 0x000000FFu : 0) | ((bits & 4) ? 0x0000FF00u : 0) |
+              ((bits & 2) ? 0x00FF0000u : 0) | ((bits & 1) ? 0xFF000000u : 0);
+    return m & px4_splat(color);
+}
+
+#endif /* SIMD_H */
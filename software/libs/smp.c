@@ -0,0 +1,44 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "smp.h"
+
+extern void _start(void);
+extern hart_entry_t __hart_entry[SMP_MAX_HARTS];
+
+int hart_start(unsigned int hart, hart_entry_t entry) {
+  if (hart == 0 || hart >= SMP_MAX_HARTS || hart >= hart_count())
+    return -1;
+
+  HART_RUN &= ~(1u << hart);
+  __hart_entry[hart] = entry;
+  HART_BOOT = (unsigned int)_start;
+  HART_RUN |= 1u << hart;
+  return 0;
+}
+
+void hart_stop(unsigned int hart) {
+  if (hart != 0)
+    HART_RUN &= ~(1u << hart);
+}
@@ -0,0 +1,176 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef SMP_H
+#define SMP_H
+
+// ================================================================
+// Multi-hart Support for Z-Core (NUM_HARTS > 1)
+//
+// Hart 0 runs main(); the others are held in reset by axil_hartctl
+// until hart_start() releases them at _start, where start.S gives
+// each hart its own HART_STACK_SIZE stack below _stack_top and calls
+// the entry function stored for it. Hart 0's stack is limited to
+// HART_STACK_SIZE as well once a second hart runs.
+//
+// RAM and peripherals are shared and uncached, and every access is
+// complete before the next instruction retires, so plain volatile
+// accesses are seen by the other hart in program order. The AMOs
+// and LR/SC below (RV32A) make read-modify-write sequences atomic.
+// ================================================================
+
+#define HARTCTL_BASE   0x04005000
+#define HART_COUNT     (*((volatile unsigned int *)(HARTCTL_BASE + 0x00)))
+#define HART_RUN       (*((volatile unsigned int *)(HARTCTL_BASE + 0x04)))
+#define HART_BOOT      (*((volatile unsigned int *)(HARTCTL_BASE + 0x08)))
+
+#define SMP_MAX_HARTS   4
+#define HART_STACK_SIZE 1024   // must match HART_STACK_SHIFT in start.S
+
+typedef void (*hart_entry_t)(unsigned int hart);
+
+static inline unsigned int hart_id(void) {
+  unsigned int v;
+  asm volatile("csrr %0, mhartid" : "=r"(v));
+  return v;
+}
+
+static inline unsigned int hart_count(void) {
+  return HART_COUNT;
+}
+
+// Release hart (1..hart_count()-1) to run entry(hart) on its own
+// stack. A running hart is reset first. Returns -1 if there is no
+// such hart.
+int hart_start(unsigned int hart, hart_entry_t entry);
+
+// Hold hart in reset
+void hart_stop(unsigned int hart);
+
+// ---- Atomics (return the old value) ----
+
+static inline unsigned int atomic_add(volatile unsigned int *p, unsigned int v) {
+  unsigned int old;
+  asm volatile("amoadd.w %0, %2, (%1)" : "=r"(old) : "r"(p), "r"(v) : "memory");
+  return old;
+}
+
+static inline unsigned int atomic_swap(volatile unsigned int *p, unsigned int v) {
+  unsigned int old;
+  asm volatile("amoswap.w %0, %2, (%1)" : "=r"(old) : "r"(p), "r"(v) : "memory");
+  return old;
+}
+
+static inline unsigned int atomic_or(volatile unsigned int *p, unsigned int v) {
+  unsigned int old;
+  asm volatile("amoor.w %0, %2, (%1)" : "=r"(old) : "r"(p), "r"(v) : "memory");
+  return old;
+}
+
+static inline unsigned int atomic_and(volatile unsigned int *p, unsigned int v) {
+  unsigned int old;
+  asm volatile("amoand.w %0, %2, (%1)" : "=r"(old) : "r"(p), "r"(v) : "memory");
+  return old;
+}
+
+// Compare-and-swap with LR/SC; returns the value found at *p
+static inline unsigned int atomic_cas(volatile unsigned int *p, unsigned int expect,
+                                      unsigned int v) {
+  unsigned int old, fail;
+  asm volatile(
+    "1: lr.w %0, (%2)\n"
+    "   bne  %0, %3, 2f\n"
+    "   sc.w %1, %4, (%2)\n"
+    "   bnez %1, 1b\n"
+    "2:"
+    : "=&r"(old), "=&r"(fail)
+    : "r"(p), "r"(expect), "r"(v)
+    : "memory");
+  return old;
+}
+
+// ---- Spinlock ----
+
+typedef volatile unsigned int spinlock_t;
+
+static inline void spin_lock(spinlock_t *l) {
+  while (atomic_swap(l, 1))
+    while (*l)
+      ;
+}
+
+static inline int spin_trylock(spinlock_t *l) {
+  return atomic_swap(l, 1) == 0;
+}
+
+static inline void spin_unlock(spinlock_t *l) {
+  asm volatile("" ::: "memory");
+  *l = 0;
+}
+
+// ---- Single-producer / single-consumer queue ----
+// Lock-free: head is written only by the producer, tail only by the
+// consumer. size must be a power of two; one queue per direction.
+
+typedef struct {
+  volatile unsigned int head;
+  volatile unsigned int tail;
+  unsigned int mask;
+  unsigned int *buf;
+} spsc_queue_t;
+
+static inline void spsc_init(spsc_queue_t *q, unsigned int *buf, unsigned int size) {
+  q->head = 0;
+  q->tail = 0;
+  q->mask = size - 1;
+  q->buf = buf;
+}
+
+// Returns 0 when full
+static inline int spsc_push(spsc_queue_t *q, unsigned int v) {
+  unsigned int h = q->head;
+  if (h - q->tail > q->mask)
+    return 0;
+  q->buf[h & q->mask] = v;
+  asm volatile("" ::: "memory");   // data before the index
+  q->head = h + 1;
+  return 1;
+}
+
+// Returns 0 when empty
+static inline int spsc_pop(spsc_queue_t *q, unsigned int *v) {
+  unsigned int t = q->tail;
+  if (t == q->head)
+    return 0;
+  asm volatile("" ::: "memory");   // index before the data
+  *v = q->buf[t & q->mask];
+  q->tail = t + 1;
+  return 1;
+}
+
+static inline unsigned int spsc_count(const spsc_queue_t *q) {
+  return q->head - q->tail;
+}
+
+#endif // SMP_H
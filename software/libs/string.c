@@ -0,0 +1,204 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "string.h"
+#include <stdint.h>
+
+// Word type that may alias any object (memcpy is called on all types)
+typedef uint32_t __attribute__((may_alias)) word_t;
+
+#define ONES  0x01010101u
+#define HIGHS 0x80808080u
+
+// Non-zero if any byte of v is zero
+#define HAS_ZERO(v) (((v) - ONES) & ~(v) & HIGHS)
+
+// ----------------------------------------------------------------
+// Aligned word copy, 8 words per iteration. Loads are grouped
+// ahead of stores so each load's result is ready before it is
+// needed (no load-use bubbles).
+// ----------------------------------------------------------------
+static inline void copy_words(word_t *d, const word_t *s, size_t nw) {
+  while (nw >= 8) {
+    word_t a = s[0], b = s[1], c = s[2], e = s[3];
+    word_t f = s[4], g = s[5], h = s[6], i = s[7];
+    d[0] = a; d[1] = b; d[2] = c; d[3] = e;
+    d[4] = f; d[5] = g; d[6] = h; d[7] = i;
+    d += 8; s += 8; nw -= 8;
+  }
+  while (nw--)
+    *d++ = *s++;
+}
+
+void *memcpy(void *dst, const void *src, size_t n) {
+  unsigned char *d = dst;
+  const unsigned char *s = src;
+
+  if (n < 8)
+    goto tail;
+
+  // Align the destination
+  while ((uintptr_t)d & 3) {
+    *d++ = *s++;
+    n--;
+  }
+
+  if (((uintptr_t)s & 3) == 0) {
+    // Same alignment: straight word copy
+    size_t nw = n >> 2;
+    copy_words((word_t *)d, (const word_t *)s, nw);
+    d += nw << 2;
+    s += nw << 2;
+    n &= 3;
+  } else {
+    // Different alignment: read aligned source words and shift-merge.
+    // The last aligned read may extend past src + n, but never past
+    // the word holding the last source byte.
+    unsigned int sh = ((uintptr_t)s & 3) * 8;
+    const word_t *sw = (const word_t *)((uintptr_t)s & ~(uintptr_t)3);
+    word_t *dw = (word_t *)d;
+    word_t w0 = *sw++;
+
+    while (n >= 8) {
+      word_t w1 = sw[0], w2 = sw[1];
+      dw[0] = (w0 >> sh) | (w1 << (32 - sh));
+      dw[1] = (w1 >> sh) | (w2 << (32 - sh));
+      w0 = w2;
+      sw += 2; dw += 2; n -= 8;
+    }
+    d = (unsigned char *)dw;
+    s = (const unsigned char *)sw - 4 + (sh >> 3);
+  }
+
+tail:
+  while (n--)
+    *d++ = *s++;
+  return dst;
+}
+
+void *memmove(void *dst, const void *src, size_t n) {
+  unsigned char *d = dst;
+  const unsigned char *s = src;
+
+  // Forward copy is safe unless dst overlaps the tail of src
+  if (d <= s || d >= s + n)
+    return memcpy(dst, src, n);
+
+  d += n;
+  s += n;
+
+  if (n >= 8 && (((uintptr_t)d ^ (uintptr_t)s) & 3) == 0) {
+    // Same alignment: copy backwards a word at a time
+    while ((uintptr_t)d & 3) {
+      *--d = *--s;
+      n--;
+    }
+    while (n >= 16) {
+      word_t a = ((const word_t *)s)[-1], b = ((const word_t *)s)[-2];
+      word_t c = ((const word_t *)s)[-3], e = ((const word_t *)s)[-4];
+      ((word_t *)d)[-1] = a; ((word_t *)d)[-2] = b;
+      ((word_t *)d)[-3] = c; ((word_t *)d)[-4] = e;
+      d -= 16; s -= 16; n -= 16;
+    }
+    while (n >= 4) {
+      d -= 4; s -= 4; n -= 4;
+      *(word_t *)d = *(const word_t *)s;
+    }
+  }
+
+  while (n--)
+    *--d = *--s;
+  return dst;
+}
+
+void *memset(void *dst, int c, size_t n) {
+  unsigned char *d = dst;
+  word_t v = (unsigned char)c * ONES;
+
+  if (n >= 8) {
+    while ((uintptr_t)d & 3) {
+      *d++ = (unsigned char)c;
+      n--;
+    }
+    word_t *dw = (word_t *)d;
+    while (n >= 32) {
+      dw[0] = v; dw[1] = v; dw[2] = v; dw[3] = v;
+      dw[4] = v; dw[5] = v; dw[6] = v; dw[7] = v;
+      dw += 8; n -= 32;
+    }
+    while (n >= 4) {
+      *dw++ = v;
+      n -= 4;
+    }
+    d = (unsigned char *)dw;
+  }
+
+  while (n--)
+    *d++ = (unsigned char)c;
+  return dst;
+}
+
+int memcmp(const void *a, const void *b, size_t n) {
+  const unsigned char *p = a;
+  const unsigned char *q = b;
+
+  if (n >= 8 && (((uintptr_t)p ^ (uintptr_t)q) & 3) == 0) {
+    while ((uintptr_t)p & 3) {
+      if (*p != *q)
+        return *p - *q;
+      p++; q++; n--;
+    }
+    // Skip equal words; the byte loop below finds the differing byte
+    while (n >= 4 && *(const word_t *)p == *(const word_t *)q) {
+      p += 4; q += 4; n -= 4;
+    }
+  }
+
+  while (n--) {
+    if (*p != *q)
+      return *p - *q;
+    p++; q++;
+  }
+  return 0;
+}
+
+size_t strlen(const char *s) {
+  const char *p = s;
+
+  while ((uintptr_t)p & 3) {
+    if (!*p)
+      return p - s;
+    p++;
+  }
+
+  // Aligned word reads never cross into an unmapped word
+  const word_t *w = (const word_t *)p;
+  while (!HAS_ZERO(*w))
+    w++;
+
+  p = (const char *)w;
+  while (*p)
+    p++;
+  return p - s;
+}
@@ -0,0 +1,70 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef TIMER_H
+#define TIMER_H
+
+// ================================================================
+// 64-bit Timer (axil_timer) for Z-Core
+//
+// Register map and the 64-bit accessors shared by the profiler, the
+// scheduler and the interrupt demos. See doc/TIMER.md.
+// ================================================================
+
+#define TIMER_BASE  0x04002000
+#define TIMER_LO    (*((volatile unsigned int *)(TIMER_BASE + 0x00)))
+#define TIMER_HI    (*((volatile unsigned int *)(TIMER_BASE + 0x04)))
+#define TIMER_CTRL  (*((volatile unsigned int *)(TIMER_BASE + 0x08)))
+#define TIMECMP_LO  (*((volatile unsigned int *)(TIMER_BASE + 0x0C)))
+#define TIMECMP_HI  (*((volatile unsigned int *)(TIMER_BASE + 0x10)))
+
+// TIMER_CTRL
+#define TIMER_EN    0x1
+#define TIMER_UP    0x2
+#define TIMER_EXT   0x4   // Count timer_ext_event_i edges instead of cycles
+#define TIMER_IE    0x8   // mtip while TIMER >= TIMECMP
+
+// Consistent 64-bit read: retry if the low half wrapped in between
+static inline unsigned long long timer_read(void) {
+  unsigned int hi, lo;
+  do {
+    hi = TIMER_HI;
+    lo = TIMER_LO;
+  } while (hi != TIMER_HI);
+  return ((unsigned long long)hi << 32) | lo;
+}
+
+// No compare match until the next timer_set_cmp
+static inline void timer_disarm(void) {
+  TIMECMP_HI = 0xFFFFFFFF;
+}
+
+static inline void timer_set_cmp(unsigned long long t) {
+  // Park the compare high first so no intermediate value fires
+  timer_disarm();
+  TIMECMP_LO = (unsigned int)t;
+  TIMECMP_HI = (unsigned int)(t >> 32);
+}
+
+#endif // TIMER_H
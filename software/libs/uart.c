@@ -48,26 +48,20 @@ void uart_puthex(unsigned int val) {
 }
 
 void uart_putint(int val) {
-  char buf[12];
+  char buf[10];
   int i = 0;
-  int neg = 0;
+  // Negate as unsigned so INT_MIN prints correctly
+  unsigned int u = (val < 0) ? 0u - (unsigned int)val : (unsigned int)val;
 
-  if (val < 0) {
-    neg = 1;
-    val = -val;
-  }
-
-  if (val == 0) {
-    uart_putc('0');
-    return;
-  }
-
-  while (val > 0) {
-    buf[i++] = '0' + (val % 10);
-    val = val / 10;
-  }
+  // x / 10 by reciprocal multiply: under -Os (bootloader) GCC
+  // would otherwise emit DIVU/REMU, 32+ stall cycles per digit
+  do {
+    unsigned int q = (unsigned int)(((unsigned long long)u * 0xCCCCCCCDu) >> 35);
+    buf[i++] = '0' + (u - q * 10);
+    u = q;
+  } while (u);
 
-  if (neg)
+  if (val < 0)
     uart_putc('-');
   while (i > 0) {
     uart_putc(buf[--i]);
@@ -5,10 +5,58 @@
 #define VGA_FB_ADDR    (*((volatile unsigned int *)(VGA_BASE + 0x00)))
 #define VGA_FB_DATA    (*((volatile unsigned int *)(VGA_BASE + 0x04)))
 #define VGA_FB_STATUS  (*((volatile unsigned int *)(VGA_BASE + 0x08)))
+#define VGA_CTRL       (*((volatile unsigned int *)(VGA_BASE + 0x0C)))
+#define VGA_PAL_INDEX  (*((volatile unsigned int *)(VGA_BASE + 0x10)))
+#define VGA_PAL_DATA   (*((volatile unsigned int *)(VGA_BASE + 0x14)))
+#define VGA_PAL_OFFSET (*((volatile unsigned int *)(VGA_BASE + 0x18)))
+#define VGA_FB_NIBBLE  (*((volatile unsigned int *)(VGA_BASE + 0x1C)))
+#define VGA_TXT_CTRL   (*((volatile unsigned int *)(VGA_BASE + 0x20)))
+#define VGA_TXT_POS    (*((volatile unsigned int *)(VGA_BASE + 0x24)))
+#define VGA_TXT_PUTC   (*((volatile unsigned int *)(VGA_BASE + 0x28)))
+#define VGA_TXT_ATTR   (*((volatile unsigned int *)(VGA_BASE + 0x2C)))
+#define VGA_TXT_CELL   (*((volatile unsigned int *)(VGA_BASE + 0x30)))
+#define VGA_TXT_ORIGIN (*((volatile unsigned int *)(VGA_BASE + 0x34)))
+#define VGA_SCROLL_X   (*((volatile unsigned int *)(VGA_BASE + 0x38)))
+#define VGA_SCROLL_Y   (*((volatile unsigned int *)(VGA_BASE + 0x3C)))
+#define VGA_LINE_CMP   (*((volatile unsigned int *)(VGA_BASE + 0x40)))
+#define VGA_IRQ_EN     (*((volatile unsigned int *)(VGA_BASE + 0x44)))
+#define VGA_IRQ_STATUS (*((volatile unsigned int *)(VGA_BASE + 0x48)))
+#define VGA_LINE       (*((volatile unsigned int *)(VGA_BASE + 0x4C)))
 
 #define VGA_WIDTH      160
 #define VGA_HEIGHT     120
 
+/* Scanout modes (VGA_CTRL) */
+#define VGA_MODE_RGB332 0   /* 160x120, 8-bit 3-3-2 color, 4x upscale */
+#define VGA_MODE_PAL8   1   /* 160x120, 8-bit palette index, 4x upscale */
+#define VGA_MODE_PAL4   2   /* 320x240, 4-bit palette index, 2x upscale */
+
+#define VGA4_WIDTH     320
+#define VGA4_HEIGHT    240
+#define VGA4_STRIDE    160  /* bytes per line, two pixels per byte */
+
+/* Text layer: 40x30 cells of 8x8 glyphs at 2x, over any mode.
+ * Use console.h for printing; these are the raw registers. */
+#define VGA_TXT_COLS   40
+#define VGA_TXT_ROWS   30
+#define VGA_TXT_ON     0x1  /* VGA_TXT_CTRL bits */
+#define VGA_TXT_CURSOR 0x2
+#define VGA_TXT_BLINK  0x4
+
+/* Text attribute: fg 0..15 over an opaque bg 0..7, or fg only (the
+ * framebuffer shows around the glyph) */
+#define VGA_TXT_COLOR(fg,bg) ((unsigned int)((fg) | ((bg) << 4) | 0x80))
+#define VGA_TXT_INK(fg)      ((unsigned int)(fg))
+
+/* Raster interrupts (VGA_IRQ_EN / VGA_IRQ_STATUS, write 1 to clear).
+ * They share meip with the DMA engine. VGA_LINE_CMP and VGA_LINE count
+ * screen lines 0..479; divide by 4 (or 2 in PAL4) for framebuffer lines. */
+#define VGA_IRQ_LINE   0x1  /* start of line VGA_LINE_CMP, before its pixels */
+#define VGA_IRQ_VBLANK 0x2  /* after the last visible line */
+
+/* 12-bit palette color: 0xRGB, 4 bits each */
+#define VGA_RGB444(r,g,b) ((unsigned int)(((r)<<8)|((g)<<4)|(b)))
+
 /* 8-bit color: RRRGGGBB */
 #define VGA_RGB(r,g,b) ((unsigned char)(((r)<<5)|((g)<<2)|(b)))
 
@@ -42,6 +90,48 @@ static inline void vga_fill_rect(int x0, int y0, int w, int h, unsigned char col
     }
 }
 
+static inline void vga_set_mode(int mode) {
+    VGA_CTRL = (unsigned int)mode;
+}
+
+static inline void vga_set_palette(int index, unsigned int rgb444) {
+    VGA_PAL_INDEX = (unsigned int)index;
+    VGA_PAL_DATA = rgb444;
+}
+
+static inline void vga_load_palette(int first, const unsigned short *rgb444, int n) {
+    VGA_PAL_INDEX = (unsigned int)first;
+    for (int i = 0; i < n; i++)
+        VGA_PAL_DATA = rgb444[i];   /* index auto-increments */
+}
+
+/* PAL8: entry = pixel + offset. PAL4: entry = (offset & 0xF0) |
+ * ((pixel + offset) & 0x0F), so the high nibble picks a 16-color bank. */
+static inline void vga_rotate_palette(int offset) {
+    VGA_PAL_OFFSET = (unsigned int)offset;
+}
+
+/* 4-bpp (VGA_MODE_PAL4) drawing */
+static inline void vga4_set_pixel(int x, int y, unsigned char color) {
+    VGA_FB_ADDR = (unsigned int)(y * VGA4_STRIDE + (x >> 1));
+    VGA_FB_NIBBLE = ((unsigned int)(x & 1) << 4) | (color & 0x0F);
+}
+
+static inline void vga4_fill(unsigned char color) {
+    unsigned int pair = (color & 0x0F) * 0x11u;
+    VGA_FB_ADDR = 0;
+    for (int i = 0; i < VGA4_STRIDE * VGA4_HEIGHT; i++)
+        VGA_FB_DATA = pair;
+}
+
+/* Show framebuffer column x / line y at the top left; the image wraps
+ * around. Both must be less than the mode's width / height. The text
+ * layer does not scroll. */
+static inline void vga_scroll(int x, int y) {
+    VGA_SCROLL_X = (unsigned int)x;
+    VGA_SCROLL_Y = (unsigned int)y;
+}
+
 static inline void vga_wait_vsync(void) {
     while (!(VGA_FB_STATUS & 0x01))
         ;
@@ -0,0 +1,140 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ================================================================
+// VGA Palette Demo - Z-Core
+// Color cycling in the indexed modes: a 160x120 8-bpp plasma in
+// PAL8, then 320x240 4-bpp rings in PAL4. Each frame is one
+// VGA_PAL_OFFSET write; the framebuffer is drawn once. The button
+// on GPIO bit 8 switches modes. Build with APP=1.
+// ================================================================
+
+#include "libs/uart.h"
+#include "libs/vga.h"
+#include "libs/fixmath.h"
+
+#define GPIO_LOW (*((volatile unsigned int *)0x04001000))
+
+static unsigned short pal[256];
+
+static inline unsigned int read_cycle(void) {
+  unsigned int v;
+  asm volatile("csrr %0, mcycle" : "=r"(v));
+  return v;
+}
+
+// Smooth hue wheel: 6 ramps of up to 43 steps, 4 bits per channel
+static void build_palette(void) {
+  for (int i = 0; i < 256; i++) {
+    int seg = i / 43, t = (i % 43) * 15 / 42;
+    int r, g, b;
+    switch (seg) {
+    case 0:  r = 15;     g = t;      b = 0;      break;
+    case 1:  r = 15 - t; g = 15;     b = 0;      break;
+    case 2:  r = 0;      g = 15;     b = t;      break;
+    case 3:  r = 0;      g = 15 - t; b = 15;     break;
+    case 4:  r = t;      g = 0;      b = 15;     break;
+    default: r = 15;     g = 0;      b = 15 - t; break;
+    }
+    pal[i] = (unsigned short)VGA_RGB444(r, g, b);
+  }
+}
+
+// Index = sum of two sine waves, so cycling the palette moves the bands
+static void draw_plasma(void) {
+  VGA_FB_ADDR = 0;
+  for (int y = 0; y < VGA_HEIGHT; y++)
+    for (int x = 0; x < VGA_WIDTH; x++) {
+      fix16_t a = fix16_sin((uint32_t)(x * FIX16_ANGLE_TURN / 48)) +
+                  fix16_sin((uint32_t)(y * FIX16_ANGLE_TURN / 32 + x * FIX16_ANGLE_TURN / 96));
+      VGA_FB_DATA = (unsigned int)((a + 2 * FIX16_ONE) >> 10) & 0xFF;
+    }
+}
+
+// Concentric rings, one color per ring, 16 rings per cycle
+static void draw_rings(void) {
+  VGA_FB_ADDR = 0;
+  for (int y = 0; y < VGA4_HEIGHT; y++) {
+    int dy = y - VGA4_HEIGHT / 2;
+    for (int x = 0; x < VGA4_WIDTH; x += 2) {
+      unsigned int pair = 0;
+      for (int k = 0; k < 2; k++) {
+        int dx = x + k - VGA4_WIDTH / 2;
+        unsigned int d = (unsigned int)(dx * dx + dy * dy) >> 6;
+        pair |= (d & 0x0F) << (4 * k);
+      }
+      VGA_FB_DATA = pair;
+    }
+  }
+}
+
+// Rising edge of the button on GPIO bit 8
+static int key_pressed(void) {
+  static unsigned int last;
+  unsigned int k = (GPIO_LOW >> 8) & 1;
+  int pressed = k && !last;
+  last = k;
+  return pressed;
+}
+
+int main(void) {
+  uart_puts("\r\n=== Z-Core VGA Palette Demo ===\r\n");
+  build_palette();
+
+  unsigned int t0;
+  int mode = VGA_MODE_PAL8;
+  for (;;) {
+    vga_rotate_palette(0);
+    vga_set_mode(mode);
+    t0 = read_cycle();
+    if (mode == VGA_MODE_PAL8) {
+      vga_load_palette(0, pal, 256);
+      draw_plasma();
+    } else {
+      // Bank 1 (entries 16..31): 16 hues spread over the wheel
+      VGA_PAL_INDEX = 16;
+      for (int i = 0; i < 16; i++)
+        VGA_PAL_DATA = pal[i * 16];
+      draw_rings();
+    }
+    unsigned int t_draw = read_cycle() - t0;
+    uart_puts(mode == VGA_MODE_PAL8 ? "PAL8 160x120" : "PAL4 320x240");
+    uart_puts(": draw "); uart_putint((int)t_draw);
+    uart_puts(" cycles, then one register write per frame\r\n");
+
+    unsigned int off = 0;
+    while (!key_pressed()) {
+      vga_wait_vsync();
+      off++;
+      if (mode == VGA_MODE_PAL8) {
+        vga_rotate_palette((int)(off & 0xFF));
+      } else {
+        // Bank 1, rotating within its 16 entries
+        vga_rotate_palette(0x10 | (int)((off >> 2) & 0x0F));
+      }
+    }
+    mode = (mode == VGA_MODE_PAL8) ? VGA_MODE_PAL4 : VGA_MODE_PAL8;
+  }
+  return 0;
+}
@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+"""
+Z-Core Sampling Profile Report
+
+Decodes the PC-sample frames streamed by libs/prof.c, symbolizes them
+against the program ELF and prints a flat profile. No external
+dependencies -- uses only the Python standard library.
+
+Usage:
+    ./prof_report.py <program.elf> --port /dev/ttyUSB0 [--seconds 10]
+    ./prof_report.py <program.elf> --capture raw.bin
+    ./upload.py /dev/ttyUSB0 space.bin --profile space.elf
+
+Frames are 0xFE | n | dropped | n x u16 (PC >> 2) | checksum; all
+other bytes are program text and are passed through to stdout.
+--hist writes a "<hex pc> <count>" histogram for icache_layout.py.
+"""
+
+import os
+import sys
+import time
+import select
+import argparse
+from collections import defaultdict
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+from trace_report import read_symbols, Symbolizer  # noqa: E402
+
+FRAME_SYNC = 0xFE
+
+
+class FrameDecoder:
+    """Byte-at-a-time decoder; frames may be split across reads."""
+
+    def __init__(self):
+        self.counts = defaultdict(int)
+        self.samples = 0
+        self.dropped = 0
+        self.bad_frames = 0
+        self.buf = None
+        self.need = 0
+
+    def feed(self, data):
+        """Consume bytes; return the text bytes that were not part of a frame."""
+        text = bytearray()
+        for b in data:
+            if self.buf is None:
+                if b == FRAME_SYNC:
+                    self.buf = bytearray()
+                    self.need = 2
+                else:
+                    text.append(b)
+                continue
+
+            self.buf.append(b)
+            if len(self.buf) == 2 and self.need == 2:
+                # n and dropped known: n samples + checksum remain
+                self.need = 2 + 2 * self.buf[0] + 1
+            if len(self.buf) == self.need:
+                self._frame(self.buf)
+                self.buf = None
+        return bytes(text)
+
+    def _frame(self, f):
+        n, dropped = f[0], f[1]
+        if (sum(f[:-1]) & 0xFF) != f[-1]:
+            self.bad_frames += 1
+            return
+        self.dropped += dropped
+        for i in range(n):
+            pc = (f[2 + 2 * i] | (f[3 + 2 * i] << 8)) << 2
+            self.counts[pc] += 1
+        self.samples += n
+
+
+def print_profile(dec, elf, top):
+    sym = Symbolizer(read_symbols(elf))
+    per_func = defaultdict(int)
+    for pc, c in dec.counts.items():
+        per_func[sym.lookup(pc)[0]] += c
+
+    total = dec.samples or 1
+    print()
+    print(f"Samples: {dec.samples}  dropped: {dec.dropped}  bad frames: {dec.bad_frames}")
+    print()
+    print(f"{'function':<28} {'samples':>8} {'%':>7} {'cum %':>7}")
+    print("-" * 53)
+    cum = 0
+    for name, c in sorted(per_func.items(), key=lambda kv: -kv[1])[:top]:
+        cum += c
+        print(f"{name:<28} {c:>8} {100.0 * c / total:>6.2f}% {100.0 * cum / total:>6.2f}%")
+
+    print()
+    print(f"Hottest PCs:")
+    for pc, c in sorted(dec.counts.items(), key=lambda kv: -kv[1])[:min(top, 10)]:
+        name, off = sym.lookup(pc)
+        print(f"  0x{pc:08X} {name}+0x{off:X}  {c} ({100.0 * c / total:.1f}%)")
+
+
+def write_histogram(dec, path):
+    with open(path, 'w') as f:
+        f.write("# Z-Core PC samples: <pc> <count>\n")
+        for pc in sorted(dec.counts):
+            f.write(f"{pc:08x} {dec.counts[pc]}\n")
+
+
+def collect(fd, dec, seconds, echo=True):
+    """Read from an open serial fd until the time runs out or Ctrl-C."""
+    end = time.time() + seconds if seconds else None
+    try:
+        while end is None or time.time() < end:
+            r, _, _ = select.select([fd], [], [], 0.2)
+            if not r:
+                continue
+            text = dec.feed(os.read(fd, 4096))
+            if echo and text:
+                sys.stdout.buffer.write(text)
+                sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Z-Core sampling profile report")
+    parser.add_argument("elf", help="Program ELF")
+    src = parser.add_mutually_exclusive_group(required=True)
+    src.add_argument("--port", help="Serial port to read samples from")
+    src.add_argument("--capture", help="Raw UART capture file")
+    parser.add_argument("--baud", type=int, default=115200, help="Baud rate (default: 115200)")
+    parser.add_argument("--seconds", type=float, default=0, help="Stop after N seconds (default: Ctrl-C)")
+    parser.add_argument("--top", type=int, default=20, help="Functions to list")
+    parser.add_argument("--hist", help="Write a PC histogram for icache_layout.py")
+    args = parser.parse_args()
+
+    dec = FrameDecoder()
+    if args.capture:
+        with open(args.capture, 'rb') as f:
+            dec.feed(f.read())
+    else:
+        from upload import configure_port
+        fd = os.open(args.port, os.O_RDWR | os.O_NOCTTY)
+        configure_port(fd, args.baud)
+        print("--- Sampling (Ctrl-C to stop) ---")
+        collect(fd, dec, args.seconds)
+        os.close(fd)
+
+    print_profile(dec, args.elf, args.top)
+    if args.hist:
+        write_histogram(dec, args.hist)
+        print(f"\nWrote {args.hist}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,231 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ================================================================
+// Runtime Library Benchmark - Z-Core
+// Cycles per byte of the libs/ string routines against naive byte
+// loops, the div-free formatter against a DIVU/REMU one, and the
+// table sin against its accuracy bound. Build with APP=1.
+// ================================================================
+
+#include "libs/uart.h"
+#include "libs/string.h"
+#include "libs/fmt.h"
+#include "libs/fixmath.h"
+
+#define GPIO_OUT (*((volatile unsigned int *)0x04001000))
+#define GPIO_DIR (*((volatile unsigned int *)0x04001008))
+
+#define N 1024
+
+static unsigned char src[N + 8] __attribute__((aligned(4)));
+static unsigned char dst[N + 8] __attribute__((aligned(4)));
+
+static inline unsigned int read_cycle(void) {
+  unsigned int v;
+  asm volatile("csrr %0, mcycle" : "=r"(v));
+  return v;
+}
+
+// The empty asm keeps GCC from recognizing the baseline loops and
+// turning them back into library calls
+static void __attribute__((noinline)) naive_copy(unsigned char *d, const unsigned char *s, unsigned int n) {
+  while (n--) {
+    *d++ = *s++;
+    asm volatile("" ::: "memory");
+  }
+}
+
+static void __attribute__((noinline)) naive_fill(unsigned char *d, unsigned char c, unsigned int n) {
+  while (n--) {
+    *d++ = c;
+    asm volatile("" ::: "memory");
+  }
+}
+
+static int __attribute__((noinline)) naive_cmp(const unsigned char *a, const unsigned char *b, unsigned int n) {
+  for (; n; n--, a++, b++) {
+    if (*a != *b)
+      return *a - *b;
+    asm volatile("" ::: "memory");
+  }
+  return 0;
+}
+
+static unsigned int __attribute__((noinline)) naive_strlen(const char *s) {
+  unsigned int n = 0;
+  while (s[n]) {
+    n++;
+    asm volatile("" ::: "memory");
+  }
+  return n;
+}
+
+// Reference formatter: the same algorithm with real division
+static volatile unsigned int ten = 10;
+
+static int __attribute__((noinline)) div_fmt_u32(char *buf, unsigned int val) {
+  char tmp[10];
+  int n = 0;
+  unsigned int d = ten;
+  do {
+    tmp[n++] = '0' + val % d;
+    val /= d;
+  } while (val);
+  for (int i = 0; i < n; i++)
+    buf[i] = tmp[n - 1 - i];
+  return n;
+}
+
+// Print cycles per byte with two decimals
+static void report(const char *name, unsigned int fast, unsigned int slow, unsigned int bytes) {
+  unsigned int f = fast * 100 / bytes;
+  unsigned int s = slow * 100 / bytes;
+  uart_printf("%s %u.%02u c/B  (bytewise %u.%02u c/B, x%u.%u)\r\n",
+              name, f / 100, f % 100, s / 100, s % 100,
+              slow / fast, (slow * 10 / fast) % 10);
+}
+
+int fail = 0;
+
+static void check(const char *name, int ok) {
+  if (!ok) {
+    uart_printf("  %s: FAIL\r\n", name);
+    fail++;
+  }
+}
+
+int main(void) {
+  unsigned int t0, fast, slow;
+
+  GPIO_DIR = 0xFF;
+  GPIO_OUT = 0x01;
+
+  uart_puts("\r\n=== Z-Core Runtime Library Benchmark ===\r\n\r\n");
+
+  for (int i = 0; i < N + 8; i++)
+    src[i] = (unsigned char)(i * 7 + 1);
+
+  // ---- memcpy, same alignment ----
+  t0 = read_cycle(); memcpy(dst, src, N);     fast = read_cycle() - t0;
+  t0 = read_cycle(); naive_copy(dst, src, N); slow = read_cycle() - t0;
+  report("memcpy     ", fast, slow, N);
+  check("memcpy", memcmp(dst, src, N) == 0);
+
+  // ---- memcpy, source off by one byte (shift-merge path) ----
+  t0 = read_cycle(); memcpy(dst, src + 1, N);     fast = read_cycle() - t0;
+  t0 = read_cycle(); naive_copy(dst, src + 1, N); slow = read_cycle() - t0;
+  report("memcpy+1   ", fast, slow, N);
+  check("memcpy+1", naive_cmp(dst, src + 1, N) == 0);
+
+  // ---- memmove, overlapping backwards copy ----
+  memcpy(dst, src, N + 8);
+  t0 = read_cycle(); memmove(dst + 4, dst, N); fast = read_cycle() - t0;
+  check("memmove", naive_cmp(dst + 4, src, N) == 0);
+  memcpy(dst, src, N);
+  t0 = read_cycle(); naive_copy(dst + 4, src, N); slow = read_cycle() - t0;
+  report("memmove    ", fast, slow, N);
+
+  // ---- memset ----
+  t0 = read_cycle(); memset(dst, 0x5A, N);     fast = read_cycle() - t0;
+  t0 = read_cycle(); naive_fill(dst, 0x5A, N); slow = read_cycle() - t0;
+  report("memset     ", fast, slow, N);
+  check("memset", dst[0] == 0x5A && dst[N - 1] == 0x5A && dst[N] != 0x5A);
+
+  // ---- memcmp, equal buffers (worst case) ----
+  memcpy(dst, src, N);
+  t0 = read_cycle(); int r0 = memcmp(dst, src, N);    fast = read_cycle() - t0;
+  t0 = read_cycle(); int r1 = naive_cmp(dst, src, N); slow = read_cycle() - t0;
+  report("memcmp     ", fast, slow, N);
+  dst[N - 1] ^= 1;
+  check("memcmp", r0 == 0 && r1 == 0 && memcmp(dst, src, N) != 0);
+
+  // ---- strlen ----
+  memset(dst, 'x', N);
+  dst[N - 1] = 0;
+  t0 = read_cycle(); unsigned int l0 = strlen((char *)dst);      fast = read_cycle() - t0;
+  t0 = read_cycle(); unsigned int l1 = naive_strlen((char *)dst); slow = read_cycle() - t0;
+  report("strlen     ", fast, slow, N - 1);
+  check("strlen", l0 == N - 1 && l1 == N - 1);
+
+  // ---- Decimal formatting: reciprocal multiply vs DIVU/REMU ----
+  char a[12], b[12];
+  unsigned int bytes = 0, v = 0x9E3779B9;
+  int same = 1;
+
+  t0 = read_cycle();
+  for (int i = 0; i < 64; i++, v = v * 1664525 + 1013904223)
+    bytes += fmt_u32(a, v);
+  fast = read_cycle() - t0;
+
+  v = 0x9E3779B9;
+  t0 = read_cycle();
+  for (int i = 0; i < 64; i++, v = v * 1664525 + 1013904223)
+    div_fmt_u32(b, v);
+  slow = read_cycle() - t0;
+
+  v = 0x9E3779B9;
+  for (int i = 0; i < 64; i++, v = v * 1664525 + 1013904223) {
+    int n = fmt_u32(a, v);
+    if (n != div_fmt_u32(b, v) || memcmp(a, b, n) != 0)
+      same = 0;
+  }
+  uart_puts("\r\n");
+  report("fmt_u32    ", fast, slow, bytes);
+  check("fmt_u32", same);
+
+  fmt_snprintf(a, sizeof(a), "%d", (int)0x80000000);
+  check("fmt INT_MIN", memcmp(a, "-2147483648", 12) == 0);
+
+  // ---- Fixed-point trig ----
+  fix16_t acc = 0;
+  t0 = read_cycle();
+  for (unsigned int ang = 0; ang < FIX16_ANGLE_TURN; ang++)
+    acc += fix16_sin(ang);
+  fast = read_cycle() - t0;
+  uart_printf("\r\nfix16_sin   %u cycles/call\r\n", fast / FIX16_ANGLE_TURN);
+
+  // sin^2 + cos^2 = 1 within table rounding
+  int worst = 0;
+  for (unsigned int ang = 0; ang < FIX16_ANGLE_TURN; ang += 7) {
+    fix16_t s = fix16_sin(ang), c = fix16_cos(ang);
+    int err = fix16_mul(s, s) + fix16_mul(c, c) - FIX16_ONE;
+    if (err < 0)
+      err = -err;
+    if (err > worst)
+      worst = err;
+  }
+  uart_printf("sin^2+cos^2 max error %d/65536\r\n", worst);
+  check("sin sum", acc >= -4 && acc <= 4);
+  check("sin 90", fix16_sin(256) == FIX16_ONE && fix16_sin(768) == -FIX16_ONE);
+  check("sin^2+cos^2", worst <= 4);
+  check("sqrt", fix16_sqrt(FIX16_FROM_INT(2)) == 92681 && isqrt32(1000000) == 1000);
+
+  uart_puts("\r\n=================\r\n");
+  GPIO_OUT = (fail == 0) ? 0xAA : 0x55;
+  uart_puts(fail == 0 ? "ALL PASSED\r\n" : "SOME FAILED\r\n");
+
+  while (1);
+  return 0;
+}
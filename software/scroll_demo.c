@@ -0,0 +1,134 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ================================================================
+// Scroll / Split-Screen Demo - Z-Core
+// A side-scrolling star field and skyline drawn once and moved with
+// the VGA scroll registers, under a fixed HUD band switched in by
+// the line-compare interrupt. Reports the cycles of a scroll update
+// against a full redraw over UART. Build with APP=1.
+// ================================================================
+
+#include "libs/uart.h"
+#include "libs/fmt.h"
+#include "libs/vga.h"
+
+// The playfield is framebuffer lines 0..99, the HUD lines 100..119
+#define PLAY_H    100
+#define HUD_LINE  (PLAY_H * 4)     // Screen line of the split
+
+static volatile unsigned int scroll_x;
+static volatile unsigned int frames;
+
+static inline unsigned int read_cycle(void) {
+  unsigned int v;
+  asm volatile("csrr %0, mcycle" : "=r"(v));
+  return v;
+}
+
+// meip is shared with the DMA engine; only VGA sources are enabled here
+static void __attribute__((interrupt("machine"), aligned(4))) vga_isr(void) {
+  unsigned int st = VGA_IRQ_STATUS;
+  VGA_IRQ_STATUS = st;
+  if (st & VGA_IRQ_LINE)
+    VGA_SCROLL_X = 0;              // HUD band does not scroll
+  if (st & VGA_IRQ_VBLANK) {
+    VGA_SCROLL_X = scroll_x;       // Playfield for the next frame
+    frames++;
+  }
+}
+
+static unsigned int rng = 0x2545F491;
+
+static unsigned int rand_next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 17;
+  rng ^= rng << 5;
+  return rng;
+}
+
+// Stars and a skyline that tile seamlessly every VGA_WIDTH columns
+static void draw_playfield(void) {
+  vga_fill_rect(0, 0, VGA_WIDTH, PLAY_H, VGA_BLACK);
+  rng = 0x2545F491;
+  for (int i = 0; i < 120; i++) {
+    unsigned int r = rand_next();
+    int x = (int)(r % VGA_WIDTH);
+    int y = (int)((r >> 8) % (PLAY_H - 30));
+    vga_set_pixel(x, y, (r >> 16) & 1 ? VGA_WHITE : VGA_LIGHT_GRAY);
+  }
+  for (int x = 0; x < VGA_WIDTH; x += 8) {
+    int h = 8 + (int)(rand_next() % 22);
+    vga_fill_rect(x, PLAY_H - h, 7, h, VGA_DARK_GRAY);
+    if (h > 14)
+      vga_set_pixel(x + 3, PLAY_H - h + 4, VGA_YELLOW);
+  }
+}
+
+static void draw_hud(void) {
+  vga_fill_rect(0, PLAY_H, VGA_WIDTH, VGA_HEIGHT - PLAY_H, VGA_BLUE);
+  vga_fill_rect(0, PLAY_H, VGA_WIDTH, 1, VGA_CYAN);
+  for (int i = 0; i < 8; i++)
+    vga_fill_rect(4 + i * 10, PLAY_H + 6, 8, 8, (unsigned char)(VGA_RED + i * 4));
+}
+
+int main(void) {
+  uart_puts("\r\n=== Z-Core Scroll Demo ===\r\n");
+
+  vga_set_mode(VGA_MODE_RGB332);
+  vga_scroll(0, 0);
+
+  // Cost of moving the background by redrawing it...
+  unsigned int t0 = read_cycle();
+  draw_playfield();
+  unsigned int t_redraw = read_cycle() - t0;
+  draw_hud();
+
+  // ...and by scrolling it
+  t0 = read_cycle();
+  vga_scroll(1, 0);
+  unsigned int t_scroll = read_cycle() - t0;
+  vga_scroll(0, 0);
+
+  uart_printf("redraw: %u cycles, scroll: %u cycles\r\n", t_redraw, t_scroll);
+
+  // Split at the top of the HUD band, restore the scroll in vblank
+  asm volatile("csrw mtvec, %0" :: "r"(vga_isr));
+  VGA_LINE_CMP = HUD_LINE;
+  VGA_IRQ_STATUS = VGA_IRQ_LINE | VGA_IRQ_VBLANK;
+  VGA_IRQ_EN = VGA_IRQ_LINE | VGA_IRQ_VBLANK;
+  asm volatile("csrs mie, %0" :: "r"(1 << 11));     // MEIE
+  asm volatile("csrs mstatus, %0" :: "r"(1 << 3));  // MIE
+
+  unsigned int seen = 0;
+  while (1) {
+    while (frames == seen)
+      ;
+    seen = frames;
+    scroll_x = scroll_x < VGA_WIDTH - 1 ? scroll_x + 1 : 0;
+    if ((seen & 63) == 0)
+      uart_printf("frame %u  scroll %u\r\n", seen, scroll_x);
+  }
+  return 0;
+}
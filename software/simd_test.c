@@ -0,0 +1,89 @@
+/*
+
+Copyright (c) 2025 Pau Díaz Cuesta
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+// ================================================================
+// Packed-SIMD Test - Z-Core custom-0/custom-1 pixel instructions
+// a = {FF, 1C, 80, E0}  b = {40, 1C, 00, E3}  (lane 3 .. lane 0)
+// ================================================================
+
+#include "libs/uart.h"
+#include "libs/simd.h"
+
+#define GPIO_OUT (*((volatile unsigned int *)0x04001000))
+#define GPIO_DIR (*((volatile unsigned int *)0x04001008))
+
+int p = 0, f = 0;
+
+void __attribute__((noinline)) check(const char *name, unsigned int r, unsigned int exp) {
+  uart_puts(name); uart_putc('=');
+  uart_puthex(r);
+  uart_puts(" exp:"); uart_puthex(exp);
+
+  if (r == exp) { uart_puts(" OK\r\n"); p++; }
+  else { uart_puts(" FAIL\r\n"); f++; }
+}
+
+int main(void) {
+  GPIO_DIR = 0xFF;
+  GPIO_OUT = 0x01;
+
+  volatile px4_t a = 0xFF1C80E0;
+  volatile px4_t b = 0x401C00E3;
+
+  uart_puts("\r\n=== Z-Core Packed-SIMD Test ===\r\n\r\n");
+
+  uart_puts("-- Byte lanes --\r\n");
+  check("addus",   px4_addus(a, b),   0xFF3880FF);
+  check("subus",   px4_subus(a, b),   0xBF008000);
+  check("min",     px4_min(a, b),     0x401C00E0);
+  check("max",     px4_max(a, b),     0xFF1C80E3);
+
+  uart_puts("\r\n-- Compare/select --\r\n");
+  check("cmpeq",   px4_cmpeq(a, b),   0x00FF0000);
+  check("cmpltu",  px4_cmpltu(a, b),  0x000000FF);
+  check("overlay", px4_overlay(a, b), 0xFF1C80E0);
+  check("overlay0", px4_overlay(0x00FF0000, b), 0x40FF00E3);
+
+  uart_puts("\r\n-- Shuffle --\r\n");
+  check("shuffle", px4_shuffle(a, PX4_SHUF(3, 2, 1, 0)), 0xE0801CFF);
+  check("reverse", px4_reverse(a), 0xE0801CFF);
+  check("splat0",  px4_shufflei(a, PX4_SHUF(0, 0, 0, 0)), 0xE0E0E0E0);
+
+  uart_puts("\r\n-- 3-3-2 color --\r\n");
+  check("blend50", px4_blend50(a, b), 0x8D1C40E1);
+  check("blend75", px4_blend75(a, b), 0xB61C60E0);
+  check("add332",  px4_add332(a, b),  0xFF1C80E3);
+  check("sub332",  px4_sub332(a, b),  0xBF008000);
+
+  uart_puts("\r\n=================\r\n");
+  uart_puts("PASS:"); uart_puthex((unsigned int)p);
+  uart_puts(" FAIL:"); uart_puthex((unsigned int)f);
+  uart_puts("\r\n");
+
+  GPIO_OUT = (f == 0) ? 0xAA : 0x55;
+  uart_puts(f == 0 ? "ALL PASSED\r\n" : "SOME FAILED\r\n");
+
+  while (1);
+  return 0;
+}
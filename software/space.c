@@ -12,6 +12,11 @@
 #include "libs/uart.h"
 #include "libs/vga.h"
 
+/* make PROFILE=1: stream PC samples for prof_report.py */
+#ifdef PROFILE
+#include "libs/prof.h"
+#endif
+
 #define GPIO_LOW     (*((volatile unsigned int *)0x04001000))
 #define GPIO_DIR_LOW (*((volatile unsigned int *)0x04001008))
 
@@ -459,6 +464,10 @@ int main(void) {
 
     reset_game();
 
+#ifdef PROFILE
+    prof_start(PROF_DEFAULT_HZ);
+#endif
+
     unsigned int fps_tick = rdcycle();
     int fps = 60, fps_cnt = 0;
 
@@ -0,0 +1,87 @@
+/*
+ *  SPRITE DEMO — dirty-rectangle renderer benchmark
+ *
+ *  Bounces sprites over a static background with libs/gfx and
+ *  alternates between dirty-rectangle and full-screen presents
+ *  every 128 frames, printing mcycle frame statistics over UART.
+ *  Build with APP=1.
+ */
+
+#include "libs/uart.h"
+#include "libs/fmt.h"
+#include "libs/gfx.h"
+
+#define N_SPRITES 8
+
+static const unsigned char ball_rows[7] = {
+    0x1C, 0x3E, 0x7F, 0x7F, 0x7F, 0x3E, 0x1C
+};
+static const gfx_image_t ball = { 7, 7, GFX_MONO, ball_rows };
+
+/* 4x4 full-color gem, 0 = transparent */
+static const unsigned char gem_px[16] = {
+    0x00, 0xFF, 0xFC, 0x00,
+    0xFF, 0xFC, 0xE0, 0xE0,
+    0xFC, 0xE0, 0xE0, 0x60,
+    0x00, 0xE0, 0x60, 0x00
+};
+static const gfx_image_t gem = { 4, 4, GFX_RGB332, gem_px };
+
+static gfx_sprite_t spr[N_SPRITES];
+static int dx[N_SPRITES], dy[N_SPRITES];
+
+/* Checkerboard background, regenerated per row */
+static void checker(int y, int x, int w, unsigned char *line) {
+    for (int i = 0; i < w; i++)
+        line[i] = (((x + i) >> 3) ^ (y >> 3)) & 1 ? VGA_DARK_GRAY : VGA_BLACK;
+}
+
+int main(void) {
+    uart_puts("Sprite Demo\r\n");
+
+    gfx_init(VGA_BLACK);
+    gfx_set_background(VGA_BLACK, checker);
+
+    for (int i = 0; i < N_SPRITES; i++) {
+        spr[i].img = (i & 1) ? &gem : &ball;
+        spr[i].x = (short)(10 + i * 17);
+        spr[i].y = (short)(8 + i * 13);
+        spr[i].color = VGA_RGB(i & 7, (i * 3) & 7, 3);
+        spr[i].visible = 1;
+        dx[i] = (i & 2) ? -1 : 1;
+        dy[i] = (i & 1) ? 1 : -2;
+        gfx_add(&spr[i]);
+    }
+
+    unsigned int frame = 0, sum_render = 0, sum_pixels = 0;
+
+    while (1) {
+        vga_wait_vsync();
+
+        for (int i = 0; i < N_SPRITES; i++) {
+            int w = spr[i].img->w, h = spr[i].img->h;
+            spr[i].x += dx[i];
+            spr[i].y += dy[i];
+            if (spr[i].x <= 0 || spr[i].x >= VGA_WIDTH - w)  dx[i] = -dx[i];
+            if (spr[i].y <= 0 || spr[i].y >= VGA_HEIGHT - h) dy[i] = -dy[i];
+        }
+
+        gfx_present();
+
+        const gfx_stats_t *st = gfx_stats();
+        sum_render += st->render_cycles;
+        sum_pixels += st->pixels;
+
+        if ((++frame & 127) == 0) {
+            int full = (frame >> 7) & 1;
+            uart_printf("%s: %u cycles/frame render, %u px/frame, %u cycles/frame total\r\n",
+                        full ? "dirty" : "full ",
+                        sum_render >> 7, sum_pixels >> 7, st->frame_cycles);
+            sum_render = 0;
+            sum_pixels = 0;
+            gfx_set_mode(full ? GFX_MODE_FULL : GFX_MODE_DIRTY);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+"""
+Z-Core Commit-Trace Report
+
+Reads a .ztr commit trace written by the Verilator harness (sim/) and
+the matching ELF, then prints a per-function cycle breakdown and the
+top-N stall sites. No external dependencies -- uses only the Python
+standard library.
+
+Usage:
+    ./trace_report.py <trace.ztr> <program.elf> [--top 20]
+
+Each record is charged with the cycles since the previous record, so a
+function's cycles include the stalls its instructions waited on.
+"""
+
+import sys
+import struct
+import argparse
+import bisect
+from collections import defaultdict
+
+STALL_NAMES = ["MEM", "BUS", "DIV", "LOAD_USE", "FETCH", "FLUSH"]
+
+
+def read_symbols(elf_path):
+    """Return a sorted list of (addr, size, name) for FUNC symbols."""
+    with open(elf_path, 'rb') as f:
+        data = f.read()
+
+    if data[:4] != b'\x7fELF' or data[4] != 1:
+        raise ValueError(f"{elf_path}: not an ELF32 file")
+
+    e_shoff, = struct.unpack_from('<I', data, 0x20)
+    e_shentsize, e_shnum = struct.unpack_from('<HH', data, 0x2E)
+
+    sections = []
+    for i in range(e_shnum):
+        sh = struct.unpack_from('<IIIIIIIIII', data, e_shoff + i * e_shentsize)
+        sections.append(sh)
+
+    syms = []
+    for sh in sections:
+        sh_type, sh_offset, sh_size, sh_link, sh_entsize = sh[1], sh[4], sh[5], sh[6], sh[9]
+        if sh_type != 2:  # SHT_SYMTAB
+            continue
+        strtab = sections[sh_link]
+        str_off = strtab[4]
+        for j in range(sh_size // sh_entsize):
+            st_name, st_value, st_size, st_info, _, _ = struct.unpack_from(
+                '<IIIBBH', data, sh_offset + j * sh_entsize)
+            if (st_info & 0xF) != 2:  # STT_FUNC
+                continue
+            end = data.index(b'\0', str_off + st_name)
+            name = data[str_off + st_name:end].decode('ascii', 'replace')
+            syms.append((st_value, st_size, name))
+
+    syms.sort()
+    return syms
+
+
+class Symbolizer:
+    def __init__(self, syms):
+        self.syms = syms
+        self.addrs = [s[0] for s in syms]
+
+    def lookup(self, pc):
+        """Return (function name, offset) for pc."""
+        i = bisect.bisect_right(self.addrs, pc) - 1
+        if i >= 0:
+            addr, size, name = self.syms[i]
+            if size == 0 or pc < addr + size:
+                return name, pc - addr
+        return "??", pc
+
+
+def read_trace(path):
+    with open(path, 'rb') as f:
+        hdr = f.read(12)
+        if hdr[:4] != b'ZTRC':
+            raise ValueError(f"{path}: not a Z-Core trace")
+        version, rec_size = struct.unpack('<II', hdr[4:])
+        if version != 1:
+            raise ValueError(f"{path}: unsupported trace version {version}")
+        while True:
+            rec = f.read(rec_size)
+            if len(rec) < rec_size:
+                break
+            cycle, pc, insn, rd_data = struct.unpack_from('<IIII', rec, 0)
+            flags = rec[16]
+            stalls = rec[17:17 + len(STALL_NAMES)]
+            yield cycle, pc, insn, flags, stalls
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Z-Core commit-trace report")
+    parser.add_argument("trace", help="Trace file (.ztr)")
+    parser.add_argument("elf", help="Program ELF (for symbols)")
+    parser.add_argument("--top", type=int, default=20, help="Number of stall sites to list")
+    args = parser.parse_args()
+
+    sym = Symbolizer(read_symbols(args.elf))
+
+    func_cycles = defaultdict(int)
+    func_insts = defaultdict(int)
+    func_stalls = defaultdict(lambda: [0] * len(STALL_NAMES))
+    site_stalls = defaultdict(lambda: [0] * len(STALL_NAMES))
+    site_insn = {}
+
+    prev_cycle = None
+    total_cycles = 0
+    total_insts = 0
+
+    for cycle, pc, insn, flags, stalls in read_trace(args.trace):
+        cost = 0 if prev_cycle is None else cycle - prev_cycle
+        prev_cycle = cycle
+
+        name, _ = sym.lookup(pc)
+        func_cycles[name] += cost
+        func_insts[name] += 1
+        total_cycles += cost
+        total_insts += 1
+
+        for i, n in enumerate(stalls):
+            func_stalls[name][i] += n
+            site_stalls[pc][i] += n
+        site_insn[pc] = insn
+
+    if total_insts == 0:
+        print("Empty trace")
+        return
+
+    # --- Per-function breakdown ---
+    print(f"Retired: {total_insts}  Cycles: {total_cycles}  "
+          f"CPI: {total_cycles / total_insts:.2f}\n")
+
+    hdr = f"{'Function':<24}{'Cycles':>10}{'%':>7}{'Insts':>9}{'CPI':>6}"
+    hdr += "".join(f"{n:>10}" for n in STALL_NAMES)
+    print(hdr)
+    print("-" * len(hdr))
+    for name in sorted(func_cycles, key=func_cycles.get, reverse=True):
+        cyc = func_cycles[name]
+        insts = func_insts[name]
+        line = f"{name[:23]:<24}{cyc:>10}{100.0 * cyc / max(total_cycles, 1):>6.1f}%"
+        line += f"{insts:>9}{cyc / insts:>6.2f}"
+        line += "".join(f"{n:>10}" for n in func_stalls[name])
+        print(line)
+
+    # --- Top-N stall sites ---
+    print(f"\nTop {args.top} stall sites")
+    hdr = f"{'PC':<10}{'Insn':<10}{'Location':<32}{'Stalls':>8}  Main cause"
+    print(hdr)
+    print("-" * len(hdr))
+    sites = sorted(site_stalls.items(), key=lambda kv: sum(kv[1]), reverse=True)
+    for pc, counts in sites[:args.top]:
+        total = sum(counts)
+        if total == 0:
+            break
+        name, off = sym.lookup(pc)
+        cause = STALL_NAMES[counts.index(max(counts))]
+        loc = f"{name}+0x{off:x}"
+        print(f"{pc:08x}  {site_insn[pc]:08x}  {loc[:31]:<32}{total:>8}  {cause}")
+
+
+if __name__ == '__main__':
+    main()
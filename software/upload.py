@@ -11,6 +11,9 @@ Usage:
 Examples:
     ./upload.py /dev/ttyUSB0 hello.bin
     ./upload.py /dev/ttyUSB0 hello.bin -n   # upload only, don't monitor
+    ./upload.py /dev/ttyUSB0 space.bin --profile space.elf   # libs/prof.h samples
+    ./upload.py /dev/ttyUSB0 space.bin -z   # LZ4-compressed upload
+    ./upload.py /dev/ttyUSB0 space.bin -d   # resend changed blocks only
 """
 
 import sys
@@ -26,6 +29,150 @@ SYNC_ACK = 0xA5
 ACK      = 0x06
 NAK      = 0x15
 
+# Seconds to keep sending SYNC_REQ (every 20 ms) before giving up
+SYNC_TIMEOUT = 10
+
+# Size word flag: an LZ4 block stream follows (bootloader v1.1+)
+SIZE_LZ4 = 0x80000000
+
+# Size word flag: delta upload of changed blocks only (bootloader v1.1+)
+SIZE_DELTA  = 0x40000000
+DELTA_BLOCK = 256
+DELTA_END   = 0xFF
+
+# The bootloader decompresses as bytes arrive. The UART has one holding
+# register behind the shift register and overwrites it silently on overrun,
+# so a match copy has just under two byte times (~8680 cycles at 50 MHz,
+# 115200 baud) before the stream corrupts. Each copied byte is a bus load
+# and a bus store through axil_master and the interconnect, a few tens of
+# cycles, so matches are capped at 64 bytes to finish within one byte time
+# (4340 cycles) and keep the second as margin.
+LZ4_MAX_MATCH = 64
+LZ4_MIN_MATCH = 4
+LZ4_WINDOW    = 65535
+LZ4_CHAIN     = 64
+
+
+def block_hash(block):
+    """FNV-1a over little-endian 32-bit words, as block_hash() in bootloader.c."""
+    h = 2166136261
+    for (w,) in struct.iter_unpack("<I", block):
+        h = ((h ^ w) * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def recv_exact(fd, n, timeout=5.0):
+    buf = b""
+    while len(buf) < n:
+        r, _, _ = select.select([fd], [], [], timeout)
+        if not r:
+            raise TimeoutError("No response from device")
+        buf += os.read(fd, n - len(buf))
+    return buf
+
+
+def lz4_compress(data):
+    """Compress data as one LZ4 block (greedy, hash chains).
+
+    Follows the block format end rules (last 5 bytes are literals, no
+    match starts in the last 12 bytes), so standard LZ4 tools can also
+    decode it."""
+    n = len(data)
+    out = bytearray()
+    heads = {}
+    prev = [-1] * n
+    anchor = 0
+    i = 0
+    match_limit = n - 12
+    last_literals = n - 5
+
+    def put_len(v):
+        while v >= 255:
+            out.append(255)
+            v -= 255
+        out.append(v)
+
+    def insert(pos):
+        if pos + 4 <= n:
+            key = data[pos:pos + 4]
+            prev[pos] = heads.get(key, -1)
+            heads[key] = pos
+
+    while i < match_limit:
+        best_len, best_off = 0, 0
+        cand = heads.get(data[i:i + 4], -1)
+        depth = 0
+        while cand >= 0 and i - cand <= LZ4_WINDOW and depth < LZ4_CHAIN:
+            limit = min(LZ4_MAX_MATCH, last_literals - i)
+            length = 0
+            while length < limit and data[cand + length] == data[i + length]:
+                length += 1
+            if length > best_len:
+                best_len, best_off = length, i - cand
+                if length == limit:
+                    break
+            cand = prev[cand]
+            depth += 1
+
+        if best_len < LZ4_MIN_MATCH:
+            insert(i)
+            i += 1
+            continue
+
+        lit = i - anchor
+        ml = best_len - LZ4_MIN_MATCH
+        out.append((min(lit, 15) << 4) | min(ml, 15))
+        if lit >= 15:
+            put_len(lit - 15)
+        out += data[anchor:i]
+        out += struct.pack("<H", best_off)
+        if ml >= 15:
+            put_len(ml - 15)
+
+        for p in range(i, i + best_len):
+            insert(p)
+        i += best_len
+        anchor = i
+
+    lit = n - anchor
+    out.append(min(lit, 15) << 4)
+    if lit >= 15:
+        put_len(lit - 15)
+    out += data[anchor:]
+    return bytes(out)
+
+
+def lz4_decompress(comp, size):
+    """Reference decoder, mirrors recv_lz4() in bootloader.c."""
+    out = bytearray()
+    i = 0
+
+    def get_len(v):
+        nonlocal i
+        if v == 15:
+            while True:
+                b = comp[i]
+                i += 1
+                v += b
+                if b != 255:
+                    break
+        return v
+
+    while True:
+        token = comp[i]
+        i += 1
+        lit = get_len(token >> 4)
+        out += comp[i:i + lit]
+        i += lit
+        if len(out) >= size:
+            break
+        off = comp[i] | (comp[i + 1] << 8)
+        i += 2
+        ml = get_len(token & 15) + LZ4_MIN_MATCH
+        for _ in range(ml):
+            out.append(out[-off])
+    return bytes(out)
+
 
 def configure_port(fd, baud):
     """Configure serial port: 8N1, raw mode, given baud rate."""
@@ -65,6 +212,12 @@ def configure_port(fd, baud):
     fcntl.fcntl(fd, fcntl.F_SETFL, flags & ~os.O_NONBLOCK)
 
 
+def tcdrain(fd):
+    """Wait until all written bytes have left the port."""
+    import termios
+    termios.tcdrain(fd)
+
+
 def recv_byte(fd, timeout=5.0):
     """Read one byte with timeout. Returns int or raises TimeoutError."""
     r, _, _ = select.select([fd], [], [], timeout)
@@ -108,13 +261,35 @@ def terminal_mode(fd):
         print("\n--- Disconnected ---")
 
 
-def upload(port, binary_path, baud, stay_terminal):
+def send_delta(fd, data):
+    """Receive the block hashes, send only the blocks that differ.
+    Returns the number of blocks sent."""
+    assert len(data) % 4 == 0, "delta images must be padded to whole words"
+    blocks = [data[i:i + DELTA_BLOCK] for i in range(0, len(data), DELTA_BLOCK)]
+    remote = struct.unpack(f"<{len(blocks)}I", recv_exact(fd, 4 * len(blocks)))
+
+    out = bytearray()
+    sent = 0
+    for i, (blk, h) in enumerate(zip(blocks, remote)):
+        if block_hash(blk) != h:
+            out.append(i)
+            out += blk
+            sent += 1
+    out.append(DELTA_END)
+    os.write(fd, bytes(out))
+    return sent
+
+
+def upload(port, binary_path, baud, stay_terminal, profile_elf=None, compress=False,
+           delta=False):
     with open(binary_path, "rb") as f:
         data = f.read()
 
-    # Pad to 4-byte boundary
-    while len(data) % 4:
-        data += b"\x00"
+    # Pad to 4-byte boundary before the size, checksum and delta block
+    # hashes are taken: the bootloader hashes whole words, and it
+    # rejects any size that is not a multiple of 4 (its first byte
+    # must never look like a repeated SYNC_REQ)
+    data += b"\x00" * (-len(data) % 4)
 
     size = len(data)
     if size == 0:
@@ -124,12 +299,21 @@ def upload(port, binary_path, baud, stay_terminal):
         print(f"Error: binary is {size} bytes, max is 12288 (12 KB).")
         sys.exit(1)
 
+    payload = data
+    if compress:
+        payload = lz4_compress(data)
+        if lz4_decompress(payload, size) != data:
+            print("Error: LZ4 self-check failed.")
+            sys.exit(1)
+
     fd = os.open(port, os.O_RDWR | os.O_NOCTTY)
     configure_port(fd, baud)
 
     print(f"Z-Core Upload Tool")
     print(f"  Port   : {port} @ {baud} baud")
     print(f"  Binary : {binary_path} ({size} bytes)")
+    if compress:
+        print(f"  LZ4    : {len(payload)} bytes ({100 * len(payload) // size}%)")
     print()
 
     # Drain any bootloader banner already sitting in the buffer
@@ -137,19 +321,24 @@ def upload(port, binary_path, baud, stay_terminal):
     time.sleep(0.3)
     drain(fd, echo=True)
 
-    # Sync handshake (retry a few times)
+    # Sync handshake. A bootloader with a valid resident app only
+    # listens for 50 ms after reset before starting it again, so keep
+    # sending SYNC_REQ and let the user press KEY[0] meanwhile.
     synced = False
-    for attempt in range(5):
+    print("(Press KEY[0] if the board is running a program)")
+    deadline = time.time() + SYNC_TIMEOUT
+    while time.time() < deadline:
         os.write(fd, bytes([SYNC_REQ]))
         try:
-            resp = recv_byte(fd, timeout=2.0)
-            if resp == SYNC_ACK:
-                synced = True
-                break
+            resp = recv_byte(fd, timeout=0.02)
         except TimeoutError:
-            pass
-        # Drain any stale data between retries
-        drain(fd, echo=True)
+            continue
+        if resp == SYNC_ACK:
+            synced = True
+            break
+        # Output of the running program or the banner
+        sys.stdout.buffer.write(bytes([resp]))
+        sys.stdout.flush()
 
     if not synced:
         print("\nError: no sync response from bootloader.")
@@ -160,10 +349,12 @@ def upload(port, binary_path, baud, stay_terminal):
     print("Sync    : OK")
 
     # Send size (ACK/NAK is the first byte the bootloader replies with)
-    os.write(fd, struct.pack("<I", size))
+    flags = (SIZE_LZ4 if compress else 0) | (SIZE_DELTA if delta else 0)
+    os.write(fd, struct.pack("<I", size | flags))
     resp = recv_byte(fd, timeout=5.0)
     if resp == NAK:
-        print("Error: bootloader rejected size.")
+        print("Error: bootloader rejected size." +
+              (" (LZ4/delta need bootloader v1.1)" if flags else ""))
         time.sleep(0.1)
         drain(fd, echo=True)
         os.close(fd)
@@ -172,15 +363,32 @@ def upload(port, binary_path, baud, stay_terminal):
         print(f"Error: unexpected response 0x{resp:02X}")
         os.close(fd)
         sys.exit(1)
-    # Drain the text that follows ACK (e.g. "RX 889 bytes\r\n")
-    time.sleep(0.05)
-    drain(fd, echo=True)
-    print(f"Size    : {size} bytes accepted")
-
-    # Send data
     checksum = sum(data) & 0xFFFFFFFF
-    os.write(fd, data)
-    print(f"Data    : sent")
+    t0 = time.time()
+
+    if delta:
+        # Block hashes follow the ACK directly; a second ACK means the
+        # bootloader has applied the blocks and is ready for the checksum
+        print(f"Size    : {size} bytes accepted")
+        sent = send_delta(fd, data)
+        if recv_byte(fd, timeout=5.0) != ACK:
+            print("Error: bootloader rejected a block.")
+            time.sleep(0.1)
+            drain(fd, echo=True)
+            os.close(fd)
+            sys.exit(1)
+        print(f"Delta   : {sent} of {(size + DELTA_BLOCK - 1) // DELTA_BLOCK} blocks sent "
+              f"({(time.time() - t0) * 1000:.0f} ms)")
+    else:
+        # Drain the text that follows ACK (e.g. "RX 889 bytes\r\n")
+        time.sleep(0.05)
+        drain(fd, echo=True)
+        print(f"Size    : {size} bytes accepted")
+
+        # Send data; the checksum always covers the decompressed image
+        os.write(fd, payload)
+        tcdrain(fd)
+        print(f"Data    : sent ({time.time() - t0:.2f} s)")
 
     # Send checksum (ACK/NAK is the first byte back)
     os.write(fd, struct.pack("<I", checksum))
@@ -204,7 +412,13 @@ def upload(port, binary_path, baud, stay_terminal):
 
     print("\nUpload complete. Program is running.")
 
-    if stay_terminal:
+    if profile_elf:
+        from prof_report import FrameDecoder, collect, print_profile
+        print("\n--- Sampling (Ctrl-C to stop) ---")
+        dec = FrameDecoder()
+        collect(fd, dec, 0)
+        print_profile(dec, profile_elf, 20)
+    elif stay_terminal:
         terminal_mode(fd)
 
     os.close(fd)
@@ -217,9 +431,19 @@ def main():
     parser.add_argument("--baud", type=int, default=115200, help="Baud rate (default: 115200)")
     parser.add_argument("--no-terminal", "-n", action="store_true",
                         help="Exit after upload instead of monitoring UART")
+    parser.add_argument("--compress", "-z", action="store_true",
+                        help="Send an LZ4-compressed image (bootloader v1.1+)")
+    parser.add_argument("--delta", "-d", action="store_true",
+                        help="Send only the 256-byte blocks that differ from RAM (bootloader v1.1+)")
+    parser.add_argument("--profile", metavar="ELF",
+                        help="Decode profiler samples after upload and print a flat profile")
     args = parser.parse_args()
 
-    upload(args.port, args.binary, args.baud, not args.no_terminal)
+    if args.compress and args.delta:
+        parser.error("--compress and --delta cannot be combined")
+
+    upload(args.port, args.binary, args.baud, not args.no_terminal, args.profile,
+           args.compress, args.delta)
 
 
 if __name__ == "__main__":